@@ -8,6 +8,22 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <limits>
+#include <new>
+#include <span>
+#include <utility>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#define DODO_HAS_COROUTINES 1
+#else
+#define DODO_HAS_COROUTINES 0
+#endif
 
 // ----------------------------------------------------------------------------
 // Compiler Intrinsics & Optimization Macros
@@ -17,22 +33,179 @@
 #define DODO_UNLIKELY(x)    __builtin_expect(!!(x), 0)
 #define DODO_COLD           __attribute__((cold))
 #define DODO_NOINLINE       __attribute__((noinline))
+#define DODO_ALWAYS_INLINE  __attribute__((always_inline))
 #define DODO_TRAP()         __builtin_trap()
 #elif defined(_MSC_VER)
 #define DODO_LIKELY(x)      (x)
 #define DODO_UNLIKELY(x)    (x)
 #define DODO_COLD           // MSVC handles cold code via profile-guided opts mostly
 #define DODO_NOINLINE       __declspec(noinline)
+#define DODO_ALWAYS_INLINE  __forceinline
 #define DODO_TRAP()         __debugbreak()
 #else
 #define DODO_LIKELY(x)      (x)
 #define DODO_UNLIKELY(x)    (x)
 #define DODO_COLD
 #define DODO_NOINLINE
+#define DODO_ALWAYS_INLINE
 #define DODO_TRAP()         (*(volatile int*)0 = 0)
 #endif
 
+// Branch hint with a measured probability that `x` is true (DODO_REQUIRE_EXPECT,
+// DODO_SITE_PROFILE_HEADER). Where the builtin is missing it is a plain (x).
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_expect_with_probability)
+#define DODO_EXPECT_PROB(x, p) __builtin_expect_with_probability(!!(x), 1, (p))
+#endif
+#endif
+#ifndef DODO_EXPECT_PROB
+#define DODO_EXPECT_PROB(x, p) (x)
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(__AVX512F__) || defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#define DODO_CACHE_LINE 64
+
+#define DODO_CONCAT_IMPL(a, b) a##b
+#define DODO_CONCAT(a, b)      DODO_CONCAT_IMPL(a, b)
+#define DODO_STRINGIFY_IMPL(x) #x
+#define DODO_STRINGIFY(x)      DODO_STRINGIFY_IMPL(x)
+
+#if defined(DODO_FAST_MODE) && defined(DODO_COMPACT_MODE)
+#error "DODO_FAST_MODE and DODO_COMPACT_MODE are mutually exclusive"
+#endif
+
+// DODO_SITE_PROFILE: every Site also counts its evaluations (one relaxed
+// load+store per check on the hot path), so format_site_profile() in
+// DodoFormat.hpp can export pass rates for tools/dodo_profgen. Profiling builds
+// only; needs file/line.
+#if defined(DODO_SITE_PROFILE) && (defined(DODO_FAST_MODE) || defined(DODO_COMPACT_MODE))
+#error "DODO_SITE_PROFILE needs file/line sites; it cannot be combined with DODO_FAST_MODE or DODO_COMPACT_MODE"
+#endif
+
+// Pass probability below which DODO_REQUIRE_EXPECT sends failures to the warm
+// (non-cold) endpoint instead of .text.unlikely.
+#ifndef DODO_WARM_BELOW
+#define DODO_WARM_BELOW 0.9
+#endif
+
+// Contract levels: REQUIRE / ENSURE / INVARIANT tagged above DODO_CONTRACT_LEVEL
+// compile to nothing (condition type-checked, never evaluated).
+#define DODO_CONTRACT_ALWAYS  0 // *_ALWAYS macros: never stripped
+#define DODO_CONTRACT_DEFAULT 1 // plain DODO_REQUIRE / DODO_ENSURE / DODO_INVARIANT
+#define DODO_CONTRACT_AUDIT   2 // *_AUDIT macros: expensive, QA builds
+
+#ifndef DODO_CONTRACT_LEVEL
+#define DODO_CONTRACT_LEVEL DODO_CONTRACT_DEFAULT
+#endif
+
+#if DODO_CONTRACT_LEVEL < DODO_CONTRACT_ALWAYS || DODO_CONTRACT_LEVEL > DODO_CONTRACT_AUDIT
+#error "DODO_CONTRACT_LEVEL must be DODO_CONTRACT_ALWAYS, DODO_CONTRACT_DEFAULT or DODO_CONTRACT_AUDIT"
+#endif
+
+// Optimizer hint that `cond` holds. Clang, MSVC and C++23 [[assume]] never
+// evaluate it; the GCC fallback does, so side effects and opaque calls remain.
+#if defined(__clang__)
+#define DODO_ASSUME(cond) __builtin_assume(cond)
+#elif defined(__has_cpp_attribute) && !defined(_MSC_VER)
+#if __has_cpp_attribute(assume) >= 202207L
+#define DODO_ASSUME(cond) [[assume(cond)]]
+#endif
+#elif defined(_MSC_VER)
+#define DODO_ASSUME(cond) __assume(cond)
+#endif
+#if !defined(DODO_ASSUME) && defined(__GNUC__)
+#define DODO_ASSUME(cond) \
+    do { \
+        if (!(cond)) { \
+            __builtin_unreachable(); \
+        } \
+    } while (0)
+#elif !defined(DODO_ASSUME)
+#define DODO_ASSUME(cond) ((void) sizeof(!(cond)))
+#endif
+
 namespace Dodo {
+    namespace internal {
+        // Raw timestamp counter: rdtsc on x86 (no serialization), cntvct_el0 on
+        // AArch64. Returns 0 on targets without a user-readable counter.
+        inline uint64_t read_tsc() noexcept {
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+            return __builtin_ia32_rdtsc();
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            return __rdtsc();
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+            uint64_t v;
+            __asm__ volatile("mrs %0, cntvct_el0" : "=r"(v));
+            return v;
+#else
+            return 0;
+#endif
+        }
+
+        // Small dense per-thread index, assigned on first use (cold path only) and
+        // handed back when the thread exits, so short-lived worker threads reuse
+        // the low rows of the per-thread tables instead of running past them.
+        // Threads beyond kThreadIndexLimit live at once get kNoThreadIndex, which
+        // is out of range for every table and lands in its shared overflow path.
+        inline constexpr uint32_t kThreadIndexWords = 16;
+        inline constexpr uint32_t kThreadIndexLimit = kThreadIndexWords * 64;
+        inline constexpr uint32_t kNoThreadIndex = kThreadIndexLimit;
+        inline constinit std::atomic<uint64_t> g_thread_slots[kThreadIndexWords]{};
+
+        inline uint32_t acquire_thread_index() noexcept {
+            for (uint32_t w = 0; w < kThreadIndexWords; ++w) {
+                uint64_t used = g_thread_slots[w].load(std::memory_order_relaxed);
+                while (~used != 0) {
+                    const uint64_t bit = ~used & (used + 1); // lowest clear bit
+                    // acq_rel: a recycled row's last writes (released on exit) are visible.
+                    used = g_thread_slots[w].fetch_or(bit, std::memory_order_acq_rel);
+                    if ((used & bit) == 0) {
+                        return w * 64 + static_cast<uint32_t>(std::countr_zero(bit));
+                    }
+                }
+            }
+            return kNoThreadIndex;
+        }
+
+        // The index itself is trivially destructible, so reading it never runs
+        // TLS init code (async-signal-safe, see peek_thread_index). The release
+        // hook is a separate thread_local, constructed once when the index is taken.
+        inline thread_local uint32_t t_thread_index = UINT32_MAX;
+
+        struct ThreadIndexRelease {
+            ~ThreadIndexRelease() {
+                const uint32_t value = t_thread_index;
+                if (value < kThreadIndexLimit) {
+                    g_thread_slots[value / 64].fetch_and(~(uint64_t{1} << (value % 64)), std::memory_order_release);
+                }
+            }
+        };
+        inline thread_local ThreadIndexRelease t_thread_index_release;
+
+        inline uint32_t thread_index() noexcept {
+            if (DODO_UNLIKELY(t_thread_index == UINT32_MAX)) {
+                t_thread_index = acquire_thread_index();
+                (void) &t_thread_index_release; // registers the exit hook
+            }
+            return t_thread_index;
+        }
+
+        // The calling thread's index, or UINT32_MAX if it never took one. Plain
+        // TLS load, no allocation: usable from a signal or panic handler.
+        inline uint32_t peek_thread_index() noexcept {
+            return t_thread_index;
+        }
+    }
+
     // --------------------------------------------------------------------------
     // Core Types (POD, register-passable)
     // --------------------------------------------------------------------------
@@ -53,15 +226,233 @@ namespace Dodo {
 
     enum class Severity : uint8_t { Recoverable, Fatal };
 
-    // Minimal context. Constructed only on the cold path.
-    struct Failure {
-        Code code;
-        Severity sev;
+    // Code domains: the top 4 bits of a Code select a domain, the low 12 bits a
+    // value within it. Domain 0 is Dodo's own codes above; applications define
+    // more (venue errors, gateway rejects, ...) without widening Status. Code 0
+    // (Ok) stays the only success value, so ok() and DODO_TRY remain a single
+    // compare against zero, and a handler gets the domain with one shift.
+    inline constexpr unsigned kCodeValueBits = 12;
+    inline constexpr uint16_t kCodeValueMask = (1u << kCodeValueBits) - 1;
+    inline constexpr uint16_t kMaxCodeDomains = 1u << (16 - kCodeValueBits);
+
+    constexpr uint16_t code_domain(Code c) noexcept {
+        return static_cast<uint16_t>(static_cast<uint16_t>(c) >> kCodeValueBits);
+    }
+
+    constexpr uint16_t code_value(Code c) noexcept {
+        return static_cast<uint16_t>(static_cast<uint16_t>(c) & kCodeValueMask);
+    }
+
+    // Values are truncated to 12 bits; use a static_assert on your enum if it matters.
+    constexpr Code make_code(uint16_t domain, uint16_t value) noexcept {
+        return static_cast<Code>(static_cast<uint16_t>((domain << kCodeValueBits) | (value & kCodeValueMask)));
+    }
+
+    struct CodeInfo {
+        const char *name;
+        Severity severity; // the usual severity for this code; checks still pick their own
+    };
+
+    // A domain is a constexpr object: id, name and a table indexed by value.
+    //   enum class Venue : uint16_t { Rejected = 1, Throttled, SessionDown };
+    //   inline constexpr Dodo::CodeInfo kVenueCodes[] = {{"none", R}, {"Rejected", R}, ...};
+    //   inline constexpr Dodo::CodeDomain kVenue{1, "venue", kVenueCodes};
+    //   return Dodo::Status::fail(kVenue.code(Venue::Throttled));
+    struct CodeDomain {
+        uint16_t id;
+        const char *name;
+        std::span<const CodeInfo> codes;
+
+        template<class E>
+            requires std::is_enum_v<E> || std::is_integral_v<E>
+        constexpr Code code(E v) const noexcept {
+            return make_code(id, static_cast<uint16_t>(v));
+        }
+
+        constexpr bool contains(Code c) const noexcept { return code_domain(c) == id; }
+
+        constexpr CodeInfo info(Code c) const noexcept {
+            const uint16_t v = code_value(c);
+            return v < codes.size() ? codes[v] : CodeInfo{"unknown", Severity::Recoverable};
+        }
+    };
+
+    namespace internal {
+        inline constexpr CodeInfo kCoreCodes[] = {
+            {"Ok", Severity::Recoverable},
+            {"PreconditionFailed", Severity::Recoverable},
+            {"PostconditionFailed", Severity::Recoverable},
+            {"InvariantBroken", Severity::Fatal},
+            {"NullPointer", Severity::Recoverable},
+            {"OutOfRange", Severity::Recoverable},
+            {"Misaligned", Severity::Recoverable},
+            {"Overflow", Severity::Recoverable},
+            {"Timeout", Severity::Recoverable},
+            {"ExternalFault", Severity::Recoverable},
+            {"InternalFault", Severity::Recoverable},
+        };
+        static_assert(std::size(kCoreCodes) == static_cast<size_t>(Code::InternalFault) + 1,
+                      "kCoreCodes must list every Dodo::Code");
+    }
+
+    inline constexpr CodeDomain kCoreDomain{0, "dodo", internal::kCoreCodes};
+
+    namespace internal {
+        // Domains known to the generic lookups below, indexed by id. Slot 0 is fixed.
+        inline constinit std::atomic<const CodeDomain *> g_code_domains[kMaxCodeDomains]{&kCoreDomain};
+    }
+
+    // Makes a domain visible to code_name / code_severity (flight recorder dumps,
+    // generic handlers). Not needed for kVenue.info(c), which is constexpr.
+    // The domain must have static storage duration. Returns false if the id is
+    // out of range, 0, or already taken by a different domain.
+    inline bool register_code_domain(const CodeDomain &d) noexcept {
+        if (d.id == 0 || d.id >= kMaxCodeDomains) {
+            return false;
+        }
+        const CodeDomain *expected = nullptr;
+        return internal::g_code_domains[d.id].compare_exchange_strong(expected, &d, std::memory_order_acq_rel) ||
+               expected == &d;
+    }
+
+    inline const CodeDomain *find_code_domain(uint16_t id) noexcept {
+        return id < kMaxCodeDomains ? internal::g_code_domains[id].load(std::memory_order_acquire) : nullptr;
+    }
+
+    // Cold-path helpers: one shift, one acquire load, one array index.
+    inline const char *code_name(Code c) noexcept {
+        const CodeDomain *d = find_code_domain(code_domain(c));
+        return d ? d->info(c).name : "unknown";
+    }
+
+    inline Severity code_severity(Code c) noexcept {
+        const CodeDomain *d = find_code_domain(code_domain(c));
+        return d ? d->info(c).severity : Severity::Recoverable;
+    }
+
+    // Per-call-site descriptor. Every check macro expansion owns one static,
+    // constant-initialized instance (no dynamic init, no guard on the hot path).
+    // The address identifies the site, so handlers never hash file/line, and it
+    // stays unique under DODO_FAST_MODE where the strings are stripped.
+    struct Site {
         const char *expr; // nullptr if DODO_FAST_MODE
         const char *file; // nullptr if DODO_FAST_MODE
         uint32_t line; // 0 if DODO_FAST_MODE
         const char *func; // nullptr if DODO_FAST_MODE
+
+        // Failures observed at this site. Touched only on the cold path with a
+        // relaxed load+store (no lock prefix): concurrent failures at the same
+        // site may drop increments, which is fine for heatmaps.
+        mutable std::atomic<uint64_t> hits{0};
+#ifdef DODO_SITE_PROFILE
+        // Evaluations, passing or not (DODO_SITE_PROFILE only; hot path, relaxed).
+        mutable std::atomic<uint64_t> evals{0};
+#endif
+
+        // Registry link: a site joins the list on its first failure.
+        mutable std::atomic<bool> linked{false};
+        mutable const Site *next{nullptr};
+
+        constexpr Site(const char *e, const char *f, uint32_t l, const char *fn) noexcept
+            : expr{e}, file{f}, line{l}, func{fn} {
+        }
+
+        Site(const Site &) = delete;
+        Site &operator=(const Site &) = delete;
+    };
+
+    namespace internal {
+        // The enclosing function's name as a template argument of DODO_SITE's
+        // lambda: one static copy per distinct name, nullptr kept as nullptr.
+        template<size_t N>
+        struct SiteFunc {
+            char text[N]{};
+            bool null = true;
+
+            consteval SiteFunc(const char *s) noexcept : null{s == nullptr} {
+                for (size_t i = 0; s != nullptr && i + 1 < N; ++i) {
+                    text[i] = s[i];
+                }
+            }
+
+            constexpr const char *get() const noexcept { return null ? nullptr : text; }
+        };
+
+        consteval size_t site_func_size(const char *s) noexcept {
+            size_t n = 0;
+            while (s != nullptr && s[n] != '\0') {
+                ++n;
+            }
+            return n + 1;
+        }
+    }
+
+    // Minimal context. Constructed only on the cold path.
+#ifdef DODO_COMPACT_MODE
+    // Compact encoding: 8 bytes, one register. No per-site statics and no strings
+    // in the binary; site_id is a compile-time hash of "file:line:expr" that
+    // tools/dodo_sitemap resolves offline.
+    struct Failure {
+        Code code;
+        Severity sev;
+        uint32_t site_id; // 0 only for hand-built failures
+    };
+
+    static_assert(sizeof(Failure) == 8, "compact Failure must fit one register");
+#else
+    struct Failure {
+        Code code;
+        Severity sev;
+        const Site *site; // nullptr only for hand-built failures
     };
+#endif
+
+    namespace internal {
+        // Cold-path parameter: by value when the ABI passes Failure in registers
+        // (SysV: up to two words; Win64: one), so a failing check loads code/sev
+        // and the site address into argument registers instead of building the
+        // struct on the stack and passing its address.
+#if defined(_WIN64) || defined(_WIN32)
+        inline constexpr size_t kRegisterPassBytes = sizeof(uint64_t);
+#else
+        inline constexpr size_t kRegisterPassBytes = 2 * sizeof(void *);
+#endif
+        using FailureArg = std::conditional_t<sizeof(Failure) <= kRegisterPassBytes &&
+                                              std::is_trivially_copyable_v<Failure>, Failure, const Failure &>;
+
+        // Site identity as an integer (pointer bits, or the compact site ID), for
+        // containers that store it in an atomic word or select it branch-free.
+        inline uintptr_t site_bits(const Failure &f) noexcept {
+#ifdef DODO_COMPACT_MODE
+            return f.site_id;
+#else
+            return reinterpret_cast<uintptr_t>(f.site);
+#endif
+        }
+
+        inline Failure make_failure(Code code, Severity sev, uintptr_t site) noexcept {
+#ifdef DODO_COMPACT_MODE
+            return Failure{code, sev, static_cast<uint32_t>(site)};
+#else
+            return Failure{code, sev, reinterpret_cast<const Site *>(site)};
+#endif
+        }
+
+        // 32-bit FNV-1a over "file:line:expr"; 0 is reserved for "no site".
+        // Shared with tools/dodo_sitemap, which recomputes IDs from preprocessed source.
+        constexpr uint32_t site_id_of(const char *s, size_t n) noexcept {
+            uint32_t h = 2166136261u;
+            for (size_t i = 0; i < n; ++i) {
+                h = (h ^ static_cast<unsigned char>(s[i])) * 16777619u;
+            }
+            return h != 0 ? h : 1u;
+        }
+
+        template<size_t N>
+        consteval uint32_t site_key(const char (&key)[N]) noexcept {
+            return site_id_of(key, N - 1);
+        }
+    }
 
     // Status: nodiscard forces the caller to handle the error.
     // Fits in a single register (2 bytes + padding).
@@ -77,6 +468,41 @@ namespace Dodo {
         static constexpr Status fail(Code c) noexcept { return Status{c}; }
     };
 
+    // Result<T>: value + Code, returned by value instead of Status + out-parameter.
+    // Trivially copyable when T is; for T up to 8 bytes it travels in two
+    // registers (RAX:RDX on SysV x86-64), so the value never has to hit memory.
+    // On failure `value` is value-initialized and must not be used.
+    template<class T>
+    struct [[nodiscard]] Result {
+        T value;
+        Code code;
+
+        constexpr Result() noexcept : value{}, code{Code::Ok} {}
+        constexpr Result(T v, Code c) noexcept : value{v}, code{c} {}
+
+        // Status -> Result: lets DODO_TRY / check functions propagate a failure
+        // into a Result-returning function. An ok Status carries no value, so it
+        // becomes Code::InternalFault rather than an ok Result holding value{}.
+        // DODO_TRY only converts failures, where the compare folds away.
+        constexpr Result(Status s) noexcept : value{}, code{s.ok() ? Code::InternalFault : s.code} {}
+
+        constexpr bool ok() const noexcept { return code == Code::Ok; }
+
+        explicit constexpr operator bool() const noexcept { return ok(); }
+
+        // Result -> Status: drops the value (e.g. DODO_TRY(parse(...))).
+        constexpr operator Status() const noexcept { return Status{code}; }
+        constexpr Status status() const noexcept { return Status{code}; }
+
+        static constexpr Result ok_result(T v) noexcept { return Result{v, Code::Ok}; }
+        static constexpr Result fail(Code c) noexcept { return Result{T{}, c}; }
+    };
+
+    static_assert(sizeof(Status) == sizeof(Code), "Status must stay a bare Code");
+    static_assert(std::is_trivially_copyable_v<Result<uint32_t>>, "Result<T> must stay register-passable");
+    static_assert(sizeof(Result<uint32_t>) <= 2 * sizeof(void *), "Result<uint32_t> must fit in two registers");
+    static_assert(sizeof(Result<uint64_t>) <= 2 * sizeof(void *), "Result<uint64_t> must fit in two registers");
+
     // --------------------------------------------------------------------------
     // Policy Hooks (Function Pointers)
     // --------------------------------------------------------------------------
@@ -96,170 +522,2782 @@ namespace Dodo {
         return Status{f.code};
     }
 
-    // Global hooks (relaxed atomicity assumed: set during single-threaded init)
+    // Global hooks: atomic so handlers can be swapped while other threads fail.
+    // Stores are release, cold-path loads are acquire (a plain mov on x86).
+    // Per-thread overrides (ScopedFallback) are checked first and need no fence.
+    // Both live in one constant-initialized table: no dynamic init, one copy per process.
+    struct HandlerTable {
+        std::atomic<PanicFn> panic;
+        std::atomic<FallbackFn> fallback;
+    };
+
     namespace internal {
-        static PanicFn g_panic_handler = default_panic;
-        static FallbackFn g_fallback_handler = default_fallback;
+#ifdef DODO_EXTERN_HANDLER_TABLE
+        // Defined by exactly one TU via DODO_DEFINE_HANDLER_TABLE(panic, fallback).
+        extern constinit HandlerTable g_handlers;
+#else
+        inline constinit HandlerTable g_handlers{{default_panic}, {default_fallback}};
+#endif
+
+        inline thread_local FallbackFn t_fallback_override = nullptr;
+
+        inline PanicFn load_panic_handler() noexcept {
+            return g_handlers.panic.load(std::memory_order_acquire);
+        }
+
+        inline FallbackFn load_fallback_handler() noexcept {
+            const FallbackFn local = t_fallback_override;
+            return local ? local : g_handlers.fallback.load(std::memory_order_acquire);
+        }
     }
 
+    // Safe to call at any time, from any thread.
     inline void set_panic_handler(PanicFn fn) noexcept {
-        internal::g_panic_handler = fn ? fn : default_panic;
+        internal::g_handlers.panic.store(fn ? fn : default_panic, std::memory_order_release);
     }
 
     inline void set_fallback_handler(FallbackFn fn) noexcept {
-        internal::g_fallback_handler = fn ? fn : default_fallback;
+        internal::g_handlers.fallback.store(fn ? fn : default_fallback, std::memory_order_release);
     }
 
-    // --------------------------------------------------------------------------
-    // Cold Path Endpoints (Optimization: Move failure logic out of I-Cache)
-    // --------------------------------------------------------------------------
-
-    // 1) fail_fast: Fatal endpoint. Never returns.
-    [[noreturn]] DODO_COLD DODO_NOINLINE
-    inline void fail_fast(const Failure &f) noexcept {
-        internal::g_panic_handler(f);
-        // Should not reach here, but ensure noreturn semantics
-        DODO_TRAP();
-        while (true) {
-        }
+    // Process-wide handlers (ignores per-thread overrides).
+    inline PanicFn get_panic_handler() noexcept {
+        return internal::g_handlers.panic.load(std::memory_order_acquire);
     }
 
-    // 2) fail_recoverable: Recoverable endpoint.
-    DODO_COLD DODO_NOINLINE
-    inline Status fail_recoverable(const Failure &f) noexcept {
-        return internal::g_fallback_handler(f);
+    inline FallbackFn get_fallback_handler() noexcept {
+        return internal::g_handlers.fallback.load(std::memory_order_acquire);
     }
 
+    // RAII per-thread fallback override: a strategy thread can change its own
+    // degradation policy without touching (or fencing) any other core.
+    // Nests; restores the previous override on destruction.
+    class ScopedFallback {
+    public:
+        explicit ScopedFallback(FallbackFn fn) noexcept : prev_{internal::t_fallback_override} {
+            internal::t_fallback_override = fn ? fn : default_fallback;
+        }
+
+        ~ScopedFallback() { internal::t_fallback_override = prev_; }
+
+        ScopedFallback(const ScopedFallback &) = delete;
+        ScopedFallback &operator=(const ScopedFallback &) = delete;
+
+    private:
+        FallbackFn prev_;
+    };
+
     // --------------------------------------------------------------------------
-    // Hot Path Logic (Inline, Branch Predicted)
+    // Site Registry (lock-free, push-only, fed from the cold path)
     // --------------------------------------------------------------------------
 
-    // 3) require: Precondition (Recoverable)
-    // Usage: status = Dodo::require(x > 0, Code::OutOfRange, ctx);
-    inline Status require(bool cond, Code code, const Failure &f) noexcept {
-        (void) code;
-        if (DODO_LIKELY(cond)) {
-            return Status::ok_status();
-        }
-        return fail_recoverable(f);
-    }
+    namespace internal {
+        inline std::atomic<const Site *> g_site_head{nullptr};
 
-    // 4) ensure: Postcondition (Recoverable)
-    inline Status ensure(bool cond, Code code, const Failure &f) noexcept {
-        (void) code;
-        if (DODO_LIKELY(cond)) {
-            return Status::ok_status();
+        inline void record_site_hit(const Site *s) noexcept {
+            if (s == nullptr) {
+                return;
+            }
+            s->hits.store(s->hits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            if (DODO_LIKELY(s->linked.load(std::memory_order_relaxed)) ||
+                s->linked.exchange(true, std::memory_order_relaxed)) {
+                return;
+            }
+            // Treiber push; nodes are never removed, so there is no ABA.
+            const Site *head = g_site_head.load(std::memory_order_relaxed);
+            do {
+                s->next = head;
+            } while (!g_site_head.compare_exchange_weak(head, s, std::memory_order_release,
+                                                        std::memory_order_relaxed));
         }
-        return fail_recoverable(f);
-    }
 
-    // 5) invariant: Internal Consistency (Fatal)
-    inline void invariant(bool cond, Code code, const Failure &f) noexcept {
-        (void) code;
-        if (DODO_UNLIKELY(!cond)) {
-            fail_fast(f);
+        // Cold-path accounting for a failure's site (no-op in compact mode: no Site).
+        inline void record_failure(const Failure &f) noexcept {
+#ifdef DODO_COMPACT_MODE
+            (void) f;
+#else
+            record_site_hit(f.site);
+#endif
         }
     }
 
-    // 6) check_not_null (Recoverable)
-    // Template instantiates to a simple pointer check.
-    template<class T>
-    inline Status check_not_null(const T *p, Code code, const Failure &f) noexcept {
-        (void) code;
-        if (DODO_LIKELY(p != nullptr)) {
-            return Status::ok_status();
+    // Walks every site that has failed at least once (newest first). A site
+    // joins the registry from the cold path on its first failure, so checks
+    // that have only ever passed are not visited, even under DODO_SITE_PROFILE.
+    // Safe to call concurrently with failing checks; counters are relaxed snapshots.
+    // Usage: Dodo::for_each_site([](const Dodo::Site& s) noexcept { ... });
+    template<class Fn>
+    inline void for_each_site(Fn &&fn) noexcept {
+        for (const Site *s = internal::g_site_head.load(std::memory_order_acquire); s != nullptr; s = s->next) {
+            fn(*s);
         }
-        return fail_recoverable(f);
     }
 
-    // 7) check_range (Recoverable)
-    // Optimized to unsigned comparison trick where possible by compilers
-    template<class T>
-    inline Status check_range(T v, T lo, T hi, Code code, const Failure &f) noexcept {
-        (void) code;
-        if (DODO_LIKELY(v >= lo && v <= hi)) {
-            return Status::ok_status();
-        }
-        return fail_recoverable(f);
+    // Zeroes all hit counters; registered sites stay registered.
+    inline void reset_site_counters() noexcept {
+        for_each_site([](const Site &s) noexcept {
+            s.hits.store(0, std::memory_order_relaxed);
+#ifdef DODO_SITE_PROFILE
+            s.evals.store(0, std::memory_order_relaxed);
+#endif
+        });
     }
 
-    // 8) check_aligned (Recoverable)
-    inline Status check_aligned(const void *p, size_t align, Code code, const Failure &f) noexcept {
-        (void) code;
-        // Note: align must be power of 2. Use invariant() to enforce this if needed,
-        // but here we assume caller correctness for speed.
-        const uintptr_t addr = reinterpret_cast<uintptr_t>(p);
-        if (DODO_LIKELY((addr & (align - 1)) == 0)) {
-            return Status::ok_status();
-        }
-        return fail_recoverable(f);
-    }
+    // --------------------------------------------------------------------------
+    // Compile-Time Policies (direct calls instead of the global hooks)
+    // --------------------------------------------------------------------------
+    // A policy is any type with:
+    //   static void   panic(const Failure &) noexcept;    // must not return
+    //   static Status fallback(const Failure &) noexcept;
+    // basic_*<Policy> checks call these directly, so the cold path is a direct
+    // call (inlined into the cold endpoint when trivial, e.g. default_fallback).
 
-    // 9) propagate: Standardize early return
-    inline Status propagate(Status s) noexcept {
-        return s;
-    }
+    // Default: dispatch through the runtime hooks (set_*_handler).
+    struct RuntimePolicy {
+        static void panic(const Failure &f) noexcept { internal::load_panic_handler()(f); }
+        static Status fallback(const Failure &f) noexcept { return internal::load_fallback_handler()(f); }
+    };
 
-    // 10) fallback_or: Explicit local fallback
-    using FallbackAction = Status(*)(void) noexcept;
+    // Fixed handlers chosen at compile time.
+    // Usage: using FeedPolicy = Dodo::Policy<my_panic, Dodo::default_fallback>;
+    template<PanicFn Panic, FallbackFn Fallback = default_fallback>
+    struct Policy {
+        static void panic(const Failure &f) noexcept { Panic(f); }
+        static Status fallback(const Failure &f) noexcept { return Fallback(f); }
+    };
 
-    inline Status fallback_or(Status s, FallbackAction action) noexcept {
-        if (DODO_LIKELY(s.ok())) {
-            return s;
-        }
-        return action();
-    }
-}
+// Policy used by the DODO_* check macros. Define before use to bind every macro
+// check to a compile-time policy, e.g. -DDODO_POLICY=app::FeedPolicy.
+#ifndef DODO_POLICY
+#define DODO_POLICY Dodo::RuntimePolicy
+#endif
 
-// ----------------------------------------------------------------------------
-// Macros (Context Capture & Convenience)
-// ----------------------------------------------------------------------------
+    // --------------------------------------------------------------------------
+    // Failure Payload (offending operands, captured on the failure branch only)
+    // --------------------------------------------------------------------------
+    // A failing check passes its operands to the cold endpoint in argument
+    // registers; the endpoint builds the payload next to the Failure in its own
+    // frame. The success path neither stores nor copies anything, and Failure
+    // keeps its one- or two-register size. Handlers read it with payload_of(f)
+    // while they run (a copy of f has no payload).
 
-// Optimization parm: DODO_FAST_MODE
-// If defined, strips string literals from binary to reduce rodata size
-#ifdef DODO_FAST_MODE
-#define DODO_CTX(c, s) Dodo::Failure{(c), (s), nullptr, nullptr, 0u, nullptr}
-#define DODO_EXPR_STR(cond) nullptr
-#define DODO_MAKE_FAIL(severity, code_enum, cond_str) \
-        Dodo::Failure{(code_enum), (severity), (cond_str), nullptr, 0u, nullptr}
-#else
-#define DODO_CTX(c, s) Dodo::Failure{(c), (s), #c, __FILE__, static_cast<uint32_t>(__LINE__), __func__}
-#define DODO_EXPR_STR(cond) #cond
-#define DODO_MAKE_FAIL(severity, code_enum, cond_str) \
-        Dodo::Failure{(code_enum), (severity), (cond_str), __FILE__, static_cast<uint32_t>(__LINE__), __func__}
-#endif
+    enum class PayloadKind : uint8_t {
+        None,
+        Range,    // value, lo, hi
+        Aligned,  // address, alignment
+        Add,      // a, b
+        Sub,      // a, b
+        Mul,      // a, b
+        Narrow,   // value
+        Deadline, // now, deadline (clock ticks)
+        Values,   // up to 3 user operands (DODO_REQUIRE_WITH)
+    };
 
-// API Macros
-// Note: We pass the Failure object construction into the inline function
-// The compiler's inlining and dead-code elimination will ensure the Failure
-// struct is NOT constructed on the stack unless the branch is taken
+    // How to read the operand bits: integers are zero- or sign-extended to 64 bits,
+    // floating point is stored as the bits of a double, pointers as the address.
+    enum class OperandType : uint8_t { Unsigned, Signed, Float, Pointer };
 
-#define DODO_REQUIRE(cond, code) \
-    Dodo::require((cond), (code), DODO_MAKE_FAIL(Dodo::Severity::Recoverable, (code), DODO_EXPR_STR(cond)))
+    inline constexpr size_t kMaxOperands = 3;
 
-#define DODO_ENSURE(cond, code) \
-    Dodo::ensure((cond), (code), DODO_MAKE_FAIL(Dodo::Severity::Recoverable, (code), DODO_EXPR_STR(cond)))
+    struct FailurePayload {
+        PayloadKind kind;
+        uint8_t count; // operands[0, count) are set
+        OperandType types[kMaxOperands];
+        uint64_t operands[kMaxOperands];
+        const void *context; // user context (DODO_REQUIRE_WITH), nullptr otherwise
+    };
 
-#define DODO_INVARIANT(cond, code) \
-    Dodo::invariant((cond), (code), DODO_MAKE_FAIL(Dodo::Severity::Fatal, (code), DODO_EXPR_STR(cond)))
+    namespace internal {
+        template<class T>
+        inline constexpr bool is_operand_v = std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>;
 
-#define DODO_CHECK_NOT_NULL(ptr, code) \
-    Dodo::check_not_null((ptr), (code), DODO_MAKE_FAIL(Dodo::Severity::Recoverable, (code), DODO_EXPR_STR(ptr)))
+        template<class T>
+        constexpr OperandType operand_type() noexcept {
+            if constexpr (std::is_pointer_v<T>) {
+                return OperandType::Pointer;
+            } else if constexpr (std::is_floating_point_v<T>) {
+                return OperandType::Float;
+            } else if constexpr (std::is_enum_v<T>) {
+                return operand_type<std::underlying_type_t<T>>();
+            } else {
+                return std::is_signed_v<T> ? OperandType::Signed : OperandType::Unsigned;
+            }
+        }
 
-#define DODO_CHECK_RANGE(v, lo, hi, code) \
-    Dodo::check_range((v), (lo), (hi), (code), DODO_MAKE_FAIL(Dodo::Severity::Recoverable, (code), DODO_EXPR_STR(v)))
+        template<class T>
+        inline uint64_t operand_bits(T v) noexcept {
+            if constexpr (std::is_pointer_v<T>) {
+                return reinterpret_cast<uintptr_t>(v);
+            } else if constexpr (std::is_floating_point_v<T>) {
+                return std::bit_cast<uint64_t>(static_cast<double>(v));
+            } else if constexpr (std::is_enum_v<T>) {
+                return operand_bits(static_cast<std::underlying_type_t<T>>(v));
+            } else if constexpr (std::is_signed_v<T>) {
+                return static_cast<uint64_t>(static_cast<int64_t>(v));
+            } else {
+                return static_cast<uint64_t>(v);
+            }
+        }
 
-#define DODO_CHECK_ALIGNED(ptr, alignment, code) \
-    Dodo::check_aligned((ptr), (alignment), (code), DODO_MAKE_FAIL(Dodo::Severity::Recoverable, (code), DODO_EXPR_STR(ptr)))
+        struct FailureDetail {
+            Failure failure;
+            FailurePayload payload;
+        };
 
+        // The detail whose handlers are running on this thread (cold path only).
+        inline thread_local const FailureDetail *t_failure_detail = nullptr;
 
-// Control Sugar-Flow 
-#define DODO_TRY(stmt) \
-    do { \
-        Dodo::Status _dodo_s = (stmt); \
-        if (DODO_UNLIKELY(!_dodo_s.ok())) { \
-            return Dodo::propagate(_dodo_s); \
-        } \
+        // Publishes a detail for the duration of the handler calls; nests when a
+        // handler itself fails a check.
+        class DetailScope {
+        public:
+            explicit DetailScope(const FailureDetail &d) noexcept : prev_{t_failure_detail} { t_failure_detail = &d; }
+
+            ~DetailScope() { t_failure_detail = prev_; }
+
+            DetailScope(const DetailScope &) = delete;
+            DetailScope &operator=(const DetailScope &) = delete;
+
+        private:
+            const FailureDetail *prev_;
+        };
+    }
+
+    // Payload of the failure being handled, or nullptr (hand-built failure,
+    // check without operands, or `f` is a copy). Valid until the handler returns.
+    inline const FailurePayload *payload_of(const Failure &f) noexcept {
+        const internal::FailureDetail *d = internal::t_failure_detail;
+        return d != nullptr && &d->failure == &f ? &d->payload : nullptr;
+    }
+
+    // --------------------------------------------------------------------------
+    // Binary Failure Encoding (byte stores on the cold path, text on the reader)
+    // --------------------------------------------------------------------------
+    // A handler that logs from the cold path encodes the failure and its payload
+    // into a few bytes; no stdio, no formatting, nothing a trading binary must
+    // link for errors alone. The reader (reporter thread, log shipper, offline
+    // tool) decodes and formats. The record layout is fixed by the payload kind,
+    // which each check macro chooses at compile time, so there is no format
+    // string to parse on either side. Layout v1, little-endian, unaligned:
+    //   u8      record length in bytes
+    //   u8      Severity
+    //   u16     Code
+    //   u8      PayloadKind
+    //   u8      operand count (bits 0-1), OperandType of operand k (bits 2k+2..2k+3)
+    //   u8      flags: bit 0 = context follows
+    //   varint  site: internal::site_bits() (Site address, or the compact site ID)
+    //   count x operand: Float as 8 raw bytes, Signed as zigzag varint, else varint
+    //   varint  context (when flagged)
+    // A Site address means something only inside the encoding process (sites
+    // are immortal statics there); other processes key on it, or use compact
+    // mode and tools/dodo_sitemap. format_failure() in DodoFormat.hpp renders a
+    // decoded record as text.
+    inline constexpr size_t kMaxEncodedFailure = 64; // 7 + 10 + 3 * 10 + 10 bytes at most
+
+    struct DecodedFailure {
+        Code code;
+        Severity sev;
+        uint64_t site; // site_bits() of the encoding process
+        FailurePayload payload; // kind == None when the failure carried none
+
+        // The failure as the encoding process saw it. Only meaningful there:
+        // elsewhere the Site address dangles (compact IDs are fine anywhere).
+        Failure local_failure() const noexcept {
+#ifdef DODO_COMPACT_MODE
+            return Failure{code, sev, static_cast<uint32_t>(site)};
+#else
+            return Failure{code, sev, reinterpret_cast<const Site *>(static_cast<uintptr_t>(site))};
+#endif
+        }
+    };
+
+    namespace internal {
+        inline size_t put_varint(unsigned char *out, uint64_t v) noexcept {
+            size_t n = 0;
+            while (v >= 0x80u) {
+                out[n++] = static_cast<unsigned char>(v | 0x80u);
+                v >>= 7;
+            }
+            out[n++] = static_cast<unsigned char>(v);
+            return n;
+        }
+
+        // False when the varint is truncated or longer than 10 bytes.
+        inline bool get_varint(const unsigned char *in, size_t n, size_t &i, uint64_t &v) noexcept {
+            v = 0;
+            for (unsigned shift = 0; shift < 64 && i < n; shift += 7) {
+                const unsigned char b = in[i++];
+                v |= static_cast<uint64_t>(b & 0x7fu) << shift;
+                if ((b & 0x80u) == 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        constexpr uint64_t zigzag(uint64_t v) noexcept { return (v << 1) ^ (uint64_t{0} - (v >> 63)); }
+        constexpr uint64_t unzigzag(uint64_t v) noexcept { return (v >> 1) ^ (uint64_t{0} - (v & 1u)); }
+    }
+
+    // Encodes `f` and `p` (nullptr: no payload) into buf. Returns the record
+    // length, or 0 with nothing written when it does not fit in cap; a buffer
+    // of kMaxEncodedFailure bytes always fits. Async-signal-safe.
+    inline size_t encode_failure(const Failure &f, const FailurePayload *p, void *buf, size_t cap) noexcept {
+        using internal::put_varint;
+        const FailurePayload none{};
+        const FailurePayload &q = p != nullptr ? *p : none;
+        const uint8_t count = q.count < kMaxOperands ? q.count : static_cast<uint8_t>(kMaxOperands);
+        unsigned meta = count;
+        for (unsigned k = 0; k < count; ++k) {
+            meta |= (static_cast<unsigned>(q.types[k]) & 3u) << (2 * k + 2);
+        }
+        const uint16_t code = static_cast<uint16_t>(f.code);
+
+        unsigned char rec[kMaxEncodedFailure];
+        rec[1] = static_cast<unsigned char>(f.sev);
+        rec[2] = static_cast<unsigned char>(code);
+        rec[3] = static_cast<unsigned char>(code >> 8);
+        rec[4] = static_cast<unsigned char>(q.kind);
+        rec[5] = static_cast<unsigned char>(meta);
+        rec[6] = static_cast<unsigned char>(q.context != nullptr ? 1u : 0u);
+        size_t n = 7;
+        n += put_varint(rec + n, internal::site_bits(f));
+        for (unsigned k = 0; k < count; ++k) {
+            const uint64_t v = q.operands[k];
+            switch (q.types[k]) {
+                case OperandType::Float:
+                    for (unsigned b = 0; b < 8; ++b) {
+                        rec[n++] = static_cast<unsigned char>(v >> (8 * b));
+                    }
+                    break;
+                case OperandType::Signed:
+                    n += put_varint(rec + n, internal::zigzag(v));
+                    break;
+                case OperandType::Unsigned:
+                case OperandType::Pointer:
+                    n += put_varint(rec + n, v);
+                    break;
+            }
+        }
+        if (q.context != nullptr) {
+            n += put_varint(rec + n, reinterpret_cast<uintptr_t>(q.context));
+        }
+        rec[0] = static_cast<unsigned char>(n);
+        if (n > cap) {
+            return 0;
+        }
+        unsigned char *out = static_cast<unsigned char *>(buf);
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = rec[i];
+        }
+        return n;
+    }
+
+    // From a handler: the payload of the failure being handled, if any.
+    inline size_t encode_failure(const Failure &f, void *buf, size_t cap) noexcept {
+        return encode_failure(f, payload_of(f), buf, cap);
+    }
+
+    // Decodes the record at buf[0, n). Returns its length (where the next record
+    // of a stream starts), or 0 when it is truncated or malformed; `out` is then
+    // unspecified.
+    inline size_t decode_failure(const void *buf, size_t n, DecodedFailure &out) noexcept {
+        const unsigned char *in = static_cast<const unsigned char *>(buf);
+        if (n < 8 || in[0] < 8 || in[0] > n || in[0] > kMaxEncodedFailure) {
+            return 0;
+        }
+        const size_t len = in[0];
+        const unsigned meta = in[5];
+        const unsigned count = meta & 3u;
+        if (in[1] > static_cast<unsigned>(Severity::Fatal) || in[4] > static_cast<unsigned>(PayloadKind::Values) ||
+            count > kMaxOperands || in[6] > 1u) {
+            return 0;
+        }
+        out = DecodedFailure{};
+        out.sev = static_cast<Severity>(in[1]);
+        out.code = static_cast<Code>(static_cast<uint16_t>(in[2] | (in[3] << 8)));
+        out.payload.kind = static_cast<PayloadKind>(in[4]);
+        out.payload.count = static_cast<uint8_t>(count);
+        size_t i = 7;
+        if (!internal::get_varint(in, len, i, out.site)) {
+            return 0;
+        }
+        for (unsigned k = 0; k < count; ++k) {
+            const OperandType t = static_cast<OperandType>((meta >> (2 * k + 2)) & 3u);
+            out.payload.types[k] = t;
+            uint64_t v = 0;
+            if (t == OperandType::Float) {
+                if (len - i < 8) {
+                    return 0;
+                }
+                for (unsigned b = 0; b < 8; ++b) {
+                    v |= static_cast<uint64_t>(in[i++]) << (8 * b);
+                }
+            } else if (!internal::get_varint(in, len, i, v)) {
+                return 0;
+            } else if (t == OperandType::Signed) {
+                v = internal::unzigzag(v);
+            }
+            out.payload.operands[k] = v;
+        }
+        if (in[6] != 0) {
+            uint64_t ctx = 0;
+            if (!internal::get_varint(in, len, i, ctx)) {
+                return 0;
+            }
+            out.payload.context = reinterpret_cast<const void *>(static_cast<uintptr_t>(ctx));
+        }
+        return i == len ? len : 0;
+    }
+
+    // --------------------------------------------------------------------------
+    // Cold Path Endpoints (Optimization: Move failure logic out of I-Cache)
+    // --------------------------------------------------------------------------
+
+    // 1) fail_fast: Fatal endpoint. Never returns.
+    template<class P>
+    [[noreturn]] DODO_COLD DODO_NOINLINE
+    inline void basic_fail_fast(internal::FailureArg f) noexcept {
+        internal::record_failure(f);
+        P::panic(f);
+        // Should not reach here, but ensure noreturn semantics
+        DODO_TRAP();
+        while (true) {
+        }
+    }
+
+    [[noreturn]] inline void fail_fast(const Failure &f) noexcept {
+        basic_fail_fast<RuntimePolicy>(f);
+    }
+
+    // 2) fail_recoverable: Recoverable endpoint.
+    template<class P>
+    DODO_COLD DODO_NOINLINE
+    inline Status basic_fail_recoverable(internal::FailureArg f) noexcept {
+        internal::record_failure(f);
+        return P::fallback(f);
+    }
+
+    inline Status fail_recoverable(const Failure &f) noexcept {
+        return basic_fail_recoverable<RuntimePolicy>(f);
+    }
+
+    // 2a) fail_recoverable_warm: the same endpoint without `cold`, for checks that
+    // fail often (DODO_REQUIRE_EXPECT below DODO_WARM_BELOW). GCC places every
+    // branch that calls a cold function in .text.unlikely whatever its expected
+    // probability, so a 30%-failing check needs a callee that is merely
+    // out of line.
+    template<class P>
+    DODO_NOINLINE
+    inline Status basic_fail_recoverable_warm(internal::FailureArg f) noexcept {
+        internal::record_failure(f);
+        return P::fallback(f);
+    }
+
+    // 2b) fail_recoverable_with: the same endpoint carrying the check's operands (and an
+    // optional user context). They arrive in argument registers and become the
+    // FailurePayload that handlers and the flight recorder see via payload_of(f).
+    namespace internal {
+        template<PayloadKind K, class... T>
+        inline FailureDetail make_detail(FailureArg f, const void *ctx, T... ops) noexcept {
+            static_assert(sizeof...(T) <= kMaxOperands, "a failure payload holds at most kMaxOperands operands");
+            static_assert((is_operand_v<T> && ...), "operands must be arithmetic, enum or pointer values");
+            return FailureDetail{f, FailurePayload{K, static_cast<uint8_t>(sizeof...(T)), {operand_type<T>()...},
+                                                   {operand_bits(ops)...}, ctx}};
+        }
+    }
+
+#ifndef DODO_NO_FAILURE_PAYLOAD
+    template<class P, PayloadKind K, class... T>
+    DODO_COLD DODO_NOINLINE
+    inline Status basic_fail_recoverable_with(internal::FailureArg f, const void *ctx, T... ops) noexcept {
+        const internal::FailureDetail d = internal::make_detail<K>(f, ctx, ops...);
+        const internal::DetailScope scope{d};
+        internal::record_failure(d.failure);
+        return P::fallback(d.failure);
+    }
+#else
+    // DODO_NO_FAILURE_PAYLOAD: operands are dropped at the call site, so a check
+    // site costs what it did before payloads existed.
+    template<class P, PayloadKind K, class... T>
+    DODO_ALWAYS_INLINE
+    inline Status basic_fail_recoverable_with(internal::FailureArg f, const void *, T...) noexcept {
+        return basic_fail_recoverable<P>(f);
+    }
+#endif
+
+    // --------------------------------------------------------------------------
+    // Hot Path Logic (Inline, Branch Predicted)
+    // --------------------------------------------------------------------------
+    // basic_*<P> take the policy explicitly; the unprefixed names use RuntimePolicy.
+    // They are force-inlined: otherwise -Os outlines them and every macro site
+    // builds its Failure on the stack just to make the (hot) call.
+    // They are also constexpr (except the pointer check_aligned): a check that
+    // fails during constant evaluation reaches the non-constexpr cold endpoint,
+    // so the static_assert / constexpr initializer fails to compile.
+
+    namespace internal {
+        // DODO_SITE_PROFILE evaluation counter; nothing otherwise.
+        DODO_ALWAYS_INLINE
+        constexpr void count_eval(const Failure &f) noexcept {
+#ifdef DODO_SITE_PROFILE
+            if (!std::is_constant_evaluated() && f.site != nullptr) {
+                f.site->evals.store(f.site->evals.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+#else
+            (void) f;
+#endif
+        }
+    }
+
+    // 3) require: Precondition (Recoverable)
+    // Usage: status = Dodo::require(x > 0, Code::OutOfRange, ctx);
+    template<class P>
+    DODO_ALWAYS_INLINE
+    constexpr Status basic_require(bool cond, Code code, const Failure &f) noexcept {
+        (void) code;
+        internal::count_eval(f);
+        if (DODO_LIKELY(cond)) {
+            return Status::ok_status();
+        }
+        return basic_fail_recoverable<P>(f);
+    }
+
+    constexpr Status require(bool cond, Code code, const Failure &f) noexcept {
+        return basic_require<RuntimePolicy>(cond, code, f);
+    }
+
+    // 3a) require_expect: require with the measured probability Pass that `cond`
+    // holds, from production counters (DODO_SITE_PROFILE + tools/dodo_profgen)
+    // or by hand. The branch gets that probability instead of "always passes";
+    // below DODO_WARM_BELOW the failure also goes to the warm endpoint, so the
+    // failing path stays in the function's hot layout. Pass < 0 means no
+    // profile: exactly basic_require.
+    // Usage: DODO_TRY(DODO_REQUIRE_EXPECT(msg.len <= mtu, Code::OutOfRange, 0.7));
+    template<class P, double Pass>
+    DODO_ALWAYS_INLINE
+    constexpr Status basic_require_expect(bool cond, Code code, const Failure &f) noexcept {
+        static_assert(Pass <= 1.0, "pass probability must be in [0, 1] (or negative for 'no profile')");
+        if constexpr (Pass < 0.0) {
+            return basic_require<P>(cond, code, f);
+        } else {
+            (void) code;
+            internal::count_eval(f);
+            if (DODO_EXPECT_PROB(cond, Pass)) {
+                return Status::ok_status();
+            }
+            if constexpr (Pass < DODO_WARM_BELOW) {
+                return basic_fail_recoverable_warm<P>(f);
+            } else {
+                return basic_fail_recoverable<P>(f);
+            }
+        }
+    }
+
+    // Site profile: DODO_SITE_PROFILE_HEADER="path" (absolute, or on the include
+    // path) includes a list generated by tools/dodo_profgen from
+    // format_site_profile() (DodoFormat.hpp) output,
+    //   DODO_SITE_EXPECT("src/ingress.cpp", 88, 0.7012)
+    // and every DODO_REQUIRE at a listed file/line becomes DODO_REQUIRE_EXPECT
+    // with that pass rate. Unlisted sites (and builds without the header) keep
+    // the default hint. Files match as spelled by __FILE__, so build the profiled
+    // and the optimized binary from the same directory.
+    struct SiteExpectation {
+        const char *file;
+        uint32_t line;
+        double pass;
+    };
+
+    namespace internal {
+#ifdef DODO_SITE_PROFILE_HEADER
+        inline constexpr SiteExpectation kSiteProfile[] = {
+#define DODO_SITE_EXPECT(file, line, pass) SiteExpectation{(file), (line), (pass)},
+#include DODO_SITE_PROFILE_HEADER
+#undef DODO_SITE_EXPECT
+            SiteExpectation{nullptr, 0, -1.0}, // keeps the table non-empty
+        };
+#else
+        inline constexpr SiteExpectation kSiteProfile[] = {SiteExpectation{nullptr, 0, -1.0}};
+#endif
+
+        constexpr bool same_text(const char *a, const char *b) noexcept {
+            while (*a != '\0' && *a == *b) {
+                ++a;
+                ++b;
+            }
+            return *a == *b;
+        }
+
+        // Profiled pass rate of the site at file:line, or -1 (not profiled).
+        constexpr double profiled_pass(const char *file, uint32_t line) noexcept {
+            for (const SiteExpectation &e : kSiteProfile) {
+                if (e.file != nullptr && e.line == line && same_text(e.file, file)) {
+                    return e.pass;
+                }
+            }
+            return -1.0;
+        }
+    }
+
+    // 3b) require_with: require that reports up to 3 operands and a context
+    // pointer through the failure payload (Values). Nothing is stored unless
+    // `cond` is false.
+    // Usage: DODO_TRY(DODO_REQUIRE_WITH(qty <= limit, Code::OutOfRange, &order, qty, limit));
+    template<class P, class... T>
+    DODO_ALWAYS_INLINE
+    constexpr Status basic_require_with(bool cond, Code code, const Failure &f, const void *ctx, T... ops) noexcept {
+        (void) code;
+        internal::count_eval(f);
+        if (DODO_LIKELY(cond)) {
+            return Status::ok_status();
+        }
+        return basic_fail_recoverable_with<P, PayloadKind::Values>(f, ctx, ops...);
+    }
+
+    template<class... T>
+    constexpr Status require_with(bool cond, Code code, const Failure &f, const void *ctx, T... ops) noexcept {
+        return basic_require_with<RuntimePolicy>(cond, code, f, ctx, ops...);
+    }
+
+    // 4) ensure: Postcondition (Recoverable)
+    template<class P>
+    DODO_ALWAYS_INLINE
+    constexpr Status basic_ensure(bool cond, Code code, const Failure &f) noexcept {
+        (void) code;
+        internal::count_eval(f);
+        if (DODO_LIKELY(cond)) {
+            return Status::ok_status();
+        }
+        return basic_fail_recoverable<P>(f);
+    }
+
+    constexpr Status ensure(bool cond, Code code, const Failure &f) noexcept {
+        return basic_ensure<RuntimePolicy>(cond, code, f);
+    }
+
+    // 5) invariant: Internal Consistency (Fatal)
+    template<class P>
+    DODO_ALWAYS_INLINE
+    constexpr void basic_invariant(bool cond, Code code, const Failure &f) noexcept {
+        (void) code;
+        if (DODO_UNLIKELY(!cond)) {
+            basic_fail_fast<P>(f);
+        }
+    }
+
+    constexpr void invariant(bool cond, Code code, const Failure &f) noexcept {
+        basic_invariant<RuntimePolicy>(cond, code, f);
+    }
+
+    // 6) check_not_null (Recoverable)
+    // Template instantiates to a simple pointer check.
+    template<class P, class T>
+    DODO_ALWAYS_INLINE
+    constexpr Status basic_check_not_null(const T *p, Code code, const Failure &f) noexcept {
+        (void) code;
+        if (DODO_LIKELY(p != nullptr)) {
+            return Status::ok_status();
+        }
+        return basic_fail_recoverable<P>(f);
+    }
+
+    template<class T>
+    constexpr Status check_not_null(const T *p, Code code, const Failure &f) noexcept {
+        return basic_check_not_null<RuntimePolicy>(p, code, f);
+    }
+
+    // 7) check_range (Recoverable)
+    // Optimized to unsigned comparison trick where possible by compilers
+    template<class P, class T>
+    DODO_ALWAYS_INLINE
+    constexpr Status basic_check_range(T v, T lo, T hi, Code code, const Failure &f) noexcept {
+        (void) code;
+        if (DODO_LIKELY(v >= lo && v <= hi)) {
+            return Status::ok_status();
+        }
+        if constexpr (internal::is_operand_v<T>) {
+            return basic_fail_recoverable_with<P, PayloadKind::Range>(f, nullptr, v, lo, hi);
+        } else {
+            return basic_fail_recoverable<P>(f);
+        }
+    }
+
+    template<class T>
+    constexpr Status check_range(T v, T lo, T hi, Code code, const Failure &f) noexcept {
+        return basic_check_range<RuntimePolicy, T>(v, lo, hi, code, f);
+    }
+
+    // 8) check_aligned (Recoverable)
+    template<class P>
+    DODO_ALWAYS_INLINE
+    inline Status basic_check_aligned(const void *p, size_t align, Code code, const Failure &f) noexcept {
+        (void) code;
+        // Note: align must be power of 2. Use invariant() to enforce this if needed,
+        // but here we assume caller correctness for speed.
+        const uintptr_t addr = reinterpret_cast<uintptr_t>(p);
+        if (DODO_LIKELY((addr & (align - 1)) == 0)) {
+            return Status::ok_status();
+        }
+        return basic_fail_recoverable_with<P, PayloadKind::Aligned>(f, nullptr, p, align);
+    }
+
+    inline Status check_aligned(const void *p, size_t align, Code code, const Failure &f) noexcept {
+        return basic_check_aligned<RuntimePolicy>(p, align, code, f);
+    }
+
+    // Address given as an integer (MMIO base, offset, layout constant): usable in
+    // constant evaluation, where a pointer's address bits are not available.
+    template<class P, class A> requires std::is_integral_v<A>
+    DODO_ALWAYS_INLINE
+    constexpr Status basic_check_aligned(A addr, size_t align, Code code, const Failure &f) noexcept {
+        (void) code;
+        if (DODO_LIKELY((static_cast<uintptr_t>(addr) & (align - 1)) == 0)) {
+            return Status::ok_status();
+        }
+        return basic_fail_recoverable_with<P, PayloadKind::Aligned>(f, nullptr, addr, align);
+    }
+
+    template<class A> requires std::is_integral_v<A>
+    constexpr Status check_aligned(A addr, size_t align, Code code, const Failure &f) noexcept {
+        return basic_check_aligned<RuntimePolicy>(addr, align, code, f);
+    }
+
+    // --------------------------------------------------------------------------
+    // Batched Checks (SIMD block compare, one branch per span)
+    // --------------------------------------------------------------------------
+
+    namespace internal::simd {
+        // Kernel traits: Acc accumulates "bad lane" bits across blocks without
+        // branching; any() is evaluated once per span.
+        template<class K, class T>
+        inline bool all_in_range_blocks(const T *p, size_t n, T lo, T hi) noexcept {
+            const auto vlo = K::splat(lo);
+            const auto vhi = K::splat(hi);
+            auto acc = K::none();
+            const size_t full = n - n % K::lanes;
+            for (size_t i = 0; i < full; i += K::lanes) {
+                acc = K::merge(acc, K::out_of_range(K::load(p + i), vlo, vhi));
+            }
+            bool bad = K::any(acc);
+            for (size_t i = full; i < n; ++i) {
+                bad |= !(p[i] >= lo && p[i] <= hi);
+            }
+            return !bad;
+        }
+
+        template<class K, class T>
+        inline bool none_null_blocks(const T *const *p, size_t n) noexcept {
+            auto acc = K::none();
+            const size_t full = n - n % K::lanes;
+            for (size_t i = 0; i < full; i += K::lanes) {
+                acc = K::merge(acc, K::is_null(K::load(p + i)));
+            }
+            bool bad = K::any(acc);
+            for (size_t i = full; i < n; ++i) {
+                bad |= (p[i] == nullptr);
+            }
+            return !bad;
+        }
+
+        // Integer lanes use clamp(v) == v, which needs lo <= hi (checked by the caller).
+#if defined(__AVX512F__)
+#define DODO_SIMD_ISA "avx512"
+        struct I32 {
+            static constexpr size_t lanes = 16;
+            static __m512i load(const int32_t *p) noexcept { return _mm512_loadu_si512(p); }
+            static __m512i splat(int32_t x) noexcept { return _mm512_set1_epi32(x); }
+            static __mmask16 none() noexcept { return 0; }
+            static __mmask16 out_of_range(__m512i v, __m512i lo, __m512i hi) noexcept {
+                return static_cast<__mmask16>(_mm512_cmplt_epi32_mask(v, lo) | _mm512_cmpgt_epi32_mask(v, hi));
+            }
+            static __mmask16 merge(__mmask16 a, __mmask16 b) noexcept { return static_cast<__mmask16>(a | b); }
+            static bool any(__mmask16 a) noexcept { return a != 0; }
+        };
+        struct U32 {
+            static constexpr size_t lanes = 16;
+            static __m512i load(const uint32_t *p) noexcept { return _mm512_loadu_si512(p); }
+            static __m512i splat(uint32_t x) noexcept { return _mm512_set1_epi32(static_cast<int32_t>(x)); }
+            static __mmask16 none() noexcept { return 0; }
+            static __mmask16 out_of_range(__m512i v, __m512i lo, __m512i hi) noexcept {
+                return static_cast<__mmask16>(_mm512_cmplt_epu32_mask(v, lo) | _mm512_cmpgt_epu32_mask(v, hi));
+            }
+            static __mmask16 merge(__mmask16 a, __mmask16 b) noexcept { return static_cast<__mmask16>(a | b); }
+            static bool any(__mmask16 a) noexcept { return a != 0; }
+        };
+        struct F32 {
+            static constexpr size_t lanes = 16;
+            static __m512 load(const float *p) noexcept { return _mm512_loadu_ps(p); }
+            static __m512 splat(float x) noexcept { return _mm512_set1_ps(x); }
+            static __mmask16 none() noexcept { return 0; }
+            static __mmask16 out_of_range(__m512 v, __m512 lo, __m512 hi) noexcept {
+                // NaN fails, like the scalar `v >= lo && v <= hi`.
+                return static_cast<__mmask16>(~(_mm512_cmp_ps_mask(v, lo, _CMP_GE_OQ) & _mm512_cmp_ps_mask(v, hi, _CMP_LE_OQ)));
+            }
+            static __mmask16 merge(__mmask16 a, __mmask16 b) noexcept { return static_cast<__mmask16>(a | b); }
+            static bool any(__mmask16 a) noexcept { return a != 0; }
+        };
+        struct F64 {
+            static constexpr size_t lanes = 8;
+            static __m512d load(const double *p) noexcept { return _mm512_loadu_pd(p); }
+            static __m512d splat(double x) noexcept { return _mm512_set1_pd(x); }
+            static __mmask8 none() noexcept { return 0; }
+            static __mmask8 out_of_range(__m512d v, __m512d lo, __m512d hi) noexcept {
+                return static_cast<__mmask8>(~(_mm512_cmp_pd_mask(v, lo, _CMP_GE_OQ) & _mm512_cmp_pd_mask(v, hi, _CMP_LE_OQ)));
+            }
+            static __mmask8 merge(__mmask8 a, __mmask8 b) noexcept { return static_cast<__mmask8>(a | b); }
+            static bool any(__mmask8 a) noexcept { return a != 0; }
+        };
+        struct Ptr {
+            static constexpr size_t lanes = 8;
+            template<class T>
+            static __m512i load(const T *const *p) noexcept { return _mm512_loadu_si512(p); }
+            static __mmask8 none() noexcept { return 0; }
+            static __mmask8 is_null(__m512i v) noexcept { return _mm512_cmpeq_epi64_mask(v, _mm512_setzero_si512()); }
+            static __mmask8 merge(__mmask8 a, __mmask8 b) noexcept { return static_cast<__mmask8>(a | b); }
+            static bool any(__mmask8 a) noexcept { return a != 0; }
+        };
+#elif defined(__AVX2__) || defined(__SSE4_1__)
+#if defined(__AVX2__)
+#define DODO_SIMD_ISA "avx2"
+        using VI = __m256i;
+        using VF = __m256;
+        using VD = __m256d;
+#define DODO_SIMD_OP(op) _mm256_##op
+#define DODO_SIMD_SI(op) _mm256_##op##_si256
+        constexpr size_t kBytes = 32;
+        inline bool any_bits(VI a) noexcept { return !_mm256_testz_si256(a, a); }
+        inline VF in_range(VF v, VF lo, VF hi) noexcept {
+            return _mm256_and_ps(_mm256_cmp_ps(v, lo, _CMP_GE_OQ), _mm256_cmp_ps(v, hi, _CMP_LE_OQ));
+        }
+        inline VD in_range(VD v, VD lo, VD hi) noexcept {
+            return _mm256_and_pd(_mm256_cmp_pd(v, lo, _CMP_GE_OQ), _mm256_cmp_pd(v, hi, _CMP_LE_OQ));
+        }
+        inline VF ones_ps() noexcept { return _mm256_castsi256_ps(_mm256_set1_epi32(-1)); }
+        inline VD ones_pd() noexcept { return _mm256_castsi256_pd(_mm256_set1_epi32(-1)); }
+#else
+#define DODO_SIMD_ISA "sse4.1"
+        using VI = __m128i;
+        using VF = __m128;
+        using VD = __m128d;
+#define DODO_SIMD_OP(op) _mm_##op
+#define DODO_SIMD_SI(op) _mm_##op##_si128
+        constexpr size_t kBytes = 16;
+        inline bool any_bits(VI a) noexcept { return !_mm_testz_si128(a, a); }
+        inline VF in_range(VF v, VF lo, VF hi) noexcept { return _mm_and_ps(_mm_cmpge_ps(v, lo), _mm_cmple_ps(v, hi)); }
+        inline VD in_range(VD v, VD lo, VD hi) noexcept { return _mm_and_pd(_mm_cmpge_pd(v, lo), _mm_cmple_pd(v, hi)); }
+        inline VF ones_ps() noexcept { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+        inline VD ones_pd() noexcept { return _mm_castsi128_pd(_mm_set1_epi32(-1)); }
+#endif
+        struct I32 {
+            static constexpr size_t lanes = kBytes / 4;
+            static VI load(const int32_t *p) noexcept { return DODO_SIMD_SI(loadu)(reinterpret_cast<const VI *>(p)); }
+            static VI splat(int32_t x) noexcept { return DODO_SIMD_OP(set1_epi32)(x); }
+            static VI none() noexcept { return DODO_SIMD_SI(setzero)(); }
+            static VI out_of_range(VI v, VI lo, VI hi) noexcept {
+                const VI clamped = DODO_SIMD_OP(min_epi32)(DODO_SIMD_OP(max_epi32)(v, lo), hi);
+                return DODO_SIMD_SI(xor)(DODO_SIMD_OP(cmpeq_epi32)(clamped, v), DODO_SIMD_OP(set1_epi32)(-1));
+            }
+            static VI merge(VI a, VI b) noexcept { return DODO_SIMD_SI(or)(a, b); }
+            static bool any(VI a) noexcept { return any_bits(a); }
+        };
+        struct U32 {
+            static constexpr size_t lanes = kBytes / 4;
+            static VI load(const uint32_t *p) noexcept { return DODO_SIMD_SI(loadu)(reinterpret_cast<const VI *>(p)); }
+            static VI splat(uint32_t x) noexcept { return DODO_SIMD_OP(set1_epi32)(static_cast<int32_t>(x)); }
+            static VI none() noexcept { return DODO_SIMD_SI(setzero)(); }
+            static VI out_of_range(VI v, VI lo, VI hi) noexcept {
+                const VI clamped = DODO_SIMD_OP(min_epu32)(DODO_SIMD_OP(max_epu32)(v, lo), hi);
+                return DODO_SIMD_SI(xor)(DODO_SIMD_OP(cmpeq_epi32)(clamped, v), DODO_SIMD_OP(set1_epi32)(-1));
+            }
+            static VI merge(VI a, VI b) noexcept { return DODO_SIMD_SI(or)(a, b); }
+            static bool any(VI a) noexcept { return any_bits(a); }
+        };
+        struct F32 {
+            static constexpr size_t lanes = kBytes / 4;
+            static VF load(const float *p) noexcept { return DODO_SIMD_OP(loadu_ps)(p); }
+            static VF splat(float x) noexcept { return DODO_SIMD_OP(set1_ps)(x); }
+            static VF none() noexcept { return DODO_SIMD_OP(setzero_ps)(); }
+            static VF out_of_range(VF v, VF lo, VF hi) noexcept {
+                // NaN fails, like the scalar `v >= lo && v <= hi`.
+                return DODO_SIMD_OP(andnot_ps)(in_range(v, lo, hi), ones_ps());
+            }
+            static VF merge(VF a, VF b) noexcept { return DODO_SIMD_OP(or_ps)(a, b); }
+            static bool any(VF a) noexcept { return DODO_SIMD_OP(movemask_ps)(a) != 0; }
+        };
+        struct F64 {
+            static constexpr size_t lanes = kBytes / 8;
+            static VD load(const double *p) noexcept { return DODO_SIMD_OP(loadu_pd)(p); }
+            static VD splat(double x) noexcept { return DODO_SIMD_OP(set1_pd)(x); }
+            static VD none() noexcept { return DODO_SIMD_OP(setzero_pd)(); }
+            static VD out_of_range(VD v, VD lo, VD hi) noexcept {
+                return DODO_SIMD_OP(andnot_pd)(in_range(v, lo, hi), ones_pd());
+            }
+            static VD merge(VD a, VD b) noexcept { return DODO_SIMD_OP(or_pd)(a, b); }
+            static bool any(VD a) noexcept { return DODO_SIMD_OP(movemask_pd)(a) != 0; }
+        };
+        struct Ptr {
+            static constexpr size_t lanes = kBytes / 8;
+            template<class T>
+            static VI load(const T *const *p) noexcept { return DODO_SIMD_SI(loadu)(reinterpret_cast<const VI *>(p)); }
+            static VI none() noexcept { return DODO_SIMD_SI(setzero)(); }
+            static VI is_null(VI v) noexcept { return DODO_SIMD_OP(cmpeq_epi64)(v, DODO_SIMD_SI(setzero)()); }
+            static VI merge(VI a, VI b) noexcept { return DODO_SIMD_SI(or)(a, b); }
+            static bool any(VI a) noexcept { return any_bits(a); }
+        };
+#undef DODO_SIMD_OP
+#undef DODO_SIMD_SI
+#elif defined(__ARM_NEON)
+#define DODO_SIMD_ISA "neon"
+        struct I32 {
+            static constexpr size_t lanes = 4;
+            static int32x4_t load(const int32_t *p) noexcept { return vld1q_s32(p); }
+            static int32x4_t splat(int32_t x) noexcept { return vdupq_n_s32(x); }
+            static uint32x4_t none() noexcept { return vdupq_n_u32(0); }
+            static uint32x4_t out_of_range(int32x4_t v, int32x4_t lo, int32x4_t hi) noexcept {
+                return vorrq_u32(vcltq_s32(v, lo), vcgtq_s32(v, hi));
+            }
+            static uint32x4_t merge(uint32x4_t a, uint32x4_t b) noexcept { return vorrq_u32(a, b); }
+            static bool any(uint32x4_t a) noexcept {
+                return vgetq_lane_u64(vreinterpretq_u64_u32(a), 0) != 0 || vgetq_lane_u64(vreinterpretq_u64_u32(a), 1) != 0;
+            }
+        };
+        struct U32 {
+            static constexpr size_t lanes = 4;
+            static uint32x4_t load(const uint32_t *p) noexcept { return vld1q_u32(p); }
+            static uint32x4_t splat(uint32_t x) noexcept { return vdupq_n_u32(x); }
+            static uint32x4_t none() noexcept { return vdupq_n_u32(0); }
+            static uint32x4_t out_of_range(uint32x4_t v, uint32x4_t lo, uint32x4_t hi) noexcept {
+                return vorrq_u32(vcltq_u32(v, lo), vcgtq_u32(v, hi));
+            }
+            static uint32x4_t merge(uint32x4_t a, uint32x4_t b) noexcept { return vorrq_u32(a, b); }
+            static bool any(uint32x4_t a) noexcept { return I32::any(a); }
+        };
+        struct F32 {
+            static constexpr size_t lanes = 4;
+            static float32x4_t load(const float *p) noexcept { return vld1q_f32(p); }
+            static float32x4_t splat(float x) noexcept { return vdupq_n_f32(x); }
+            static uint32x4_t none() noexcept { return vdupq_n_u32(0); }
+            static uint32x4_t out_of_range(float32x4_t v, float32x4_t lo, float32x4_t hi) noexcept {
+                // NaN fails, like the scalar `v >= lo && v <= hi`.
+                return vmvnq_u32(vandq_u32(vcgeq_f32(v, lo), vcleq_f32(v, hi)));
+            }
+            static uint32x4_t merge(uint32x4_t a, uint32x4_t b) noexcept { return vorrq_u32(a, b); }
+            static bool any(uint32x4_t a) noexcept { return I32::any(a); }
+        };
+#if defined(__aarch64__)
+        struct F64 {
+            static constexpr size_t lanes = 2;
+            static float64x2_t load(const double *p) noexcept { return vld1q_f64(p); }
+            static float64x2_t splat(double x) noexcept { return vdupq_n_f64(x); }
+            static uint64x2_t none() noexcept { return vdupq_n_u64(0); }
+            static uint64x2_t out_of_range(float64x2_t v, float64x2_t lo, float64x2_t hi) noexcept {
+                return veorq_u64(vandq_u64(vcgeq_f64(v, lo), vcleq_f64(v, hi)), vdupq_n_u64(~0ull));
+            }
+            static uint64x2_t merge(uint64x2_t a, uint64x2_t b) noexcept { return vorrq_u64(a, b); }
+            static bool any(uint64x2_t a) noexcept { return (vgetq_lane_u64(a, 0) | vgetq_lane_u64(a, 1)) != 0; }
+        };
+        struct Ptr {
+            static constexpr size_t lanes = 2;
+            template<class T>
+            static uint64x2_t load(const T *const *p) noexcept { return vld1q_u64(reinterpret_cast<const uint64_t *>(p)); }
+            static uint64x2_t none() noexcept { return vdupq_n_u64(0); }
+            static uint64x2_t is_null(uint64x2_t v) noexcept { return vceqzq_u64(v); }
+            static uint64x2_t merge(uint64x2_t a, uint64x2_t b) noexcept { return vorrq_u64(a, b); }
+            static bool any(uint64x2_t a) noexcept { return (vgetq_lane_u64(a, 0) | vgetq_lane_u64(a, 1)) != 0; }
+        };
+#endif
+#else
+#define DODO_SIMD_ISA "scalar"
+#endif
+
+        // Portable block kernel: branch-free OR-reduction the compiler can vectorize.
+        template<class T>
+        inline bool all_in_range_scalar(const T *p, size_t n, T lo, T hi) noexcept {
+            bool bad = false;
+            for (size_t i = 0; i < n; ++i) {
+                bad |= !(p[i] >= lo && p[i] <= hi);
+            }
+            return !bad;
+        }
+
+        template<class T>
+        inline bool all_in_range(const T *p, size_t n, T lo, T hi) noexcept {
+#if defined(__AVX512F__) || defined(__AVX2__) || defined(__SSE4_1__) || defined(__ARM_NEON)
+            if constexpr (std::is_same_v<T, int32_t>) {
+                return all_in_range_blocks<I32>(p, n, lo, hi);
+            } else if constexpr (std::is_same_v<T, uint32_t>) {
+                return all_in_range_blocks<U32>(p, n, lo, hi);
+            } else if constexpr (std::is_same_v<T, float>) {
+                return all_in_range_blocks<F32>(p, n, lo, hi);
+#if !defined(__ARM_NEON) || defined(__aarch64__)
+            } else if constexpr (std::is_same_v<T, double>) {
+                return all_in_range_blocks<F64>(p, n, lo, hi);
+#endif
+            } else {
+                return all_in_range_scalar(p, n, lo, hi);
+            }
+#else
+            return all_in_range_scalar(p, n, lo, hi);
+#endif
+        }
+
+        template<class T>
+        inline bool none_null(const T *const *p, size_t n) noexcept {
+#if (defined(__AVX512F__) || defined(__AVX2__) || defined(__SSE4_1__) || defined(__aarch64__) && defined(__ARM_NEON)) \
+    && UINTPTR_MAX == UINT64_MAX
+            return none_null_blocks<Ptr>(p, n);
+#else
+            bool bad = false;
+            for (size_t i = 0; i < n; ++i) {
+                bad |= (p[i] == nullptr);
+            }
+            return !bad;
+#endif
+        }
+    }
+
+    namespace internal {
+        template<class R>
+        using span_value_t = std::remove_cv_t<typename decltype(std::span{std::declval<const R &>()})::element_type>;
+
+        // Cold: locate the first offending element with a scalar scan, then dispatch.
+        template<class P, class T>
+        DODO_COLD DODO_NOINLINE
+        inline Status fail_range_at(const T *p, size_t n, T lo, T hi, FailureArg f, size_t *first_bad) noexcept {
+            size_t i = 0;
+            while (i < n && p[i] >= lo && p[i] <= hi) {
+                ++i;
+            }
+            if (first_bad != nullptr) {
+                *first_bad = i;
+            }
+            if (i < n) {
+                return basic_fail_recoverable_with<P, PayloadKind::Range>(f, nullptr, p[i], lo, hi);
+            }
+            return basic_fail_recoverable<P>(f);
+        }
+
+        template<class P, class T>
+        DODO_COLD DODO_NOINLINE
+        inline Status fail_null_at(const T *const *p, size_t n, FailureArg f, size_t *first_bad) noexcept {
+            size_t i = 0;
+            while (i < n && p[i] != nullptr) {
+                ++i;
+            }
+            if (first_bad != nullptr) {
+                *first_bad = i;
+            }
+            return basic_fail_recoverable<P>(f);
+        }
+    }
+
+    // 8b) check_range_all (Recoverable): every element of a contiguous range in [lo, hi].
+    // SIMD block compare (AVX-512 / AVX2 / SSE4.1 / NEON for int32, uint32, float,
+    // double), one branch per span. On failure the index of the first offending
+    // element is written to *first_bad (if given) from the cold path.
+    template<class P, class R>
+    DODO_ALWAYS_INLINE
+    inline Status basic_check_range_all(const R &values, internal::span_value_t<R> lo, internal::span_value_t<R> hi,
+                                        Code code, const Failure &f, size_t *first_bad = nullptr) noexcept {
+        (void) code;
+        const std::span v{values};
+        if (DODO_LIKELY(lo <= hi && internal::simd::all_in_range(v.data(), v.size(), lo, hi))) {
+            return Status::ok_status();
+        }
+        if (v.empty()) {
+            return Status::ok_status(); // lo > hi with nothing to check
+        }
+        return internal::fail_range_at<P>(v.data(), v.size(), lo, hi, f, first_bad);
+    }
+
+    template<class R>
+    inline Status check_range_all(const R &values, internal::span_value_t<R> lo, internal::span_value_t<R> hi,
+                                  Code code, const Failure &f, size_t *first_bad = nullptr) noexcept {
+        return basic_check_range_all<RuntimePolicy>(values, lo, hi, code, f, first_bad);
+    }
+
+    // 8c) check_not_null_all (Recoverable): no null pointer in a contiguous range of pointers.
+    template<class P, class R>
+    DODO_ALWAYS_INLINE
+    inline Status basic_check_not_null_all(const R &ptrs, Code code, const Failure &f, size_t *first_bad = nullptr) noexcept {
+        (void) code;
+        const std::span v{ptrs};
+        using E = internal::span_value_t<R>;
+        static_assert(std::is_pointer_v<E>, "check_not_null_all expects a range of pointers");
+        const auto *data = static_cast<const std::remove_pointer_t<E> *const *>(v.data());
+        if (DODO_LIKELY(internal::simd::none_null(data, v.size()))) {
+            return Status::ok_status();
+        }
+        return internal::fail_null_at<P>(data, v.size(), f, first_bad);
+    }
+
+    template<class R>
+    inline Status check_not_null_all(const R &ptrs, Code code, const Failure &f, size_t *first_bad = nullptr) noexcept {
+        return basic_check_not_null_all<RuntimePolicy>(ptrs, code, f, first_bad);
+    }
+
+    // 9) propagate: Standardize early return
+    constexpr Status propagate(Status s) noexcept {
+        return s;
+    }
+
+
+    // 10) fallback_or: Explicit local fallback
+    using FallbackAction = Status(*)(void) noexcept;
+
+    constexpr Status fallback_or(Status s, FallbackAction action) noexcept {
+        if (DODO_LIKELY(s.ok())) {
+            return s;
+        }
+        return action();
+    }
+
+    // --------------------------------------------------------------------------
+    // Validator ("validate all, branch once")
+    // --------------------------------------------------------------------------
+
+    // 11) Validator: folds a run of recoverable checks into one pass bit with
+    // bitwise AND and keeps the first failing site/code through masked selects,
+    // so N contracts cost one DODO_UNLIKELY branch in finish() instead of N.
+    // Every condition is evaluated: a check must not rely on an earlier one
+    // holding (e.g. a null check guarding a dereference).
+    template<class P>
+    class BasicValidator {
+    public:
+        void require(bool cond, Code code, const Failure &f) noexcept {
+            const uint32_t first = ok_ & static_cast<uint32_t>(!cond);
+            const uintptr_t m = uintptr_t{0} - first; // all-ones only for the first failure
+            site_ = (internal::site_bits(f) & m) | (site_ & ~m);
+            code_ = static_cast<uint16_t>((static_cast<uint16_t>(code) & m) | (code_ & ~m));
+            ok_ &= static_cast<uint32_t>(cond);
+            failed_ += static_cast<uint32_t>(!cond);
+        }
+
+        template<class T>
+        void check_not_null(const T *p, Code code, const Failure &f) noexcept {
+            require(p != nullptr, code, f);
+        }
+
+        template<class T>
+        void check_range(T v, T lo, T hi, Code code, const Failure &f) noexcept {
+            require((v >= lo) & (v <= hi), code, f);
+        }
+
+        void check_aligned(const void *p, size_t align, Code code, const Failure &f) noexcept {
+            require((reinterpret_cast<uintptr_t>(p) & (align - 1)) == 0, code, f);
+        }
+
+        bool ok() const noexcept { return ok_ != 0; }
+
+        // Number of failed checks so far (the Failure reports only the first).
+        uint32_t failed() const noexcept { return failed_; }
+
+        // First failing check; {Ok, Recoverable, nullptr} while ok().
+        Failure failure() const noexcept {
+            return internal::make_failure(static_cast<Code>(code_), Severity::Recoverable, site_);
+        }
+
+        // The single branch: dispatches the first failure through the cold path.
+        Status finish() const noexcept {
+            if (DODO_LIKELY(ok_ != 0)) {
+                return Status::ok_status();
+            }
+            return basic_fail_recoverable<P>(failure());
+        }
+
+    private:
+        uintptr_t site_ = 0;
+        uint32_t ok_ = 1;
+        uint32_t failed_ = 0;
+        uint16_t code_ = static_cast<uint16_t>(Code::Ok);
+    };
+
+    using Validator = BasicValidator<RuntimePolicy>;
+
+    // --------------------------------------------------------------------------
+    // Clocks & Deadlines (Code::Timeout from a counter read and a compare)
+    // --------------------------------------------------------------------------
+    // A clock is any type with:
+    //   static uint64_t now() noexcept;                   // monotonic ticks
+    //   static uint64_t ticks_from_ns(uint64_t) noexcept; // duration -> ticks
+    // now() is on the hot path; ticks_from_ns() only where a deadline is made.
+
+    namespace internal {
+        // a * b, UINT64_MAX instead of wrapping.
+        constexpr uint64_t mul_sat(uint64_t a, uint64_t b) noexcept {
+            return b != 0 && a > UINT64_MAX / b ? UINT64_MAX : a * b;
+        }
+
+        constexpr uint64_t add_sat(uint64_t a, uint64_t b) noexcept {
+            return b > UINT64_MAX - a ? UINT64_MAX : a + b;
+        }
+
+        // a * q / 2^32 without a 128-bit type (exact for a < 2^32, ~1 ulp above),
+        // UINT64_MAX when the result does not fit.
+        constexpr uint64_t mul_q32(uint64_t a, uint64_t q) noexcept {
+            const uint64_t lo = a & 0xFFFF'FFFFu;
+            return add_sat(add_sat(mul_sat(a >> 32, q), lo * (q >> 32)), (lo * (q & 0xFFFF'FFFFu)) >> 32);
+        }
+
+        // Counter ticks per ns in Q32.32; 0 = not calibrated yet.
+        inline constinit std::atomic<uint64_t> g_tsc_per_ns_q32{0};
+
+        // Cold, once: AArch64 reads the architected frequency, x86 times rdtsc
+        // against steady_clock for ~2 ms (busy wait, no sleep).
+        DODO_COLD DODO_NOINLINE inline uint64_t calibrate_tsc_q32() noexcept {
+            uint64_t q = 0;
+#if defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+            uint64_t hz;
+            __asm__ volatile("mrs %0, cntfrq_el0" : "=r"(hz));
+            q = (hz << 32) / 1'000'000'000u;
+#else
+            using Steady = std::chrono::steady_clock;
+            const Steady::time_point t0 = Steady::now();
+            const uint64_t c0 = read_tsc();
+            Steady::time_point t1 = t0;
+            while (t1 - t0 < std::chrono::milliseconds(2)) {
+                t1 = Steady::now();
+            }
+            const uint64_t c1 = read_tsc();
+            const uint64_t ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+            q = ((c1 - c0) << 32) / (ns != 0 ? ns : 1);
+#endif
+            if (q == 0) {
+                q = uint64_t{1} << 32; // no usable counter: treat ticks as ns
+            }
+            g_tsc_per_ns_q32.store(q, std::memory_order_relaxed);
+            return q;
+        }
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+        // CPUID.80000007H:EDX[8]: TSC runs at a constant rate in all P/C-states.
+        inline bool tsc_is_invariant() noexcept {
+            unsigned a, b, c, d;
+            __asm__ volatile("cpuid" : "=a"(a), "=b"(b), "=c"(c), "=d"(d) : "a"(0x8000'0000u), "c"(0u));
+            if (a < 0x8000'0007u) {
+                return false;
+            }
+            __asm__ volatile("cpuid" : "=a"(a), "=b"(b), "=c"(c), "=d"(d) : "a"(0x8000'0007u), "c"(0u));
+            return (d & (1u << 8)) != 0;
+        }
+#else
+        // The AArch64 generic timer is constant-rate by architecture.
+        inline bool tsc_is_invariant() noexcept {
+#if defined(__aarch64__)
+            return true;
+#else
+            return false;
+#endif
+        }
+#endif
+    }
+
+    // Default clock: rdtsc on x86 (unserialized; needs an invariant TSC, see
+    // invariant()), cntvct_el0 on AArch64. Calibrated on first conversion;
+    // call calibrate() at startup to keep that out of the first deadline.
+    struct TscClock {
+        static uint64_t now() noexcept { return internal::read_tsc(); }
+
+        static void calibrate() noexcept { (void) internal::calibrate_tsc_q32(); }
+
+        static bool invariant() noexcept { return internal::tsc_is_invariant(); }
+
+        static uint64_t ticks_per_ns_q32() noexcept {
+            const uint64_t q = internal::g_tsc_per_ns_q32.load(std::memory_order_relaxed);
+            return DODO_LIKELY(q != 0) ? q : internal::calibrate_tsc_q32();
+        }
+
+        static uint64_t ticks_from_ns(uint64_t ns) noexcept { return internal::mul_q32(ns, ticks_per_ns_q32()); }
+        static uint64_t ticks_from_us(uint64_t us) noexcept { return ticks_from_ns(internal::mul_sat(us, 1'000u)); }
+    };
+
+    // Portable fallback (vDSO clock_gettime on Linux): ticks are nanoseconds.
+    struct SteadyClock {
+        static uint64_t now() noexcept {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        static constexpr uint64_t ticks_from_ns(uint64_t ns) noexcept { return ns; }
+    };
+
+    // Absolute point on Clock's timeline; 8 bytes, passed in a register.
+    template<class Clock = TscClock>
+    struct BasicDeadline {
+        uint64_t at = UINT64_MAX; // default: never expires
+
+        static constexpr BasicDeadline never() noexcept { return BasicDeadline{}; }
+        static constexpr BasicDeadline at_ticks(uint64_t t) noexcept { return BasicDeadline{t}; }
+
+        // Saturate instead of wrapping for huge budgets (also in the unit conversion).
+        static BasicDeadline after_ns(uint64_t ns) noexcept {
+            return BasicDeadline{internal::add_sat(Clock::now(), Clock::ticks_from_ns(ns))};
+        }
+        static BasicDeadline after_us(uint64_t us) noexcept { return after_ns(internal::mul_sat(us, 1'000u)); }
+        static BasicDeadline after_ms(uint64_t ms) noexcept { return after_ns(internal::mul_sat(ms, 1'000'000u)); }
+
+        bool expired() const noexcept { return Clock::now() >= at; }
+
+        // Ticks left, 0 once expired.
+        uint64_t remaining() const noexcept {
+            const uint64_t now = Clock::now();
+            return now < at ? at - now : 0;
+        }
+    };
+
+    using Deadline = BasicDeadline<TscClock>;
+
+    // 12) check_deadline (Recoverable): one counter read and a compare.
+    template<class P, class Clock>
+    DODO_ALWAYS_INLINE
+    inline Status basic_check_deadline(BasicDeadline<Clock> d, const Failure &f) noexcept {
+        const uint64_t now = Clock::now();
+        if (DODO_LIKELY(now < d.at)) {
+            return Status::ok_status();
+        }
+        return basic_fail_recoverable_with<P, PayloadKind::Deadline>(f, nullptr, now, d.at);
+    }
+
+    template<class Clock>
+    inline Status check_deadline(BasicDeadline<Clock> d, const Failure &f) noexcept {
+        return basic_check_deadline<RuntimePolicy>(d, f);
+    }
+
+    // --------------------------------------------------------------------------
+    // Checked Arithmetic (Code::Overflow from the CPU flags, no division)
+    // --------------------------------------------------------------------------
+
+    namespace internal {
+        template<class T>
+        inline constexpr bool is_checked_int_v = std::is_integral_v<T> && !std::is_same_v<T, bool>;
+
+        // Portable exact arithmetic on any two integer types (up to 64 bits):
+        // sign + magnitude, so mixed signedness and width need no wider type.
+        struct WideInt {
+            bool neg;
+            uint64_t mag;
+        };
+
+        template<class V>
+        constexpr WideInt to_wide(V v) noexcept {
+            if constexpr (std::is_signed_v<V>) {
+                if (v < 0) {
+                    return WideInt{true, uint64_t{0} - static_cast<uint64_t>(v)};
+                }
+            }
+            return WideInt{false, static_cast<uint64_t>(v)};
+        }
+
+        // False on a magnitude carry. Zero is never negative.
+        constexpr bool wide_add(WideInt a, WideInt b, WideInt *r) noexcept {
+            if (a.neg == b.neg) {
+                r->neg = a.neg;
+                r->mag = a.mag + b.mag;
+                return r->mag >= a.mag;
+            }
+            const bool a_big = a.mag >= b.mag;
+            r->mag = a_big ? a.mag - b.mag : b.mag - a.mag;
+            r->neg = r->mag != 0 && (a_big ? a.neg : b.neg);
+            return true;
+        }
+
+        constexpr bool wide_mul(WideInt a, WideInt b, WideInt *r) noexcept {
+            r->mag = a.mag * b.mag;
+            r->neg = r->mag != 0 && a.neg != b.neg;
+            return a.mag == 0 || r->mag / a.mag == b.mag;
+        }
+
+        // True if the exact value does not fit T; *r holds its low bits.
+        template<class T>
+        constexpr bool wide_to(bool exact, WideInt w, T *r) noexcept {
+            using U = std::make_unsigned_t<T>;
+            *r = static_cast<T>(static_cast<U>(w.neg ? uint64_t{0} - w.mag : w.mag));
+            const uint64_t max = static_cast<uint64_t>(std::numeric_limits<T>::max());
+            if (!exact) {
+                return true;
+            }
+            if (!w.neg) {
+                return w.mag > max;
+            }
+            return std::is_unsigned_v<T> || w.mag > max + 1;
+        }
+
+        // Portable forms of the predicates below (non-GCC/Clang builds; tests
+        // compare them against the builtins). Same-type operands take the
+        // modular unsigned path, promoted to at least unsigned int so small
+        // types cannot overflow int; mixed operands take the WideInt path.
+        template<class T, class B>
+        constexpr bool portable_add_overflow(T a, B b, T *r) noexcept {
+            if constexpr (std::is_same_v<T, B>) {
+                using U = std::common_type_t<std::make_unsigned_t<T>, unsigned>;
+                *r = static_cast<T>(static_cast<U>(a) + static_cast<U>(b));
+                if constexpr (std::is_signed_v<T>) {
+                    return (a >= 0) == (b >= 0) && (*r >= 0) != (a >= 0);
+                } else {
+                    return *r < a;
+                }
+            } else {
+                WideInt w{};
+                const bool exact = wide_add(to_wide(a), to_wide(b), &w);
+                return wide_to(exact, w, r);
+            }
+        }
+
+        template<class T, class B>
+        constexpr bool portable_sub_overflow(T a, B b, T *r) noexcept {
+            if constexpr (std::is_same_v<T, B>) {
+                using U = std::common_type_t<std::make_unsigned_t<T>, unsigned>;
+                *r = static_cast<T>(static_cast<U>(a) - static_cast<U>(b));
+                if constexpr (std::is_signed_v<T>) {
+                    return (a >= 0) != (b >= 0) && (*r >= 0) != (a >= 0);
+                } else {
+                    return b > a;
+                }
+            } else {
+                WideInt nb = to_wide(b);
+                nb.neg = nb.mag != 0 && !nb.neg;
+                WideInt w{};
+                const bool exact = wide_add(to_wide(a), nb, &w);
+                return wide_to(exact, w, r);
+            }
+        }
+
+        template<class T, class B>
+        constexpr bool portable_mul_overflow(T a, B b, T *r) noexcept {
+            if constexpr (std::is_same_v<T, B>) {
+                using U = std::common_type_t<std::make_unsigned_t<T>, unsigned>;
+                *r = static_cast<T>(static_cast<U>(a) * static_cast<U>(b));
+                if (a == 0 || b == 0) {
+                    return false;
+                }
+                if constexpr (std::is_signed_v<T>) {
+                    if ((a == -1 && b == std::numeric_limits<T>::min()) ||
+                        (b == -1 && a == std::numeric_limits<T>::min())) {
+                        return true;
+                    }
+                }
+                return *r / b != a;
+            } else {
+                WideInt w{};
+                const bool exact = wide_mul(to_wide(a), to_wide(b), &w);
+                return wide_to(exact, w, r);
+            }
+        }
+
+        // True on overflow of the exact a (op) b in T; *r holds the wrapped
+        // result either way. The operands may differ in type and signedness.
+        // GCC/Clang lower these to add/sub/imul + jo/jc (or setcc), usable in constexpr.
+        template<class T, class B>
+        constexpr bool add_overflow(T a, B b, T *r) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_add_overflow(a, b, r);
+#else
+            return portable_add_overflow(a, b, r);
+#endif
+        }
+
+        template<class T, class B>
+        constexpr bool sub_overflow(T a, B b, T *r) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_sub_overflow(a, b, r);
+#else
+            return portable_sub_overflow(a, b, r);
+#endif
+        }
+
+        template<class T, class B>
+        constexpr bool mul_overflow(T a, B b, T *r) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_mul_overflow(a, b, r);
+#else
+            return portable_mul_overflow(a, b, r);
+#endif
+        }
+
+        // True if `v` does not survive the conversion to To (value or sign change).
+        template<class To, class From>
+        constexpr bool narrow_overflow(From v, To *r) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_add_overflow(v, From{0}, r);
+#else
+            *r = static_cast<To>(v);
+            return !std::in_range<To>(v);
+#endif
+        }
+
+        // Cold: size mismatch or the first overflowing lane, then dispatch.
+        template<class P, class T>
+        DODO_COLD DODO_NOINLINE
+        inline Status fail_mul_at(const T *a, const T *b, size_t n, FailureArg f, size_t *first_bad) noexcept {
+            size_t i = 0;
+            for (T r; i < n && !mul_overflow(a[i], b[i], &r); ++i) {
+            }
+            if (first_bad != nullptr) {
+                *first_bad = i;
+            }
+            if (i < n) {
+                return basic_fail_recoverable_with<P, PayloadKind::Mul>(f, nullptr, a[i], b[i]);
+            }
+            return basic_fail_recoverable<P>(f);
+        }
+    }
+
+    // 13) check_add / check_sub / check_mul / check_narrow (Recoverable):
+    // value in a Result<T>, Code::Overflow through fail_recoverable when the
+    // exact result does not fit. T is the first operand's type; the second may
+    // be any integer type and is not converted first, so a wider or
+    // differently signed operand is checked exactly (int32_t * int64_t).
+    // Usage: DODO_TRY_ASSIGN(const int64_t notional, DODO_CHECK_MUL(px, qty));
+    template<class P, class T, class B>
+    DODO_ALWAYS_INLINE
+    constexpr Result<T> basic_check_add(T a, B b, const Failure &f) noexcept {
+        static_assert(internal::is_checked_int_v<T> && internal::is_checked_int_v<B>, "check_add expects integer types");
+        T r;
+        if (DODO_LIKELY(!internal::add_overflow(a, b, &r))) {
+            return Result<T>::ok_result(r);
+        }
+        return Result<T>{T{}, basic_fail_recoverable_with<P, PayloadKind::Add>(f, nullptr, a, b).code};
+    }
+
+    template<class P, class T, class B>
+    DODO_ALWAYS_INLINE
+    constexpr Result<T> basic_check_sub(T a, B b, const Failure &f) noexcept {
+        static_assert(internal::is_checked_int_v<T> && internal::is_checked_int_v<B>, "check_sub expects integer types");
+        T r;
+        if (DODO_LIKELY(!internal::sub_overflow(a, b, &r))) {
+            return Result<T>::ok_result(r);
+        }
+        return Result<T>{T{}, basic_fail_recoverable_with<P, PayloadKind::Sub>(f, nullptr, a, b).code};
+    }
+
+    template<class P, class T, class B>
+    DODO_ALWAYS_INLINE
+    constexpr Result<T> basic_check_mul(T a, B b, const Failure &f) noexcept {
+        static_assert(internal::is_checked_int_v<T> && internal::is_checked_int_v<B>, "check_mul expects integer types");
+        T r;
+        if (DODO_LIKELY(!internal::mul_overflow(a, b, &r))) {
+            return Result<T>::ok_result(r);
+        }
+        return Result<T>{T{}, basic_fail_recoverable_with<P, PayloadKind::Mul>(f, nullptr, a, b).code};
+    }
+
+    template<class P, class To, class From>
+    DODO_ALWAYS_INLINE
+    constexpr Result<To> basic_check_narrow(From v, const Failure &f) noexcept {
+        static_assert(internal::is_checked_int_v<To> && internal::is_checked_int_v<From>,
+                      "check_narrow expects integer types");
+        To r;
+        if (DODO_LIKELY(!internal::narrow_overflow(v, &r))) {
+            return Result<To>::ok_result(r);
+        }
+        return Result<To>{To{}, basic_fail_recoverable_with<P, PayloadKind::Narrow>(f, nullptr, v).code};
+    }
+
+    template<class T, class B>
+    constexpr Result<T> check_add(T a, B b, const Failure &f) noexcept {
+        return basic_check_add<RuntimePolicy>(a, b, f);
+    }
+
+    template<class T, class B>
+    constexpr Result<T> check_sub(T a, B b, const Failure &f) noexcept {
+        return basic_check_sub<RuntimePolicy>(a, b, f);
+    }
+
+    template<class T, class B>
+    constexpr Result<T> check_mul(T a, B b, const Failure &f) noexcept {
+        return basic_check_mul<RuntimePolicy>(a, b, f);
+    }
+
+    template<class To, class From>
+    constexpr Result<To> check_narrow(From v, const Failure &f) noexcept {
+        return basic_check_narrow<RuntimePolicy, To>(v, f);
+    }
+
+    // 13b) check_mul_all (Recoverable): out[i] = a[i] * b[i] for whole spans,
+    // overflow flags ORed without branching (imul + seto + or per lane), one
+    // branch per span. `b` must match `a` in size and `out` must hold at least
+    // as many elements; otherwise, or on overflow, dispatches with *first_bad =
+    // first offending index. Every lane that fits all three spans is written.
+    template<class P, class R>
+    DODO_ALWAYS_INLINE
+    inline Status basic_check_mul_all(const R &a, const R &b, std::span<internal::span_value_t<R>> out,
+                                      const Failure &f, size_t *first_bad = nullptr) noexcept {
+        using T = internal::span_value_t<R>;
+        static_assert(internal::is_checked_int_v<T>, "check_mul_all expects an integer range");
+        const std::span va{a};
+        const std::span vb{b};
+        const size_t n = va.size() < vb.size() ? va.size() : vb.size();
+        const size_t m = n < out.size() ? n : out.size();
+        const T *pa = va.data();
+        const T *pb = vb.data();
+        T *po = out.data();
+        bool bad = false;
+        for (size_t i = 0; i < m; ++i) {
+            T r;
+            bad |= internal::mul_overflow(pa[i], pb[i], &r);
+            po[i] = r;
+        }
+        if (DODO_LIKELY(!bad & (va.size() == vb.size()) & (out.size() >= va.size()))) {
+            return Status::ok_status();
+        }
+        return internal::fail_mul_at<P>(pa, pb, m, f, first_bad);
+    }
+
+    template<class R>
+    inline Status check_mul_all(const R &a, const R &b, std::span<internal::span_value_t<R>> out,
+                                const Failure &f, size_t *first_bad = nullptr) noexcept {
+        return basic_check_mul_all<RuntimePolicy>(a, b, out, f, first_bad);
+    }
+
+    // --------------------------------------------------------------------------
+    // Flight Recorder (per-thread failure history, lock-free)
+    // --------------------------------------------------------------------------
+
+#ifndef DODO_FLIGHT_RECORDER_CAPACITY
+#define DODO_FLIGHT_RECORDER_CAPACITY 128 // records per thread, power of 2
+#endif
+#ifndef DODO_FLIGHT_RECORDER_THREADS
+#define DODO_FLIGHT_RECORDER_THREADS 32 // threads beyond this are counted, not recorded
+#endif
+
+    struct FlightRecord {
+        uint64_t tsc; // internal::read_tsc() at record time
+        Failure failure;
+        uint32_t thread; // internal::thread_index() of the writer
+        FailurePayload payload; // kind == None when the failure carried none
+    };
+
+    // One ring per thread. Writers are wait-free (owner-only head, a few relaxed
+    // stores); a single consumer reads each slot under a seqlock and discards
+    // torn or lapped entries instead of blocking the writer.
+    template<size_t Capacity = DODO_FLIGHT_RECORDER_CAPACITY, size_t MaxThreads = DODO_FLIGHT_RECORDER_THREADS>
+    class BasicFlightRecorder {
+        static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2");
+
+    public:
+        static constexpr size_t capacity = Capacity;
+        static constexpr size_t max_threads = MaxThreads;
+
+        constexpr BasicFlightRecorder() noexcept = default;
+
+        BasicFlightRecorder(const BasicFlightRecorder &) = delete;
+        BasicFlightRecorder &operator=(const BasicFlightRecorder &) = delete;
+
+        // Writer side (any thread, into its own ring).
+        void record(const Failure &f) noexcept {
+            const uint32_t t = internal::thread_index();
+            if (DODO_UNLIKELY(t >= MaxThreads)) {
+                untracked_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            Ring &r = rings_[t];
+            const uint64_t i = r.head.load(std::memory_order_relaxed);
+            Slot &s = r.slots[i & (Capacity - 1)];
+
+            // Fence-free seqlock: release payload stores keep the odd seq ahead of
+            // them, so a reader that sees any new word also sees the seq change.
+            // (Plain movs on x86; also keeps TSan happy, which rejects fences.)
+            const FailurePayload *p = payload_of(f);
+            s.seq.store(2 * i + 1, std::memory_order_relaxed);
+            s.tsc.store(internal::read_tsc(), std::memory_order_release);
+            s.site.store(internal::site_bits(f), std::memory_order_release);
+            s.meta.store(pack(f, p, t), std::memory_order_release);
+            if (p != nullptr) {
+                for (size_t k = 0; k < kMaxOperands; ++k) {
+                    s.operands[k].store(p->operands[k], std::memory_order_release);
+                }
+                s.context.store(p->context, std::memory_order_release);
+            }
+            s.seq.store(2 * i + 2, std::memory_order_release);
+
+            r.head.store(i + 1, std::memory_order_release);
+        }
+
+        // Consumer side (single thread). Calls fn(const FlightRecord&) for every
+        // entry written since the previous call; returns the number delivered.
+        template<class Fn>
+        size_t consume(Fn &&fn) noexcept {
+            size_t delivered = 0;
+            for (size_t t = 0; t < MaxThreads; ++t) {
+                Ring &r = rings_[t];
+                const uint64_t head = r.head.load(std::memory_order_acquire);
+                uint64_t from = cursor_[t];
+                if (head - from > Capacity) {
+                    lost_ += head - from - Capacity;
+                    from = head - Capacity;
+                }
+                for (uint64_t i = from; i < head; ++i) {
+                    FlightRecord rec;
+                    if (!read_slot(r, i, rec)) {
+                        ++lost_; // overwritten while we were reading
+                        continue;
+                    }
+                    fn(rec);
+                    ++delivered;
+                }
+                cursor_[t] = head;
+            }
+            return delivered;
+        }
+
+        // Calls fn(const FlightRecord&) for up to `max` of thread t's newest
+        // entries, newest first. Loads only: the consume() cursor is left alone,
+        // and a panic or signal handler may call it while a consumer runs.
+        // Entries torn by a concurrent writer are skipped.
+        template<class Fn>
+        size_t recent(uint32_t t, size_t max, Fn &&fn) const noexcept {
+            if (t >= MaxThreads) {
+                return 0;
+            }
+            const Ring &r = rings_[t];
+            const uint64_t head = r.head.load(std::memory_order_acquire);
+            const uint64_t n = head < Capacity ? head : Capacity;
+            size_t delivered = 0;
+            for (uint64_t k = 0; k < n && delivered < max; ++k) {
+                FlightRecord rec;
+                if (read_slot(r, head - 1 - k, rec)) {
+                    fn(rec);
+                    ++delivered;
+                }
+            }
+            return delivered;
+        }
+
+        // Entries overwritten before the consumer reached them (consumer-side).
+        uint64_t lost() const noexcept { return lost_; }
+
+        // Records dropped because the writer had no ring (thread index >= MaxThreads).
+        uint64_t untracked() const noexcept { return untracked_.load(std::memory_order_relaxed); }
+
+    private:
+        struct Slot {
+            std::atomic<uint64_t> seq{0}; // 2*i+1 while writing entry i, 2*i+2 once published
+            std::atomic<uint64_t> tsc{0};
+            std::atomic<uintptr_t> site{0}; // internal::site_bits()
+            std::atomic<uint64_t> meta{0}; // code | sev << 16 | payload shape << 20 | thread << 32
+            std::atomic<uint64_t> operands[kMaxOperands]{}; // written only for failures with a payload
+            std::atomic<const void *> context{nullptr};
+        };
+
+        struct alignas(DODO_CACHE_LINE) Ring {
+            std::atomic<uint64_t> head{0};
+            alignas(DODO_CACHE_LINE) Slot slots[Capacity];
+        };
+
+        // Payload shape in bits 20..31: kind (4) | count (2) | 3 x operand type (2).
+        static constexpr uint64_t pack(const Failure &f, const FailurePayload *p, uint32_t t) noexcept {
+            uint64_t shape = 0;
+            if (p != nullptr) {
+                shape = static_cast<uint64_t>(p->kind) | (static_cast<uint64_t>(p->count) << 4);
+                for (size_t k = 0; k < kMaxOperands; ++k) {
+                    shape |= static_cast<uint64_t>(k < p->count ? p->types[k] : OperandType::Unsigned) << (6 + 2 * k);
+                }
+            }
+            return static_cast<uint64_t>(f.code) |
+                   (static_cast<uint64_t>(f.sev) << 16) |
+                   (shape << 20) |
+                   (static_cast<uint64_t>(t) << 32);
+        }
+
+        // Seqlock read of entry i; false if it was overwritten while being read.
+        static bool read_slot(const Ring &r, uint64_t i, FlightRecord &out) noexcept {
+            const Slot &s = r.slots[i & (Capacity - 1)];
+            const uint64_t s1 = s.seq.load(std::memory_order_acquire);
+            const uint64_t tsc = s.tsc.load(std::memory_order_acquire);
+            const uintptr_t site = s.site.load(std::memory_order_acquire);
+            const uint64_t meta = s.meta.load(std::memory_order_acquire);
+            out = unpack(tsc, site, meta);
+            if (out.payload.kind != PayloadKind::None) {
+                for (size_t k = 0; k < kMaxOperands; ++k) {
+                    out.payload.operands[k] = s.operands[k].load(std::memory_order_acquire);
+                }
+                out.payload.context = s.context.load(std::memory_order_acquire);
+            }
+            const uint64_t s2 = s.seq.load(std::memory_order_relaxed);
+            return s1 == 2 * i + 2 && s2 == s1;
+        }
+
+        static FlightRecord unpack(uint64_t tsc, uintptr_t site, uint64_t meta) noexcept {
+            const uint64_t shape = (meta >> 20) & 0xFFFu;
+            FailurePayload p{static_cast<PayloadKind>(shape & 0xFu), static_cast<uint8_t>((shape >> 4) & 0x3u), {}, {}, nullptr};
+            for (size_t k = 0; k < kMaxOperands; ++k) {
+                p.types[k] = static_cast<OperandType>((shape >> (6 + 2 * k)) & 0x3u);
+            }
+            return FlightRecord{
+                tsc,
+                internal::make_failure(static_cast<Code>(meta & 0xFFFFu), static_cast<Severity>((meta >> 16) & 0xFu), site),
+                static_cast<uint32_t>(meta >> 32),
+                p
+            };
+        }
+
+        Ring rings_[MaxThreads];
+        std::atomic<uint64_t> untracked_{0};
+        uint64_t cursor_[MaxThreads]{};
+        uint64_t lost_{0};
+    };
+
+    using FlightRecorder = BasicFlightRecorder<>;
+
+    // Process-wide recorder used by the ready-made handlers below.
+    // Constant-initialized (.bss), no guard on access.
+    inline FlightRecorder &flight_recorder() noexcept {
+        static constinit FlightRecorder recorder;
+        return recorder;
+    }
+
+    namespace internal {
+        inline std::atomic<PanicFn> g_flight_prev_panic{default_panic};
+        inline std::atomic<FallbackFn> g_flight_prev_fallback{default_fallback};
+    }
+
+    // Record into flight_recorder(), then forward to the handler that was active
+    // when install_flight_recorder() ran.
+    inline void flight_recorder_panic(const Failure &f) noexcept {
+        flight_recorder().record(f);
+        internal::g_flight_prev_panic.load(std::memory_order_acquire)(f);
+    }
+
+    inline Status flight_recorder_fallback(const Failure &f) noexcept {
+        flight_recorder().record(f);
+        return internal::g_flight_prev_fallback.load(std::memory_order_acquire)(f);
+    }
+
+    // Chains the recording handlers in front of the current ones (idempotent).
+    // Safe against concurrent failures; do not race two installs.
+    inline void install_flight_recorder() noexcept {
+        const PanicFn panic = get_panic_handler();
+        if (panic != flight_recorder_panic) {
+            internal::g_flight_prev_panic.store(panic, std::memory_order_release);
+            set_panic_handler(flight_recorder_panic);
+        }
+        const FallbackFn fallback = get_fallback_handler();
+        if (fallback != flight_recorder_fallback) {
+            internal::g_flight_prev_fallback.store(fallback, std::memory_order_release);
+            set_fallback_handler(flight_recorder_fallback);
+        }
+    }
+
+    // --------------------------------------------------------------------------
+    // Crash Record (fatal failure + recent history into a pre-mapped region)
+    // --------------------------------------------------------------------------
+
+    // Fixed, versioned layout for a region shared with a watchdog process (e.g.
+    // a MAP_SHARED mapping of a /dev/shm file). The panic handler only stores
+    // into memory that install_crash_record() already touched: no syscalls, no
+    // locks, no allocation, so it is also safe from a signal handler. Readers
+    // treat the record as valid once state is Complete (acquire); the entries
+    // are written in order and count is bumped after each one, so a process
+    // that dies mid-write leaves a readable prefix in state Writing.
+    inline constexpr uint32_t kCrashMagic = 0x43444F44u; // "DODC" in little-endian memory
+    inline constexpr uint16_t kCrashVersion = 1;
+
+    enum class CrashState : uint32_t { Empty = 0, Writing = 1, Complete = 2 };
+
+    struct CrashHeader {
+        uint32_t magic; // kCrashMagic
+        uint16_t version; // kCrashVersion
+        uint16_t header_bytes; // sizeof(CrashHeader): entries start here
+        uint16_t entry_bytes; // sizeof(CrashEntry)
+        uint16_t capacity; // entries that fit the region
+        std::atomic<uint32_t> state; // CrashState
+        std::atomic<uint32_t> count; // entries written so far
+        std::atomic<uint32_t> later; // fatal failures after the record was taken
+        uint32_t thread; // internal::thread_index() of the failing thread, UINT32_MAX if none
+        uint32_t reserved0;
+        uint64_t tag; // caller's value from install (e.g. the pid)
+        uint64_t crash_tsc; // internal::read_tsc() when the panic started
+        uint64_t install_tsc; // counter and wall clock sampled together at install,
+        uint64_t install_wall_ns; // so a reader can date crash_tsc (system_clock, ns)
+        uint64_t tsc_per_ns_q32; // TscClock::ticks_per_ns_q32() at install
+        uint8_t reserved[56];
+    };
+
+    // One failure. Strings are copied (truncated, NUL-terminated) because the
+    // reader cannot follow pointers into the crashed process; the file keeps
+    // its tail. Empty strings under DODO_FAST_MODE / DODO_COMPACT_MODE, where
+    // `site` is the compact site ID for tools/dodo_sitemap.
+    struct CrashEntry {
+        uint64_t tsc;
+        uint64_t site; // Site address in the crashed process, or compact site ID
+        uint64_t operands[kMaxOperands];
+        uint64_t context;
+        uint32_t thread;
+        uint32_t line;
+        uint16_t code;
+        uint8_t sev;
+        uint8_t kind; // PayloadKind; None when the failure carried no payload
+        uint8_t count;
+        uint8_t types[kMaxOperands]; // OperandType
+        char expr[80];
+        char file[56];
+        char func[56];
+    };
+
+    static_assert(sizeof(CrashHeader) == 128 && sizeof(CrashEntry) == 256, "crash record layout is versioned");
+    static_assert(std::is_standard_layout_v<CrashHeader> && std::is_trivially_copyable_v<CrashEntry>);
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "crash record state must be lock-free across processes");
+
+    // Region size for `entries` entries (the fatal one plus history).
+    constexpr size_t crash_record_bytes(size_t entries) noexcept {
+        return sizeof(CrashHeader) + entries * sizeof(CrashEntry);
+    }
+
+    inline const CrashEntry *crash_entries(const CrashHeader &h) noexcept {
+        return reinterpret_cast<const CrashEntry *>(reinterpret_cast<const unsigned char *>(&h) + h.header_bytes);
+    }
+
+    inline CrashEntry *crash_entries(CrashHeader &h) noexcept {
+        return reinterpret_cast<CrashEntry *>(reinterpret_cast<unsigned char *>(&h) + h.header_bytes);
+    }
+
+    namespace internal {
+        inline std::atomic<CrashHeader *> g_crash_header{nullptr};
+        inline std::atomic<PanicFn> g_crash_prev_panic{default_panic};
+
+        // Bounded byte copy, no strlen/memcpy calls. Both are async-signal-safe,
+        // but the crash path runs after something already went wrong: a plain
+        // loop keeps it out of libc and out of sanitizer interceptors, which can
+        // report or abort on the very state being recorded.
+        inline void copy_crash_text(char *dst, size_t cap, const char *src, bool keep_tail) noexcept {
+            size_t n = 0;
+            if (src != nullptr) {
+                while (src[n] != '\0') {
+                    ++n;
+                }
+                if (keep_tail && n >= cap) {
+                    src += n - (cap - 1);
+                }
+            }
+            n = n < cap - 1 ? n : cap - 1;
+            for (size_t i = 0; i < n; ++i) {
+                dst[i] = src[i];
+            }
+            dst[n] = '\0';
+        }
+
+        inline void fill_crash_entry(CrashEntry &e, const Failure &f, const FailurePayload *p, uint64_t tsc,
+                                     uint32_t thread) noexcept {
+            e.tsc = tsc;
+            e.site = site_bits(f);
+            e.thread = thread;
+            e.code = static_cast<uint16_t>(f.code);
+            e.sev = static_cast<uint8_t>(f.sev);
+            const FailurePayload none{};
+            const FailurePayload &q = p != nullptr ? *p : none;
+            e.kind = static_cast<uint8_t>(q.kind);
+            e.count = q.count;
+            for (size_t k = 0; k < kMaxOperands; ++k) {
+                e.operands[k] = q.operands[k];
+                e.types[k] = static_cast<uint8_t>(q.types[k]);
+            }
+            e.context = reinterpret_cast<uintptr_t>(q.context);
+#ifndef DODO_COMPACT_MODE
+            const Site *s = f.site;
+            e.line = s != nullptr ? s->line : 0;
+            copy_crash_text(e.expr, sizeof(e.expr), s != nullptr ? s->expr : nullptr, false);
+            copy_crash_text(e.file, sizeof(e.file), s != nullptr ? s->file : nullptr, true);
+            copy_crash_text(e.func, sizeof(e.func), s != nullptr ? s->func : nullptr, false);
+#else
+            e.line = 0;
+            e.expr[0] = e.file[0] = e.func[0] = '\0';
+#endif
+        }
+
+        // First fatal failure wins; later ones (other threads, or a panic handler
+        // that fails again) only bump `later`.
+        inline void write_crash_record(CrashHeader &h, const Failure &f) noexcept {
+            uint32_t expected = static_cast<uint32_t>(CrashState::Empty);
+            if (!h.state.compare_exchange_strong(expected, static_cast<uint32_t>(CrashState::Writing),
+                                                 std::memory_order_acquire, std::memory_order_relaxed)) {
+                h.later.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            const uint64_t tsc = read_tsc();
+            const uint32_t thread = peek_thread_index();
+            h.crash_tsc = tsc;
+            h.thread = thread;
+            CrashEntry *e = crash_entries(h);
+            const uint32_t cap = h.capacity;
+            fill_crash_entry(e[0], f, payload_of(f), tsc, thread);
+            uint32_t n = 1;
+            h.count.store(n, std::memory_order_release);
+
+            // Newest first. Skip the fatal failure itself when a chained
+            // flight_recorder_panic already logged it.
+            bool first = true;
+            flight_recorder().recent(thread, cap, [&](const FlightRecord &r) {
+                const bool same = first && r.failure.sev == f.sev && r.failure.code == f.code &&
+                                  site_bits(r.failure) == site_bits(f);
+                first = false;
+                if (same || n >= cap) {
+                    return;
+                }
+                fill_crash_entry(e[n], r.failure, r.payload.kind != PayloadKind::None ? &r.payload : nullptr, r.tsc,
+                                 r.thread);
+                h.count.store(++n, std::memory_order_release);
+            });
+            h.state.store(static_cast<uint32_t>(CrashState::Complete), std::memory_order_release);
+        }
+    }
+
+    // Write the crash record into the installed region, then forward to the
+    // panic handler that was active when install_crash_record() ran.
+    inline void crash_record_panic(const Failure &f) noexcept {
+        CrashHeader *h = internal::g_crash_header.load(std::memory_order_acquire);
+        if (h != nullptr) {
+            internal::write_crash_record(*h, f);
+        }
+        internal::g_crash_prev_panic.load(std::memory_order_acquire)(f);
+    }
+
+    // Formats `region` (8-byte aligned, at least crash_record_bytes(1)) as an
+    // empty crash record and chains crash_record_panic in front of the current
+    // panic handler (idempotent; calling it again re-arms with a new region).
+    // Zeroes the whole region so the panic path never takes a page fault, and
+    // calibrates the TSC (~2 ms on x86 the first time). Returns false, leaving
+    // everything unchanged, when the region is too small or misaligned.
+    // Do not race two installs.
+    inline bool install_crash_record(void *region, size_t bytes, uint64_t tag = 0) noexcept {
+        if (region == nullptr || reinterpret_cast<uintptr_t>(region) % alignof(CrashHeader) != 0 ||
+            bytes < crash_record_bytes(1)) {
+            return false;
+        }
+        const size_t fit = (bytes - sizeof(CrashHeader)) / sizeof(CrashEntry);
+        internal::g_crash_header.store(nullptr, std::memory_order_release);
+        unsigned char *raw = static_cast<unsigned char *>(region);
+        for (size_t i = 0; i < bytes; ++i) {
+            raw[i] = 0;
+        }
+        CrashHeader *h = ::new (region) CrashHeader{};
+        h->magic = kCrashMagic;
+        h->version = kCrashVersion;
+        h->header_bytes = sizeof(CrashHeader);
+        h->entry_bytes = sizeof(CrashEntry);
+        h->capacity = static_cast<uint16_t>(fit < UINT16_MAX ? fit : UINT16_MAX);
+        h->tag = tag;
+        h->tsc_per_ns_q32 = TscClock::ticks_per_ns_q32();
+        h->install_tsc = internal::read_tsc();
+        h->install_wall_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        h->state.store(static_cast<uint32_t>(CrashState::Empty), std::memory_order_release);
+        internal::g_crash_header.store(h, std::memory_order_release);
+
+        const PanicFn panic = get_panic_handler();
+        if (panic != crash_record_panic) {
+            internal::g_crash_prev_panic.store(panic, std::memory_order_release);
+            set_panic_handler(crash_record_panic);
+        }
+        return true;
+    }
+
+    // --------------------------------------------------------------------------
+    // Failure Statistics (per-thread padded counters, aggregated by the reader)
+    // --------------------------------------------------------------------------
+
+#ifndef DODO_STATS_CODES
+#define DODO_STATS_CODES 16 // counter slots per domain; values at or beyond the last slot share it
+#endif
+#ifndef DODO_STATS_DOMAINS
+#define DODO_STATS_DOMAINS 4 // domains with their own slots; higher domain ids share the last band
+#endif
+#ifndef DODO_STATS_THREADS
+#define DODO_STATS_THREADS 64 // threads beyond this share one contended row
+#endif
+
+    namespace internal {
+        // Maps a Code to one of Domains x Values slots: one band of Values slots
+        // per domain id. The last band collects higher domain ids and the last
+        // slot of a band collects higher values.
+        template<size_t Domains, size_t Values>
+        constexpr size_t code_slot(Code c) noexcept {
+            const size_t d = code_domain(c);
+            const size_t v = code_value(c);
+            return (d < Domains ? d : Domains - 1) * Values + (v < Values ? v : Values - 1);
+        }
+
+        // The lowest Code counted by slot k (inverse of code_slot for in-range codes).
+        template<size_t Values>
+        constexpr Code slot_code(size_t k) noexcept {
+            return make_code(static_cast<uint16_t>(k / Values), static_cast<uint16_t>(k % Values));
+        }
+
+        // Slots x Threads counter matrix. Each thread owns one cache-line-aligned
+        // row (by thread_index()) and bumps it with a relaxed load+store: no lock
+        // prefix and no line shared with another writer. Threads past `Threads`
+        // share an overflow row updated with fetch_add. Readers sum the rows;
+        // totals are relaxed snapshots, exact once the writers have finished.
+        template<size_t Slots, size_t Threads>
+        class PerThreadCounters {
+        public:
+            void add(size_t k, uint64_t n = 1) noexcept {
+                const uint32_t t = thread_index();
+                if (DODO_LIKELY(t < Threads)) {
+                    std::atomic<uint64_t> &c = rows_[t].v[k];
+                    c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+                } else {
+                    overflow_.v[k].fetch_add(n, std::memory_order_relaxed);
+                }
+            }
+
+            uint64_t sum(size_t k) const noexcept {
+                uint64_t n = overflow_.v[k].load(std::memory_order_relaxed);
+                for (const Row &row : rows_) {
+                    n += row.v[k].load(std::memory_order_relaxed);
+                }
+                return n;
+            }
+
+        private:
+            struct alignas(DODO_CACHE_LINE) Row {
+                std::atomic<uint64_t> v[Slots]{};
+            };
+
+            Row rows_[Threads]{};
+            Row overflow_{};
+        };
+    }
+
+    // Failure counts per Code without a shared cache line: writers touch only
+    // their own row, readers aggregate lazily. Each of the first DODO_STATS_DOMAINS
+    // domains has DODO_STATS_CODES slots; codes past either bound share the last
+    // slot of their band (or of the last band).
+    class Stats {
+    public:
+        static constexpr size_t kDomains = DODO_STATS_DOMAINS;
+        static constexpr size_t kCodes = DODO_STATS_CODES; // per domain
+        static constexpr size_t kSlots = kDomains * kCodes;
+
+        void add(Code c) noexcept { counters_.add(internal::code_slot<kDomains, kCodes>(c)); }
+
+        uint64_t count(Code c) const noexcept { return counters_.sum(internal::code_slot<kDomains, kCodes>(c)); }
+
+        uint64_t total() const noexcept {
+            uint64_t n = 0;
+            for (size_t k = 0; k < kSlots; ++k) {
+                n += counters_.sum(k);
+            }
+            return n;
+        }
+
+        // Calls fn(Code, count) for every slot with a non-zero count; a shared
+        // slot is reported under its lowest code.
+        template<class F>
+        void for_each(F &&fn) const noexcept {
+            for (size_t k = 0; k < kSlots; ++k) {
+                const uint64_t n = counters_.sum(k);
+                if (n != 0) {
+                    fn(internal::slot_code<kCodes>(k), n);
+                }
+            }
+        }
+
+    private:
+        internal::PerThreadCounters<kSlots, DODO_STATS_THREADS> counters_;
+    };
+
+    // Process-wide counters used by stats_fallback. Constant-initialized (.bss).
+    inline Stats &stats() noexcept {
+        static constinit Stats s;
+        return s;
+    }
+
+    // Fallback handler that only counts: Dodo::set_fallback_handler(Dodo::stats_fallback)
+    // or Dodo::Policy<my_panic, Dodo::stats_fallback>. Handlers that do more can call
+    // Dodo::stats().add(f.code) themselves.
+    inline Status stats_fallback(const Failure &f) noexcept {
+        stats().add(f.code);
+        return Status::fail(f.code);
+    }
+
+    // --------------------------------------------------------------------------
+    // Failure Sampling (rate-limits the fallback handler during failure storms)
+    // --------------------------------------------------------------------------
+
+#ifndef DODO_SAMPLER_CODES
+#define DODO_SAMPLER_CODES 16 // rule slots per domain; values at or beyond the last slot share it
+#endif
+#ifndef DODO_SAMPLER_DOMAINS
+#define DODO_SAMPLER_DOMAINS 4 // domains with their own rule slots; higher ids share the last band
+#endif
+#ifndef DODO_SAMPLER_THREADS
+#define DODO_SAMPLER_THREADS 32 // threads beyond this share one contended counter
+#endif
+
+    // Per-Code admission rule. A failure reaches the full handler if a token is
+    // available (bucket of `burst` tokens, one refilled every `refill_ticks` TSC
+    // ticks) or, once the bucket is empty, if it is the N-th (`one_in`) failure
+    // since the last sampled one. Everything else still returns
+    // Status::fail(code) and only bumps a counter.
+    struct SampleRule {
+        uint32_t burst = 0; // 0 = no bucket
+        uint32_t one_in = 1; // 1 = admit all, 0 = admit none beyond the bucket
+        uint64_t refill_ticks = 0; // 0 = bucket never refills
+    };
+
+    namespace internal {
+        inline constexpr size_t kSamplerDomains = DODO_SAMPLER_DOMAINS;
+        inline constexpr size_t kSamplerCodes = DODO_SAMPLER_CODES; // per domain
+        inline constexpr size_t kSamplerSlots = kSamplerDomains * kSamplerCodes;
+
+        constexpr size_t sampler_slot(Code c) noexcept { return code_slot<kSamplerDomains, kSamplerCodes>(c); }
+
+        // Fields are independent relaxed atomics: reconfigure at init; a change
+        // racing a storm may briefly mix old and new fields, never tear one.
+        struct SamplerRuleSlot {
+            std::atomic<uint32_t> burst{0};
+            std::atomic<uint32_t> one_in{1};
+            std::atomic<uint64_t> refill_ticks{0};
+        };
+
+        inline constinit SamplerRuleSlot g_sampler_rules[kSamplerSlots]{};
+
+        // Thread-local bucket per code; zero-initialized TLS, no guard.
+        struct SamplerThreadState {
+            uint64_t last = 0; // TSC of the last refill, 0 = bucket not primed yet
+            uint32_t tokens = 0;
+            uint32_t countdown = 0; // failures left until the next 1-in-N admit
+        };
+
+        inline thread_local SamplerThreadState t_sampler[kSamplerSlots]{};
+
+        inline constinit PerThreadCounters<kSamplerSlots, DODO_SAMPLER_THREADS> g_sampler_suppressed{};
+
+        // Cold path only. True if this failure should reach the full handler.
+        inline bool sampler_admit(Code c) noexcept {
+            const size_t k = sampler_slot(c);
+            const SamplerRuleSlot &r = g_sampler_rules[k];
+            const uint32_t burst = r.burst.load(std::memory_order_relaxed);
+            const uint32_t one_in = r.one_in.load(std::memory_order_relaxed);
+            if (DODO_LIKELY(burst == 0 && one_in == 1)) {
+                return true; // unlimited (default)
+            }
+            SamplerThreadState &t = t_sampler[k];
+            if (burst != 0) {
+                const uint64_t now = read_tsc() | 1u; // never 0: 0 marks "not primed"
+                const uint64_t period = r.refill_ticks.load(std::memory_order_relaxed);
+                if (t.last == 0) {
+                    t.tokens = burst;
+                    t.last = now;
+                }
+                if (t.tokens > burst) {
+                    t.tokens = burst; // rule shrank
+                }
+                if (period != 0 && now - t.last >= period) {
+                    const uint64_t add = (now - t.last) / period;
+                    t.tokens = add >= burst - t.tokens ? burst : t.tokens + static_cast<uint32_t>(add);
+                    t.last += add * period;
+                }
+                if (t.tokens != 0) {
+                    --t.tokens;
+                    return true;
+                }
+            }
+            if (one_in != 0) {
+                if (t.countdown == 0 || t.countdown > one_in) {
+                    t.countdown = one_in;
+                }
+                if (--t.countdown == 0) {
+                    return true;
+                }
+            }
+            g_sampler_suppressed.add(k);
+            return false;
+        }
+
+        inline std::atomic<FallbackFn> g_sampler_next{default_fallback};
+    }
+
+    inline void set_sample_rule(Code c, SampleRule rule) noexcept {
+        internal::SamplerRuleSlot &r = internal::g_sampler_rules[internal::sampler_slot(c)];
+        r.burst.store(rule.burst, std::memory_order_relaxed);
+        r.one_in.store(rule.one_in, std::memory_order_relaxed);
+        r.refill_ticks.store(rule.refill_ticks, std::memory_order_relaxed);
+    }
+
+    inline SampleRule get_sample_rule(Code c) noexcept {
+        const internal::SamplerRuleSlot &r = internal::g_sampler_rules[internal::sampler_slot(c)];
+        return SampleRule{r.burst.load(std::memory_order_relaxed), r.one_in.load(std::memory_order_relaxed),
+                          r.refill_ticks.load(std::memory_order_relaxed)};
+    }
+
+    // Failures of `c` that skipped the full handler, summed over all threads.
+    inline uint64_t suppressed_count(Code c) noexcept {
+        return internal::g_sampler_suppressed.sum(internal::sampler_slot(c));
+    }
+
+    // Policy form: Inner's fallback only for admitted failures (panic untouched).
+    // Usage: using FeedPolicy = Dodo::SampledPolicy<Dodo::Policy<my_panic, my_fallback>>;
+    template<class Inner = RuntimePolicy>
+    struct SampledPolicy {
+        static void panic(const Failure &f) noexcept { Inner::panic(f); }
+
+        static Status fallback(const Failure &f) noexcept {
+            if (internal::sampler_admit(f.code)) {
+                return Inner::fallback(f);
+            }
+            return Status::fail(f.code);
+        }
+    };
+
+    // Runtime-hook form: forwards admitted failures to the handler that was
+    // active when install_fallback_sampler() ran.
+    inline Status sampled_fallback(const Failure &f) noexcept {
+        if (internal::sampler_admit(f.code)) {
+            return internal::g_sampler_next.load(std::memory_order_acquire)(f);
+        }
+        return Status::fail(f.code);
+    }
+
+    // Chains sampled_fallback in front of the current fallback handler
+    // (idempotent). Handlers installed later (e.g. the flight recorder) sit in
+    // front of it and still see every failure.
+    inline void install_fallback_sampler() noexcept {
+        const FallbackFn fallback = get_fallback_handler();
+        if (fallback != sampled_fallback) {
+            internal::g_sampler_next.store(fallback, std::memory_order_release);
+            set_fallback_handler(sampled_fallback);
+        }
+    }
+
+    // --------------------------------------------------------------------------
+    // Circuit Breaker (stop calling a failing dependency)
+    // --------------------------------------------------------------------------
+
+    // Fed with the Status of each guarded call. `threshold` failures within
+    // `window_ticks` TSC ticks trip it open; for `cooldown_ticks` every allow()
+    // then short-circuits with `open_code` without touching the handlers. After
+    // the cooldown one caller is let through as a probe (HalfOpen): its success
+    // closes the breaker, its failure re-opens it. A probe that never records
+    // (its caller returned between allow() and record()) is replaced by a new
+    // one after another cooldown_ticks, so the breaker cannot stay HalfOpen;
+    // with cooldown_ticks = 0 every HalfOpen caller is a probe. record() carries
+    // no identity: while HalfOpen, the first record() decides, even one from a
+    // straggler admitted before the trip.
+    //
+    // Closed state costs one relaxed load and a predicted branch in allow() and
+    // record(), the same as a DODO_REQUIRE that holds. Counting is approximate
+    // under concurrent failures (a window reset may drop a racing increment).
+    //
+    // Usage:
+    //   static constinit Dodo::CircuitBreaker venue_cb{{.threshold = 8, .window_ticks = 3'000'000,
+    //                                                    .cooldown_ticks = 300'000'000}};
+    //   DODO_TRY(venue_cb.allow());
+    //   DODO_TRY(venue_cb.record(send(order)));
+    class alignas(DODO_CACHE_LINE) CircuitBreaker {
+    public:
+        enum class State : uint8_t { Closed, Open, HalfOpen };
+
+        struct Config {
+            uint32_t threshold = 5; // failures within the window that trip it (0 acts as 1)
+            uint64_t window_ticks = 0; // 0 = one window forever (count never decays)
+            uint64_t cooldown_ticks = 0; // Open -> HalfOpen after this long
+            Code open_code = Code::ExternalFault; // returned while open
+        };
+
+        constexpr explicit CircuitBreaker(Config cfg) noexcept : cfg_{cfg} {}
+
+        CircuitBreaker(const CircuitBreaker &) = delete;
+        CircuitBreaker &operator=(const CircuitBreaker &) = delete;
+
+        // Ok if the guarded call may proceed, otherwise Status::fail(open_code).
+        DODO_ALWAYS_INLINE Status allow() noexcept {
+            if (DODO_LIKELY(state_.load(std::memory_order_relaxed) == State::Closed)) {
+                return Status::ok_status();
+            }
+            return allow_slow();
+        }
+
+        // Feeds the outcome of a guarded call; returns `s` unchanged so it can
+        // sit inside DODO_TRY / fallback_or.
+        DODO_ALWAYS_INLINE Status record(Status s) noexcept {
+            if (DODO_LIKELY(s.ok() & (state_.load(std::memory_order_relaxed) == State::Closed))) {
+                return s;
+            }
+            record_slow(s);
+            return s;
+        }
+
+        // allow() + f() + record() in one call. `f` returns Status (or Result<T>).
+        template<class F>
+        Status call(F &&f) noexcept {
+            const Status a = allow();
+            if (DODO_UNLIKELY(!a.ok())) {
+                return a;
+            }
+            return record(static_cast<Status>(f()));
+        }
+
+        State state() const noexcept { return state_.load(std::memory_order_acquire); }
+
+        // Failures counted in the current window.
+        uint32_t failures() const noexcept { return failures_.load(std::memory_order_relaxed); }
+
+        const Config &config() const noexcept { return cfg_; }
+
+        // Back to Closed with an empty window (e.g. operator override).
+        void reset() noexcept {
+            failures_.store(0, std::memory_order_relaxed);
+            window_start_.store(internal::read_tsc(), std::memory_order_relaxed);
+            state_.store(State::Closed, std::memory_order_release);
+        }
+
+    private:
+        // opened_at_ is the trip time while Open and the probe time while
+        // HalfOpen; whoever moves it to `now` owns the next probe.
+        DODO_COLD DODO_NOINLINE Status allow_slow() noexcept {
+            State st = state_.load(std::memory_order_acquire);
+            if (st == State::Closed) {
+                return Status::ok_status();
+            }
+            const uint64_t now = internal::read_tsc();
+            uint64_t since = opened_at_.load(std::memory_order_relaxed);
+            if (now - since < cfg_.cooldown_ticks ||
+                !opened_at_.compare_exchange_strong(since, now, std::memory_order_relaxed)) {
+                return Status::fail(cfg_.open_code);
+            }
+            if (st == State::Open) {
+                (void) state_.compare_exchange_strong(st, State::HalfOpen, std::memory_order_acq_rel);
+            }
+            return Status::ok_status(); // this caller is the probe
+        }
+
+        DODO_COLD DODO_NOINLINE void record_slow(Status s) noexcept {
+            const uint64_t now = internal::read_tsc();
+            State st = state_.load(std::memory_order_acquire);
+            if (st == State::HalfOpen) {
+                if (s.ok()) {
+                    failures_.store(0, std::memory_order_relaxed);
+                    window_start_.store(now, std::memory_order_relaxed);
+                    state_.store(State::Closed, std::memory_order_release);
+                } else {
+                    trip(st, now);
+                }
+                return;
+            }
+            if (st != State::Closed || s.ok()) {
+                return; // stragglers admitted before the trip
+            }
+            uint64_t start = window_start_.load(std::memory_order_relaxed);
+            if (cfg_.window_ticks != 0 && now - start >= cfg_.window_ticks &&
+                window_start_.compare_exchange_strong(start, now, std::memory_order_relaxed)) {
+                failures_.store(0, std::memory_order_relaxed);
+            }
+            if (failures_.fetch_add(1, std::memory_order_relaxed) + 1 >= cfg_.threshold) {
+                trip(st, now);
+            }
+        }
+
+        void trip(State from, uint64_t now) noexcept {
+            opened_at_.store(now, std::memory_order_relaxed);
+            if (state_.compare_exchange_strong(from, State::Open, std::memory_order_acq_rel)) {
+                failures_.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        std::atomic<State> state_{State::Closed};
+        std::atomic<uint32_t> failures_{0};
+        std::atomic<uint64_t> window_start_{0};
+        std::atomic<uint64_t> opened_at_{0};
+        Config cfg_;
+    };
+
+#if DODO_HAS_COROUTINES
+    // --------------------------------------------------------------------------
+    // Coroutine Support (Status / Result<T> across co_await, no allocation)
+    // --------------------------------------------------------------------------
+
+    // Promise mixin for coroutines completing with R = Status or Result<T>.
+    // Derive the task's promise_type from it: it supplies return_value (a
+    // failed Status converts into Result<T>), the result slot inside the frame and
+    // unhandled_exception (traps: there are no exceptions). The task keeps its
+    // own get_return_object, initial_suspend, final_suspend and frame
+    // allocation; its final awaiter should resume `continuation`.
+    template<class R>
+    struct CoPromise {
+        R result{};
+        std::coroutine_handle<> continuation{}; // awaiting coroutine, set by the task's awaiter
+        bool short_circuited = false; // co_check() left at a failure instead of co_return
+
+        void return_value(R r) noexcept { result = r; }
+
+        void unhandled_exception() noexcept { DODO_TRAP(); }
+
+        // Where co_check() hands control after storing a failure: the awaiting
+        // coroutine, or back to whoever resumed this one.
+        std::coroutine_handle<> exit_to() noexcept {
+            return continuation ? continuation : std::coroutine_handle<>{std::noop_coroutine()};
+        }
+    };
+
+    using StatusPromise = CoPromise<Status>;
+
+    template<class T>
+    using ResultPromise = CoPromise<Result<T>>;
+
+    // co_await co_check(x): the value of a Result<T> (nothing for a Status) when
+    // it holds Ok; otherwise its Code becomes the coroutine's result and control
+    // goes to promise.exit_to(), as if the coroutine had reached a suspending
+    // final_suspend. The frame stays suspended at that point until the task
+    // destroys it (check short_circuited, not done()). The success path is
+    // await_ready() and never suspends, but the awaiter holds a copy of `x`
+    // in the frame; the DODO_CO_TRY macros avoid that and are the default
+    // choice. Use co_check where a statement does not fit (inside an
+    // expression). The promise must derive from CoPromise.
+    template<class R>
+    struct [[nodiscard]] CheckAwaiter {
+        R r;
+
+        constexpr bool await_ready() const noexcept { return DODO_LIKELY(r.ok()); }
+
+        template<class P>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) const noexcept {
+            P &p = h.promise();
+            p.return_value(propagate(Status{r.code}));
+            p.short_circuited = true;
+            return p.exit_to();
+        }
+
+        constexpr decltype(auto) await_resume() const noexcept {
+            if constexpr (std::is_same_v<R, Status>) {
+                return;
+            } else {
+                return r.value;
+            }
+        }
+    };
+
+    constexpr CheckAwaiter<Status> co_check(Status s) noexcept {
+        return {s};
+    }
+
+    template<class T>
+    constexpr CheckAwaiter<Result<T>> co_check(Result<T> r) noexcept {
+        return {r};
+    }
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// Macros (Context Capture & Convenience)
+// ----------------------------------------------------------------------------
+
+// Per-site descriptor: DODO_SITE(expr, file, line, func) yields a `const Dodo::Site*`
+// to a static local of a per-expansion lambda. The static sits outside the
+// enclosing function body, so checks stay usable in constexpr functions and in
+// namespace-scope initializers; during constant evaluation the site is nullptr.
+// The caller's function name reaches the static as a template argument
+// (internal::SiteFunc), evaluated where the check is written. GCC/Clang supply
+// it through __builtin_FUNCTION(), which is "" at namespace scope; other
+// compilers go without it (func is then nullptr).
+#if defined(__GNUC__) || defined(__clang__)
+#define DODO_SITE_FUNC __builtin_FUNCTION()
+#else
+#define DODO_SITE_FUNC nullptr
+#endif
+#define DODO_SITE(expr_str, file_str, line_no, func_str) \
+        (std::is_constant_evaluated() ? static_cast<const Dodo::Site *>(nullptr) \
+            : []<Dodo::internal::SiteFunc _dodo_func>() noexcept -> const Dodo::Site * { \
+                  static constinit Dodo::Site _dodo_site{(expr_str), (file_str), (line_no), _dodo_func.get()}; \
+                  return &_dodo_site; \
+              }.template operator()<Dodo::internal::SiteFunc<Dodo::internal::site_func_size(func_str)>{func_str}>())
+
+// Optimization parm: DODO_FAST_MODE
+// If defined, strips string literals from binary to reduce rodata size.
+// DODO_COMPACT_MODE also strips them but keeps a 32-bit site ID per check.
+#if defined(DODO_COMPACT_MODE)
+#define DODO_SITE_ID(expr_str) Dodo::internal::site_key(__FILE__ ":" DODO_STRINGIFY(__LINE__) ":" expr_str)
+#define DODO_CTX(c, s) Dodo::Failure{(c), (s), DODO_SITE_ID(#c)}
+#define DODO_EXPR_STR(cond) #cond
+#define DODO_MAKE_FAIL(severity, code_enum, cond_str) \
+        Dodo::Failure{(code_enum), (severity), DODO_SITE_ID(cond_str)}
+#elif defined(DODO_FAST_MODE)
+#define DODO_CTX(c, s) Dodo::Failure{(c), (s), DODO_SITE(nullptr, nullptr, 0u, nullptr)}
+#define DODO_EXPR_STR(cond) nullptr
+#define DODO_MAKE_FAIL(severity, code_enum, cond_str) \
+        Dodo::Failure{(code_enum), (severity), DODO_SITE((cond_str), nullptr, 0u, nullptr)}
+#else
+#define DODO_CTX(c, s) Dodo::Failure{(c), (s), DODO_SITE(#c, __FILE__, static_cast<uint32_t>(__LINE__), DODO_SITE_FUNC)}
+#define DODO_EXPR_STR(cond) #cond
+#define DODO_MAKE_FAIL(severity, code_enum, cond_str) \
+        Dodo::Failure{(code_enum), (severity), \
+                      DODO_SITE((cond_str), __FILE__, static_cast<uint32_t>(__LINE__), DODO_SITE_FUNC)}
+#endif
+
+// API Macros
+// Note: We pass the Failure object construction into the inline function
+// The compiler's inlining and dead-code elimination will ensure the Failure
+// struct is NOT constructed on the stack unless the branch is taken
+
+#ifdef DODO_SITE_PROFILE_HEADER
+#define DODO_REQUIRE_ALWAYS(cond, code) \
+    Dodo::basic_require_expect<DODO_POLICY, Dodo::internal::profiled_pass(__FILE__, static_cast<uint32_t>(__LINE__))>( \
+        (cond), (code), DODO_MAKE_FAIL(Dodo::Severity::Recoverable, (code), DODO_EXPR_STR(cond)))
+#else
+#define DODO_REQUIRE_ALWAYS(cond, code) \
+    Dodo::basic_require<DODO_POLICY>((cond), (code), DODO_MAKE_FAIL(Dodo::Severity::Recoverable, (code), DODO_EXPR_STR(cond)))
+#endif
+
+// Precondition with a pass probability in [0, 1] (see basic_require_expect).
+#define DODO_REQUIRE_EXPECT_ALWAYS(cond, code, pass) \
+    Dodo::basic_require_expect<DODO_POLICY, static_cast<double>(pass)>( \
+        (cond), (code), DODO_MAKE_FAIL(Dodo::Severity::Recoverable, (code), DODO_EXPR_STR(cond)))
+
+#define DODO_ENSURE_ALWAYS(cond, code) \
+    Dodo::basic_ensure<DODO_POLICY>((cond), (code), DODO_MAKE_FAIL(Dodo::Severity::Recoverable, (code), DODO_EXPR_STR(cond)))
+
+#define DODO_INVARIANT_ALWAYS(cond, code) \
+    Dodo::basic_invariant<DODO_POLICY>((cond), (code), DODO_MAKE_FAIL(Dodo::Severity::Fatal, (code), DODO_EXPR_STR(cond)))
+
+// Precondition that reports operands: DODO_REQUIRE_WITH(cond, code, ctx_ptr_or_nullptr, up to 3 values).
+#define DODO_REQUIRE_WITH_ALWAYS(cond, code, ctx, ...) \
+    Dodo::basic_require_with<DODO_POLICY>((cond), (code), DODO_MAKE_FAIL(Dodo::Severity::Recoverable, (code), DODO_EXPR_STR(cond)), \
+                                          (ctx) __VA_OPT__(,) __VA_ARGS__)
+
+// Stripped contracts: unevaluated operands keep `cond` and `code` type-checked.
+// Invariants become optimizer assumptions under DODO_CONTRACT_ASSUME.
+#define DODO_STRIPPED_STATUS(cond, code) ((void) sizeof(!(cond)), (void) sizeof(code), Dodo::Status::ok_status())
+#if defined(DODO_CONTRACT_ASSUME)
+#define DODO_STRIPPED_INVARIANT(cond, code) \
+    do { \
+        (void) sizeof(code); \
+        DODO_ASSUME(cond); \
+    } while (0)
+#else
+#define DODO_STRIPPED_INVARIANT(cond, code) ((void) sizeof(!(cond)), (void) sizeof(code))
+#endif
+
+#if DODO_CONTRACT_LEVEL >= DODO_CONTRACT_DEFAULT
+#define DODO_REQUIRE(cond, code)   DODO_REQUIRE_ALWAYS(cond, code)
+#define DODO_REQUIRE_EXPECT(cond, code, pass) DODO_REQUIRE_EXPECT_ALWAYS(cond, code, pass)
+#define DODO_REQUIRE_WITH(cond, code, ctx, ...) DODO_REQUIRE_WITH_ALWAYS(cond, code, ctx __VA_OPT__(,) __VA_ARGS__)
+#define DODO_ENSURE(cond, code)    DODO_ENSURE_ALWAYS(cond, code)
+#define DODO_INVARIANT(cond, code) DODO_INVARIANT_ALWAYS(cond, code)
+#else
+#define DODO_REQUIRE(cond, code)   DODO_STRIPPED_STATUS(cond, code)
+#define DODO_REQUIRE_EXPECT(cond, code, pass) ((void) sizeof(pass), DODO_STRIPPED_STATUS(cond, code))
+#define DODO_REQUIRE_WITH(cond, code, ctx, ...) ((void) sizeof(ctx), DODO_STRIPPED_STATUS(cond, code))
+#define DODO_ENSURE(cond, code)    DODO_STRIPPED_STATUS(cond, code)
+#define DODO_INVARIANT(cond, code) DODO_STRIPPED_INVARIANT(cond, code)
+#endif
+
+#if DODO_CONTRACT_LEVEL >= DODO_CONTRACT_AUDIT
+#define DODO_REQUIRE_AUDIT(cond, code)   DODO_REQUIRE_ALWAYS(cond, code)
+#define DODO_ENSURE_AUDIT(cond, code)    DODO_ENSURE_ALWAYS(cond, code)
+#define DODO_INVARIANT_AUDIT(cond, code) DODO_INVARIANT_ALWAYS(cond, code)
+#else
+#define DODO_REQUIRE_AUDIT(cond, code)   DODO_STRIPPED_STATUS(cond, code)
+#define DODO_ENSURE_AUDIT(cond, code)    DODO_STRIPPED_STATUS(cond, code)
+#define DODO_INVARIANT_AUDIT(cond, code) DODO_STRIPPED_INVARIANT(cond, code)
+#endif
+
+#define DODO_CHECK_NOT_NULL(ptr, code) \
+    Dodo::basic_check_not_null<DODO_POLICY>((ptr), (code), DODO_MAKE_FAIL(Dodo::Severity::Recoverable, (code), DODO_EXPR_STR(ptr)))
+
+#define DODO_CHECK_RANGE(v, lo, hi, code) \
+    Dodo::basic_check_range<DODO_POLICY>((v), (lo), (hi), (code), DODO_MAKE_FAIL(Dodo::Severity::Recoverable, (code), DODO_EXPR_STR(v)))
+
+#define DODO_CHECK_ALIGNED(ptr, alignment, code) \
+    Dodo::basic_check_aligned<DODO_POLICY>((ptr), (alignment), (code), DODO_MAKE_FAIL(Dodo::Severity::Recoverable, (code), DODO_EXPR_STR(ptr)))
+
+// Code::Timeout once `deadline` (a Dodo::BasicDeadline<Clock>) has passed.
+#define DODO_CHECK_DEADLINE(deadline) \
+    Dodo::basic_check_deadline<DODO_POLICY>((deadline), DODO_MAKE_FAIL(Dodo::Severity::Recoverable, Dodo::Code::Timeout, DODO_EXPR_STR(deadline)))
+
+
+// Handler table storage (DODO_EXTERN_HANDLER_TABLE builds only).
+// Use once, at namespace scope, in a single TU: the handlers are baked in at
+// compile time, so startup needs neither dynamic init nor set_*_handler calls.
+#define DODO_DEFINE_HANDLER_TABLE(panic_fn, fallback_fn) \
+    constinit Dodo::HandlerTable Dodo::internal::g_handlers{{(panic_fn)}, {(fallback_fn)}}
+
+// Batched checks over a contiguous range (std::span, std::array, C array, std::vector).
+// Optional trailing `size_t*` receives the first failing index on the cold path.
+#define DODO_CHECK_RANGE_ALL(values, lo, hi, code, ...) \
+    Dodo::basic_check_range_all<DODO_POLICY>((values), (lo), (hi), (code), \
+        DODO_MAKE_FAIL(Dodo::Severity::Recoverable, (code), DODO_EXPR_STR(values)) __VA_OPT__(,) __VA_ARGS__)
+
+#define DODO_CHECK_NOT_NULL_ALL(ptrs, code, ...) \
+    Dodo::basic_check_not_null_all<DODO_POLICY>((ptrs), (code), \
+        DODO_MAKE_FAIL(Dodo::Severity::Recoverable, (code), DODO_EXPR_STR(ptrs)) __VA_OPT__(,) __VA_ARGS__)
+
+// Checked arithmetic: Result<T> holding the exact value, or Code::Overflow.
+#define DODO_CHECK_ADD(a, b) \
+    Dodo::basic_check_add<DODO_POLICY>((a), (b), DODO_MAKE_FAIL(Dodo::Severity::Recoverable, Dodo::Code::Overflow, DODO_EXPR_STR(a + b)))
+
+#define DODO_CHECK_SUB(a, b) \
+    Dodo::basic_check_sub<DODO_POLICY>((a), (b), DODO_MAKE_FAIL(Dodo::Severity::Recoverable, Dodo::Code::Overflow, DODO_EXPR_STR(a - b)))
+
+#define DODO_CHECK_MUL(a, b) \
+    Dodo::basic_check_mul<DODO_POLICY>((a), (b), DODO_MAKE_FAIL(Dodo::Severity::Recoverable, Dodo::Code::Overflow, DODO_EXPR_STR(a * b)))
+
+#define DODO_CHECK_NARROW(To, v) \
+    Dodo::basic_check_narrow<DODO_POLICY, To>((v), DODO_MAKE_FAIL(Dodo::Severity::Recoverable, Dodo::Code::Overflow, DODO_EXPR_STR(v)))
+
+#define DODO_CHECK_MUL_ALL(a, b, out, ...) \
+    Dodo::basic_check_mul_all<DODO_POLICY>((a), (b), (out), \
+        DODO_MAKE_FAIL(Dodo::Severity::Recoverable, Dodo::Code::Overflow, DODO_EXPR_STR(out)) __VA_OPT__(,) __VA_ARGS__)
+
+// Validator accumulation: declare with DODO_VALIDATOR(v), fold checks with
+// DODO_VALIDATE*, then DODO_TRY(v.finish()) takes the only branch.
+#define DODO_VALIDATOR(name) Dodo::BasicValidator<DODO_POLICY> name
+
+#define DODO_VALIDATE(v, cond, code) \
+    (v).require((cond), (code), DODO_MAKE_FAIL(Dodo::Severity::Recoverable, (code), DODO_EXPR_STR(cond)))
+
+#define DODO_VALIDATE_NOT_NULL(v, ptr, code) \
+    (v).check_not_null((ptr), (code), DODO_MAKE_FAIL(Dodo::Severity::Recoverable, (code), DODO_EXPR_STR(ptr)))
+
+#define DODO_VALIDATE_RANGE(v, val, lo, hi, code) \
+    (v).check_range((val), (lo), (hi), (code), DODO_MAKE_FAIL(Dodo::Severity::Recoverable, (code), DODO_EXPR_STR(val)))
+
+#define DODO_VALIDATE_ALIGNED(v, ptr, alignment, code) \
+    (v).check_aligned((ptr), (alignment), (code), DODO_MAKE_FAIL(Dodo::Severity::Recoverable, (code), DODO_EXPR_STR(ptr)))
+
+// Control Sugar-Flow 
+#define DODO_TRY(stmt) \
+    do { \
+        Dodo::Status _dodo_s = (stmt); \
+        if (DODO_UNLIKELY(!_dodo_s.ok())) { \
+            return Dodo::propagate(_dodo_s); \
+        } \
+    } while(0)
+
+// Result<T> unwrap: declares/assigns `var` from a Result<T> or returns its Code.
+// Usage: DODO_TRY_ASSIGN(const uint32_t qty, parse_qty(msg));
+// Not wrapped in do/while because `var` must stay visible in the enclosing scope.
+#define DODO_TRY_ASSIGN(var, expr) \
+    DODO_TRY_ASSIGN_IMPL(var, expr, DODO_CONCAT(_dodo_r_, __COUNTER__))
+
+#define DODO_TRY_ASSIGN_IMPL(var, expr, tmp) \
+    auto tmp = (expr); \
+    if (DODO_UNLIKELY(!tmp.ok())) { \
+        return Dodo::propagate(tmp.status()); \
+    } \
+    var = tmp.value
+
+// Coroutine forms: same contract, but leave with co_return. The promise needs
+// return_value(Status) (CoPromise, or any promise whose result converts from
+// Status). The checked value is the only local, so the frame is no larger
+// than with an unchecked co_await (co_check() adds an awaiter per use).
+// Usage: DODO_CO_TRY(co_await send(order));
+//        DODO_CO_TRY_ASSIGN(const uint32_t qty, co_await read_qty(conn));
+#define DODO_CO_TRY(stmt) \
+    do { \
+        Dodo::Status _dodo_s = (stmt); \
+        if (DODO_UNLIKELY(!_dodo_s.ok())) { \
+            co_return Dodo::propagate(_dodo_s); \
+        } \
     } while(0)
 
+#define DODO_CO_TRY_ASSIGN(var, expr) \
+    DODO_CO_TRY_ASSIGN_IMPL(var, expr, DODO_CONCAT(_dodo_r_, __COUNTER__))
+
+#define DODO_CO_TRY_ASSIGN_IMPL(var, expr, tmp) \
+    auto tmp = (expr); \
+    if (DODO_UNLIKELY(!tmp.ok())) { \
+        co_return Dodo::propagate(tmp.status()); \
+    } \
+    var = tmp.value
+
 #endif
@@ -0,0 +1,236 @@
+#ifndef DODO_FORMAT_HPP
+#define DODO_FORMAT_HPP
+// ============================================================================
+// DODO FORMAT
+// Text rendering of failures, decoded records and the site profile: the
+// snprintf side of Dodo.hpp's binary encode/decode. For handlers, reader
+// threads and tools. Optional companion to Dodo.hpp: this header uses stdio,
+// so it stays out of the core.
+// ============================================================================
+
+#include "Dodo.hpp"
+
+#include <cstdio>
+
+namespace Dodo {
+    namespace internal {
+        // snprintf appenders; n stays <= cap - 1 so truncation is silent.
+        inline size_t advance(size_t n, size_t cap, int w) noexcept {
+            const size_t end = w > 0 ? n + static_cast<size_t>(w) : n;
+            return end < cap ? end : cap - 1;
+        }
+
+        inline size_t append_operand(char *buf, size_t cap, size_t n, OperandType t, uint64_t v) noexcept {
+            if (n + 1 >= cap) {
+                return n;
+            }
+            int w = 0;
+            switch (t) {
+                case OperandType::Signed:
+                    w = std::snprintf(buf + n, cap - n, "%lld", static_cast<long long>(static_cast<int64_t>(v)));
+                    break;
+                case OperandType::Float:
+                    w = std::snprintf(buf + n, cap - n, "%g", std::bit_cast<double>(v));
+                    break;
+                case OperandType::Pointer:
+                    w = std::snprintf(buf + n, cap - n, "0x%llx", static_cast<unsigned long long>(v));
+                    break;
+                case OperandType::Unsigned:
+                    w = std::snprintf(buf + n, cap - n, "%llu", static_cast<unsigned long long>(v));
+                    break;
+            }
+            return advance(n, cap, w);
+        }
+
+        inline size_t append_text(char *buf, size_t cap, size_t n, const char *s) noexcept {
+            if (n + 1 >= cap) {
+                return n;
+            }
+            return advance(n, cap, std::snprintf(buf + n, cap - n, "%s", s));
+        }
+    }
+
+    // Writes a one-line description of the failure's operands into buf, e.g.
+    // "size=5242880 not in [1, 4194304]" (the name is the site's expression,
+    // "value" under DODO_FAST_MODE / DODO_COMPACT_MODE). Returns the length
+    // written; longer text is truncated and the output is NUL-terminated when
+    // cap > 0. Writes "" and returns 0 when there is no payload.
+    // Cold path: meant for handlers, loggers and the flight recorder consumer.
+    inline size_t describe_failure(const Failure &f, const FailurePayload &p, char *buf, size_t cap) noexcept {
+        using internal::append_operand;
+        using internal::append_text;
+        if (cap != 0) {
+            buf[0] = '\0';
+        }
+        const char *name = "value";
+#ifndef DODO_COMPACT_MODE
+        if (f.site != nullptr && f.site->expr != nullptr) {
+            name = f.site->expr;
+        }
+#else
+        (void) f;
+#endif
+        const uint64_t *op = p.operands;
+        size_t n = 0;
+        switch (p.kind) {
+            case PayloadKind::None:
+                return 0;
+            case PayloadKind::Range:
+                n = append_text(buf, cap, n, name);
+                n = append_text(buf, cap, n, "=");
+                n = append_operand(buf, cap, n, p.types[0], op[0]);
+                n = append_text(buf, cap, n, " not in [");
+                n = append_operand(buf, cap, n, p.types[1], op[1]);
+                n = append_text(buf, cap, n, ", ");
+                n = append_operand(buf, cap, n, p.types[2], op[2]);
+                n = append_text(buf, cap, n, "]");
+                break;
+            case PayloadKind::Aligned:
+                n = append_text(buf, cap, n, name);
+                n = append_text(buf, cap, n, "=");
+                n = append_operand(buf, cap, n, OperandType::Pointer, op[0]);
+                n = append_text(buf, cap, n, " not aligned to ");
+                n = append_operand(buf, cap, n, p.types[1], op[1]);
+                break;
+            case PayloadKind::Add:
+            case PayloadKind::Sub:
+            case PayloadKind::Mul: {
+                static constexpr const char *kOps[] = {" + ", " - ", " * "};
+                n = append_operand(buf, cap, n, p.types[0], op[0]);
+                n = append_text(buf, cap, n, kOps[static_cast<size_t>(p.kind) - static_cast<size_t>(PayloadKind::Add)]);
+                n = append_operand(buf, cap, n, p.types[1], op[1]);
+                n = append_text(buf, cap, n, " overflows");
+                break;
+            }
+            case PayloadKind::Narrow:
+                n = append_text(buf, cap, n, name);
+                n = append_text(buf, cap, n, "=");
+                n = append_operand(buf, cap, n, p.types[0], op[0]);
+                n = append_text(buf, cap, n, " does not fit the target type");
+                break;
+            case PayloadKind::Deadline:
+                n = append_text(buf, cap, n, "now=");
+                n = append_operand(buf, cap, n, p.types[0], op[0]);
+                n = append_text(buf, cap, n, " past deadline ");
+                n = append_operand(buf, cap, n, p.types[1], op[1]);
+                break;
+            case PayloadKind::Values:
+                n = append_text(buf, cap, n, name);
+                n = append_text(buf, cap, n, " failed with");
+                for (size_t i = 0; i < p.count && i < kMaxOperands; ++i) {
+                    n = append_text(buf, cap, n, i == 0 ? " " : ", ");
+                    n = append_operand(buf, cap, n, p.types[i], op[i]);
+                }
+                break;
+        }
+        return n;
+    }
+
+    inline size_t describe_failure(const Failure &f, char *buf, size_t cap) noexcept {
+        const FailurePayload *p = payload_of(f);
+        if (p == nullptr) {
+            if (cap != 0) {
+                buf[0] = '\0';
+            }
+            return 0;
+        }
+        return describe_failure(f, *p, buf, cap);
+    }
+
+    // Tag for format_failure: the record was encoded by this process, so its
+    // site field is a live Site address that may be dereferenced.
+    struct SameProcess {};
+    inline constexpr SameProcess kSameProcess{};
+
+    namespace internal {
+        inline size_t format_decoded(const DecodedFailure &d, const Site *s, char *buf, size_t cap) noexcept {
+            if (cap == 0) {
+                return 0;
+            }
+            buf[0] = '\0';
+            size_t n = append_text(buf, cap, 0, code_name(d.code));
+            Failure f{d.code, d.sev, {}};
+#ifndef DODO_COMPACT_MODE
+            if (s != nullptr && s->file != nullptr) {
+                char line[16];
+                std::snprintf(line, sizeof(line), ":%u ", static_cast<unsigned>(s->line));
+                n = append_text(buf, cap, n, " ");
+                n = append_text(buf, cap, n, s->file);
+                n = append_text(buf, cap, n, line);
+                n = append_text(buf, cap, n, s->expr != nullptr ? s->expr : "");
+            } else
+#else
+            (void) s;
+#endif
+            {
+                char id[32]; // compact IDs print as in tools/dodo_sitemap
+                std::snprintf(id, sizeof(id), " site:%08llx", static_cast<unsigned long long>(d.site));
+                n = append_text(buf, cap, n, id);
+            }
+#ifndef DODO_COMPACT_MODE
+            f.site = s;
+#endif
+            if (d.payload.kind != PayloadKind::None && n + 3 < cap) {
+                n = append_text(buf, cap, n, ": ");
+                n += describe_failure(f, d.payload, buf + n, cap - n);
+            }
+            return n;
+        }
+    }
+
+    // Reader side: one line of text for a decoded record. The site field is
+    // never dereferenced here (the record may come from another process or a
+    // file), so the site prints as "site:<hex>", e.g.
+    // "OutOfRange site:55d0c3a1b2c0: qty=900 not in [0, 500]".
+    // Returns the length written, truncated and NUL-terminated like describe_failure.
+    inline size_t format_failure(const DecodedFailure &d, char *buf, size_t cap) noexcept {
+        return internal::format_decoded(d, nullptr, buf, cap);
+    }
+
+    // Same-process form: resolves the site to file, line and expression, e.g.
+    // "OutOfRange src/feed.cpp:88 qty <= limit: qty <= limit failed with 900, 500".
+    // Only for records this process encoded; in compact mode it prints "site:<hex>".
+    inline size_t format_failure(const DecodedFailure &d, char *buf, size_t cap, SameProcess) noexcept {
+#ifndef DODO_COMPACT_MODE
+        return internal::format_decoded(d, reinterpret_cast<const Site *>(static_cast<uintptr_t>(d.site)), buf, cap);
+#else
+        return internal::format_decoded(d, nullptr, buf, cap); // site IDs are not addresses
+#endif
+    }
+
+    // Writes one "file\tline\tevals\tfails\n" line per registered site with a
+    // file (the input of tools/dodo_profgen). evals is 0 unless built with
+    // DODO_SITE_PROFILE. Like for_each_site it lists only sites that have failed
+    // at least once; a site that always passed keeps the default hint anyway.
+    // Evaluations before the first failure are still counted. Stops at the last
+    // whole line that fits; returns the length written (NUL-terminated when
+    // cap > 0). The caller does the I/O.
+    inline size_t format_site_profile(char *buf, size_t cap) noexcept {
+        size_t n = 0;
+        if (cap != 0) {
+            buf[0] = '\0';
+        }
+        for_each_site([&](const Site &s) noexcept {
+            if (s.file == nullptr) {
+                return;
+            }
+#ifdef DODO_SITE_PROFILE
+            const uint64_t evals = s.evals.load(std::memory_order_relaxed);
+#else
+            const uint64_t evals = 0;
+#endif
+            const int w = std::snprintf(buf + n, cap - n, "%s\t%u\t%llu\t%llu\n", s.file, s.line,
+                                        static_cast<unsigned long long>(evals),
+                                        static_cast<unsigned long long>(s.hits.load(std::memory_order_relaxed)));
+            if (w > 0 && n + static_cast<size_t>(w) < cap) {
+                n += static_cast<size_t>(w);
+            } else if (cap != 0) {
+                buf[n] = '\0';
+                cap = n + 1; // full: later lines are dropped too
+            }
+        });
+        return n;
+    }
+}
+
+#endif
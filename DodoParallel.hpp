@@ -0,0 +1,266 @@
+#ifndef DODO_PARALLEL_HPP
+#define DODO_PARALLEL_HPP
+// ============================================================================
+// DODO PARALLEL
+// Batch validation on a fixed thread pool: Status-returning checks over a
+// span, chunked and spread over workers that steal each other's chunks, with
+// per-element codes or stop-at-first-failure. Optional companion to Dodo.hpp:
+// this header starts threads, so it stays out of the core. No allocation per
+// batch or per task, no locks (workers sleep on an atomic wait).
+// ============================================================================
+
+#include "Dodo.hpp"
+
+#include <thread>
+
+#ifndef DODO_POOL_MAX_WORKERS
+#define DODO_POOL_MAX_WORKERS 63 // worker threads per pool; the calling thread always joins in
+#endif
+
+namespace Dodo {
+    // Fork-join pool with a fixed set of workers started by the constructor.
+    // run(n, fn) calls fn(task) for every task in [0, n) exactly once, across
+    // the workers and the calling thread, and returns when all are done.
+    //
+    // Scheduling: the task range is split into one contiguous block per
+    // participant. Each takes tasks from its own block with a fetch_add and,
+    // once that is empty, steals from the other blocks with the same fetch_add,
+    // so uneven tasks rebalance without queues or locks. Idle workers sleep in
+    // std::atomic::wait (futex on Linux), not spinning.
+    //
+    // One run() at a time: a run() issued while another is active (from a task,
+    // or a second thread) executes its tasks inline on the caller instead of
+    // deadlocking.
+    template<size_t MaxWorkers = DODO_POOL_MAX_WORKERS>
+    class BasicThreadPool {
+    public:
+        static constexpr size_t max_workers = MaxWorkers;
+
+        // `workers` threads besides the caller, capped at MaxWorkers. 0 runs
+        // everything on the calling thread.
+        explicit BasicThreadPool(size_t workers = default_workers()) noexcept
+            : workers_{workers < MaxWorkers ? workers : MaxWorkers} {
+            for (size_t w = 0; w < workers_; ++w) {
+                threads_[w] = std::thread([this, w] { worker_loop(w + 1); });
+            }
+        }
+
+        BasicThreadPool(const BasicThreadPool &) = delete;
+        BasicThreadPool &operator=(const BasicThreadPool &) = delete;
+
+        ~BasicThreadPool() {
+            stop_.store(true, std::memory_order_relaxed);
+            epoch_.fetch_add(1, std::memory_order_release);
+            epoch_.notify_all();
+            for (size_t w = 0; w < workers_; ++w) {
+                threads_[w].join();
+            }
+        }
+
+        // hardware_concurrency() - 1: the caller is the last participant.
+        static size_t default_workers() noexcept {
+            const unsigned hw = std::thread::hardware_concurrency();
+            return hw > 1 ? hw - 1 : 0;
+        }
+
+        size_t workers() const noexcept { return workers_; }
+
+        // fn(size_t task) noexcept. Blocks until every task has run.
+        template<class Fn>
+        void run(size_t tasks, Fn &&fn) noexcept {
+            using F = std::remove_reference_t<Fn>;
+            if (tasks == 0) {
+                return;
+            }
+            if (workers_ == 0 || tasks == 1 || busy_.exchange(true, std::memory_order_acquire)) {
+                for (size_t t = 0; t < tasks; ++t) {
+                    fn(t);
+                }
+                return;
+            }
+            invoke_ = [](void *ctx, size_t t) noexcept { (*static_cast<F *>(ctx))(t); };
+            ctx_ = const_cast<void *>(static_cast<const void *>(&fn));
+
+            const size_t participants = workers_ + 1;
+            const size_t block = (tasks + participants - 1) / participants;
+            for (size_t p = 0; p < participants; ++p) {
+                const size_t begin = p * block < tasks ? p * block : tasks;
+                cursors_[p].next.store(begin, std::memory_order_relaxed);
+                cursors_[p].end = begin + block < tasks ? begin + block : tasks;
+            }
+            active_.store(workers_, std::memory_order_relaxed);
+            epoch_.fetch_add(1, std::memory_order_release); // publishes the job and cursors
+            epoch_.notify_all();
+
+            participate(0);
+            for (size_t left = active_.load(std::memory_order_acquire); left != 0;
+                 left = active_.load(std::memory_order_acquire)) {
+                active_.wait(left, std::memory_order_acquire);
+            }
+            busy_.store(false, std::memory_order_release);
+        }
+
+    private:
+        struct alignas(DODO_CACHE_LINE) Cursor {
+            std::atomic<size_t> next{0};
+            size_t end{0}; // written before the epoch bump, read-only during a run
+        };
+
+        using InvokeFn = void (*)(void *, size_t) noexcept;
+
+        void participate(size_t self) noexcept {
+            const size_t participants = workers_ + 1;
+            for (size_t k = 0; k < participants; ++k) {
+                Cursor &c = cursors_[(self + k) % participants];
+                for (size_t t = c.next.fetch_add(1, std::memory_order_relaxed); t < c.end;
+                     t = c.next.fetch_add(1, std::memory_order_relaxed)) {
+                    invoke_(ctx_, t);
+                }
+            }
+        }
+
+        void worker_loop(size_t self) noexcept {
+            uint64_t seen = 0;
+            for (;;) {
+                epoch_.wait(seen, std::memory_order_acquire);
+                const uint64_t now = epoch_.load(std::memory_order_acquire);
+                if (now == seen) {
+                    continue; // spurious wake-up
+                }
+                seen = now;
+                if (stop_.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                participate(self);
+                // acq_rel: the tasks' writes are visible to run()'s acquire load.
+                if (active_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    active_.notify_one();
+                }
+            }
+        }
+
+        Cursor cursors_[MaxWorkers + 1];
+        alignas(DODO_CACHE_LINE) std::atomic<uint64_t> epoch_{0};
+        std::atomic<size_t> active_{0};
+        std::atomic<bool> busy_{false};
+        std::atomic<bool> stop_{false};
+        InvokeFn invoke_{nullptr};
+        void *ctx_{nullptr};
+        size_t workers_;
+        std::thread threads_[MaxWorkers];
+    };
+
+    using ThreadPool = BasicThreadPool<>;
+
+    struct ParallelOptions {
+        // Per-element codes (Code::Ok for passing elements); must hold at least
+        // items.size() entries, or stay empty. Elements skipped after a stop or
+        // cancel are left untouched.
+        std::span<Code> codes{};
+        // Stop after the first failure: the failing chunk ends at that element,
+        // chunks not yet started are skipped, chunks running elsewhere finish.
+        bool stop_on_failure = false;
+        // Caller-owned flag (e.g. set from a session-abort path); checked once
+        // per chunk, like the internal stop flag.
+        const std::atomic<bool> *cancel = nullptr;
+        Code cancel_code = Code::ExternalFault; // status when cancelled with no failure seen
+        size_t chunk = 256; // elements per task: one cancel check and one counter update each
+    };
+
+    struct ParallelResult {
+        Status status; // code of the lowest-index failure seen, cancel_code, or Ok
+        size_t failed; // elements that returned a failing Status
+        size_t first_failed; // index of that failure; SIZE_MAX if none
+        size_t processed; // elements fn ran on
+        bool cancelled; // work was skipped (stop_on_failure or the caller's flag), i.e. processed < n
+    };
+
+    namespace internal {
+        // Shared batch state. Lowest failing index and its code share one word
+        // (index << 16 | code) so a CAS-min keeps them consistent.
+        struct ParallelTally {
+            std::atomic<bool> stop{false};
+            std::atomic<size_t> failed{0};
+            std::atomic<size_t> processed{0};
+            std::atomic<uint64_t> first{UINT64_MAX};
+
+            void note_first(size_t index, Code code) noexcept {
+                const uint64_t mine = (static_cast<uint64_t>(index) << 16) | static_cast<uint16_t>(code);
+                uint64_t cur = first.load(std::memory_order_relaxed);
+                while (mine < cur && !first.compare_exchange_weak(cur, mine, std::memory_order_relaxed)) {
+                }
+            }
+        };
+    }
+
+    // Runs fn(const T&) -> Status over `items` on `pool`, chunk by chunk.
+    // fn runs concurrently on several threads: it must be safe for that, and
+    // its failures go through the usual (atomic, thread-safe) handlers.
+    // Nothing is allocated; per-chunk state lives on the stack of whichever
+    // thread runs the chunk, and shared counters are touched once per chunk.
+    template<class T, class Fn, size_t MaxWorkers>
+    ParallelResult parallel_validate(std::span<const T> items, Fn &&fn, BasicThreadPool<MaxWorkers> &pool,
+                                     const ParallelOptions &opt = {}) noexcept {
+        const size_t n = items.size();
+        const size_t chunk = opt.chunk != 0 ? opt.chunk : 1;
+        Code *const codes = opt.codes.size() >= n ? opt.codes.data() : nullptr;
+        internal::ParallelTally tally;
+
+        pool.run((n + chunk - 1) / chunk, [&](size_t task) noexcept {
+            if (tally.stop.load(std::memory_order_relaxed) ||
+                (opt.cancel != nullptr && opt.cancel->load(std::memory_order_relaxed))) {
+                tally.stop.store(true, std::memory_order_relaxed);
+                return;
+            }
+            const size_t begin = task * chunk;
+            const size_t end = begin + chunk < n ? begin + chunk : n;
+            size_t bad = 0;
+            size_t i = begin;
+            for (; i < end; ++i) {
+                const Status s = fn(items[i]);
+                if (codes != nullptr) {
+                    codes[i] = s.code;
+                }
+                if (DODO_UNLIKELY(!s.ok())) {
+                    if (bad++ == 0) {
+                        tally.note_first(i, s.code);
+                    }
+                    if (opt.stop_on_failure) {
+                        tally.stop.store(true, std::memory_order_relaxed);
+                        ++i;
+                        break;
+                    }
+                }
+            }
+            tally.processed.fetch_add(i - begin, std::memory_order_relaxed);
+            if (bad != 0) {
+                tally.failed.fetch_add(bad, std::memory_order_relaxed);
+            }
+        });
+
+        // run() returned: every task's writes are visible here.
+        const uint64_t first = tally.first.load(std::memory_order_relaxed);
+        // The stop flag alone is not enough: it is also set when the failure was the last element.
+        const size_t processed = tally.processed.load(std::memory_order_relaxed);
+        const bool cancelled = processed < n;
+        ParallelResult r{Status::ok_status(), tally.failed.load(std::memory_order_relaxed), SIZE_MAX, processed,
+                         cancelled};
+        if (first != UINT64_MAX) {
+            r.status = Status{static_cast<Code>(first & 0xFFFFu)};
+            r.first_failed = static_cast<size_t>(first >> 16);
+        } else if (cancelled) {
+            r.status = Status{opt.cancel_code};
+        }
+        return r;
+    }
+
+    // Deduces T from containers and arrays.
+    template<class R, class Fn, size_t MaxWorkers>
+    auto parallel_validate(const R &items, Fn &&fn, BasicThreadPool<MaxWorkers> &pool, const ParallelOptions &opt = {})
+        noexcept -> decltype(std::span{items}, ParallelResult{}) {
+        using T = std::remove_cv_t<typename decltype(std::span{items})::element_type>;
+        return parallel_validate(std::span<const T>{std::span{items}}, static_cast<Fn &&>(fn), pool, opt);
+    }
+}
+
+#endif
@@ -0,0 +1,472 @@
+#ifndef DODO_REPORTER_HPP
+#define DODO_REPORTER_HPP
+// ============================================================================
+// DODO REPORTER
+// Off-thread failure reporting: per-producer SPSC rings filled from the cold
+// path, one drain thread that hands batches to a sink (file, socket, ...).
+// Optional companion to Dodo.hpp: this header does I/O and starts a thread,
+// so it stays out of the core. POSIX only.
+// ============================================================================
+
+#include "DodoFormat.hpp"
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "DodoReporter.hpp needs POSIX (writev, sendmsg)"
+#endif
+
+#include <cerrno>
+#include <climits>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#ifndef DODO_REPORTER_CAPACITY
+#define DODO_REPORTER_CAPACITY 256 // records per producer ring, power of 2
+#endif
+#ifndef DODO_REPORTER_PRODUCERS
+#define DODO_REPORTER_PRODUCERS 16 // producer threads with a ring; others are counted as untracked
+#endif
+
+namespace Dodo {
+    // A contiguous run of records inside one producer ring. Sinks receive the
+    // ring storage itself: valid only for the duration of the write() call.
+    using RecordSpan = std::span<const FlightRecord>;
+
+    // A sink is any type with
+    //   bool write(std::span<const RecordSpan> batch) noexcept;
+    // called from the drain thread only. Returning false counts a sink error;
+    // the batch is consumed either way (the reporter never retries or blocks).
+
+    struct ReporterConfig {
+        uint32_t batch = 256; // records handed to the sink per write() at most
+        uint32_t idle_sleep_us = 200; // drain thread back-off when every ring is empty
+        // Ring depth from which Recoverable records are shed so the remaining
+        // slots stay free for Fatal ones. 0 = three quarters of the capacity.
+        uint32_t shed_at = 0;
+    };
+
+    // Relaxed snapshot, summed over the producer rings.
+    struct ReporterCounters {
+        uint64_t pushed; // records accepted into a ring
+        uint64_t dropped; // ring full
+        uint64_t shed; // Recoverable records refused above shed_at
+        uint64_t untracked; // producer thread index >= MaxProducers
+        uint64_t delivered; // records handed to the sink
+        uint64_t batches; // sink write() calls
+        uint64_t sink_errors; // write() calls that returned false
+        uint64_t max_depth; // deepest ring seen by the drain thread
+    };
+
+    namespace internal {
+        // Type-erased reporter, for the ready-made handlers below.
+        struct ReportTarget {
+            void *self;
+            bool (*report)(void *self, const Failure &f) noexcept;
+        };
+
+        inline std::atomic<const ReportTarget *> g_report_target{nullptr};
+        inline std::atomic<PanicFn> g_report_prev_panic{default_panic};
+        inline std::atomic<FallbackFn> g_report_prev_fallback{default_fallback};
+
+        // Owner-only counter: relaxed load+store, readable from any thread.
+        inline void bump(std::atomic<uint64_t> &c) noexcept {
+            c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    }
+
+    template<class Sink, size_t Capacity = DODO_REPORTER_CAPACITY, size_t MaxProducers = DODO_REPORTER_PRODUCERS>
+    class BasicReporter {
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2");
+
+    public:
+        static constexpr size_t capacity = Capacity;
+        static constexpr size_t max_producers = MaxProducers;
+
+        explicit BasicReporter(Sink sink, ReporterConfig cfg = {}) noexcept
+            : sink_{static_cast<Sink &&>(sink)}, cfg_{cfg}, target_{this, &report_thunk} {
+            if (cfg_.shed_at == 0 || cfg_.shed_at > Capacity) {
+                cfg_.shed_at = static_cast<uint32_t>(Capacity - Capacity / 4);
+            }
+            if (cfg_.batch == 0) {
+                cfg_.batch = 1;
+            }
+        }
+
+        ~BasicReporter() { stop(); }
+
+        BasicReporter(const BasicReporter &) = delete;
+        BasicReporter &operator=(const BasicReporter &) = delete;
+
+        // Producer side (any thread, into its own ring). Wait-free: a few loads,
+        // one 72-byte copy and a release store; never a syscall. Returns false
+        // if the record was dropped, shed or untracked.
+        bool push(const FlightRecord &rec) noexcept {
+            const uint32_t t = internal::thread_index();
+            if (DODO_UNLIKELY(t >= MaxProducers)) {
+                untracked_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            Ring &r = rings_[t];
+            const uint64_t head = r.head.load(std::memory_order_relaxed);
+            uint64_t depth = head - r.cached_tail;
+            if (depth >= cfg_.shed_at) {
+                // Only re-read the consumer's line when the cached view looks full.
+                r.cached_tail = r.tail.load(std::memory_order_acquire);
+                depth = head - r.cached_tail;
+            }
+            if (DODO_UNLIKELY(depth >= Capacity)) {
+                internal::bump(r.dropped);
+                return false;
+            }
+            if (DODO_UNLIKELY(depth >= cfg_.shed_at && rec.failure.sev != Severity::Fatal)) {
+                internal::bump(r.shed);
+                return false;
+            }
+            r.slots[head & (Capacity - 1)] = rec;
+            r.head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Builds the record (timestamp, thread, payload_of(f)) and pushes it.
+        bool report(const Failure &f) noexcept {
+            const FailurePayload *p = payload_of(f);
+            return push(FlightRecord{internal::read_tsc(), f, internal::thread_index(),
+                                     p != nullptr ? *p : FailurePayload{}});
+        }
+
+        // Consumer step: hands up to cfg.batch records to the sink, then frees
+        // their slots. Run by the drain thread; call it directly when the
+        // reporter is not started (tests, a poll loop you already own).
+        size_t drain_once() noexcept {
+            RecordSpan segs[2 * MaxProducers];
+            uint64_t take[MaxProducers]{};
+            size_t nseg = 0;
+            size_t total = 0;
+            for (size_t t = 0; t < MaxProducers && total < cfg_.batch; ++t) {
+                Ring &r = rings_[t];
+                const uint64_t tail = r.tail.load(std::memory_order_relaxed);
+                const uint64_t depth = r.head.load(std::memory_order_acquire) - tail;
+                if (depth == 0) {
+                    continue;
+                }
+                if (depth > max_depth_.load(std::memory_order_relaxed)) {
+                    max_depth_.store(depth, std::memory_order_relaxed);
+                }
+                const uint64_t n = depth < cfg_.batch - total ? depth : cfg_.batch - total;
+                const size_t first = static_cast<size_t>(tail & (Capacity - 1));
+                const size_t run = n < Capacity - first ? static_cast<size_t>(n) : Capacity - first;
+                segs[nseg++] = RecordSpan{r.slots + first, run};
+                if (run < n) {
+                    segs[nseg++] = RecordSpan{r.slots, static_cast<size_t>(n) - run};
+                }
+                take[t] = n;
+                total += static_cast<size_t>(n);
+            }
+            if (total == 0) {
+                return 0;
+            }
+            if (!sink_.write(std::span<const RecordSpan>{segs, nseg})) {
+                internal::bump(sink_errors_);
+            }
+            internal::bump(batches_);
+            delivered_.store(delivered_.load(std::memory_order_relaxed) + total, std::memory_order_relaxed);
+            for (size_t t = 0; t < MaxProducers; ++t) {
+                if (take[t] != 0) {
+                    Ring &r = rings_[t];
+                    r.tail.store(r.tail.load(std::memory_order_relaxed) + take[t], std::memory_order_release);
+                }
+            }
+            return total;
+        }
+
+        // Starts the drain thread (false if already running). Not thread-safe
+        // against a concurrent start()/stop().
+        bool start() {
+            if (running_.load(std::memory_order_relaxed)) {
+                return false;
+            }
+            running_.store(true, std::memory_order_relaxed);
+            drain_ = std::thread([this] { drain_loop(); });
+            return true;
+        }
+
+        // Stops the drain thread after it has flushed every record pushed so far.
+        void stop() noexcept {
+            if (!running_.exchange(false, std::memory_order_acq_rel)) {
+                return;
+            }
+            drain_.join();
+        }
+
+        bool running() const noexcept { return running_.load(std::memory_order_relaxed); }
+
+        ReporterCounters counters() const noexcept {
+            ReporterCounters c{};
+            for (const Ring &r : rings_) {
+                c.pushed += r.head.load(std::memory_order_relaxed);
+                c.dropped += r.dropped.load(std::memory_order_relaxed);
+                c.shed += r.shed.load(std::memory_order_relaxed);
+            }
+            c.untracked = untracked_.load(std::memory_order_relaxed);
+            c.delivered = delivered_.load(std::memory_order_relaxed);
+            c.batches = batches_.load(std::memory_order_relaxed);
+            c.sink_errors = sink_errors_.load(std::memory_order_relaxed);
+            c.max_depth = max_depth_.load(std::memory_order_relaxed);
+            return c;
+        }
+
+        const ReporterConfig &config() const noexcept { return cfg_; }
+        Sink &sink() noexcept { return sink_; }
+        const internal::ReportTarget &target() const noexcept { return target_; }
+
+    private:
+        struct alignas(DODO_CACHE_LINE) Ring {
+            // Producer line: head, its cached view of tail, drop counters.
+            std::atomic<uint64_t> head{0};
+            uint64_t cached_tail{0};
+            std::atomic<uint64_t> dropped{0};
+            std::atomic<uint64_t> shed{0};
+            // Consumer line.
+            alignas(DODO_CACHE_LINE) std::atomic<uint64_t> tail{0};
+            alignas(DODO_CACHE_LINE) FlightRecord slots[Capacity];
+        };
+
+        static bool report_thunk(void *self, const Failure &f) noexcept {
+            return static_cast<BasicReporter *>(self)->report(f);
+        }
+
+        void drain_loop() noexcept {
+            while (running_.load(std::memory_order_acquire)) {
+                if (drain_once() == 0) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(cfg_.idle_sleep_us));
+                }
+            }
+            while (drain_once() != 0) {
+            }
+        }
+
+        Ring rings_[MaxProducers];
+        Sink sink_;
+        ReporterConfig cfg_;
+        internal::ReportTarget target_;
+        std::atomic<bool> running_{false};
+        std::thread drain_;
+        std::atomic<uint64_t> untracked_{0};
+        // Drain-thread-only counters.
+        std::atomic<uint64_t> delivered_{0};
+        std::atomic<uint64_t> batches_{0};
+        std::atomic<uint64_t> sink_errors_{0};
+        std::atomic<uint64_t> max_depth_{0};
+    };
+
+    // --------------------------------------------------------------------------
+    // Ready-made handlers: push to the installed reporter, then forward
+    // --------------------------------------------------------------------------
+
+    inline Status reporter_fallback(const Failure &f) noexcept {
+        if (const internal::ReportTarget *t = internal::g_report_target.load(std::memory_order_acquire)) {
+            (void) t->report(t->self, f);
+        }
+        return internal::g_report_prev_fallback.load(std::memory_order_acquire)(f);
+    }
+
+    // Best effort: the record is queued, but the process usually dies before
+    // the drain thread writes it. Pair with a synchronous crash record.
+    inline void reporter_panic(const Failure &f) noexcept {
+        if (const internal::ReportTarget *t = internal::g_report_target.load(std::memory_order_acquire)) {
+            (void) t->report(t->self, f);
+        }
+        internal::g_report_prev_panic.load(std::memory_order_acquire)(f);
+    }
+
+    // Routes failures to `r` and chains the handlers in front of the current
+    // ones (idempotent). `r` must outlive every failure that may still run;
+    // call uninstall_reporter() before destroying it.
+    template<class R>
+    inline void install_reporter(R &r) noexcept {
+        internal::g_report_target.store(&r.target(), std::memory_order_release);
+        const PanicFn panic = get_panic_handler();
+        if (panic != reporter_panic) {
+            internal::g_report_prev_panic.store(panic, std::memory_order_release);
+            set_panic_handler(reporter_panic);
+        }
+        const FallbackFn fallback = get_fallback_handler();
+        if (fallback != reporter_fallback) {
+            internal::g_report_prev_fallback.store(fallback, std::memory_order_release);
+            set_fallback_handler(reporter_fallback);
+        }
+    }
+
+    // Stops routing to the reporter; the chained handlers keep forwarding.
+    inline void uninstall_reporter() noexcept {
+        internal::g_report_target.store(nullptr, std::memory_order_release);
+    }
+
+    // --------------------------------------------------------------------------
+    // Sinks
+    // --------------------------------------------------------------------------
+
+    namespace internal {
+        // writev() until every byte is out; EINTR retried, partial writes resumed.
+        inline bool write_all(int fd, iovec *iov, int n) noexcept {
+            while (n > 0) {
+                const ssize_t w = ::writev(fd, iov, n < IOV_MAX ? n : IOV_MAX);
+                if (w < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    return false;
+                }
+                size_t left = static_cast<size_t>(w);
+                while (n > 0 && left >= iov->iov_len) {
+                    left -= iov->iov_len;
+                    ++iov;
+                    --n;
+                }
+                if (n > 0) {
+                    iov->iov_base = static_cast<char *>(iov->iov_base) + left;
+                    iov->iov_len -= left;
+                }
+            }
+            return true;
+        }
+
+        inline iovec record_iovec(RecordSpan s) noexcept {
+            // iovec wants a mutable pointer; writev/sendmsg only read through it.
+            return iovec{const_cast<FlightRecord *>(s.data()), s.size_bytes()};
+        }
+    }
+
+    // Raw FlightRecords (host layout) straight from the rings: one writev per
+    // batch, no copy. Decode with the same build (site pointers are addresses
+    // in this process; compact builds write the site ID resolvable with
+    // tools/dodo_sitemap).
+    struct BinaryFdSink {
+        int fd;
+
+        bool write(std::span<const RecordSpan> batch) noexcept {
+            iovec iov[2 * DODO_REPORTER_PRODUCERS];
+            int n = 0;
+            for (const RecordSpan &s : batch) {
+                if (n == static_cast<int>(std::size(iov))) {
+                    if (!internal::write_all(fd, iov, n)) {
+                        return false;
+                    }
+                    n = 0;
+                }
+                iov[n++] = internal::record_iovec(s);
+            }
+            return internal::write_all(fd, iov, n);
+        }
+    };
+
+    // One text line per record, formatted on the drain thread:
+    //   "<tsc> t<thread> <code name> <file>:<line> <expr>: <payload>\n"
+    // Lines are gathered in a buffer and written with one writev per batch.
+    struct TextFdSink {
+        int fd;
+        char buf[16384];
+
+        bool write(std::span<const RecordSpan> batch) noexcept {
+            size_t used = 0;
+            bool ok = true;
+            for (const RecordSpan &s : batch) {
+                for (const FlightRecord &r : s) {
+                    if (sizeof(buf) - used < kMaxLine) {
+                        ok &= flush(used);
+                        used = 0;
+                    }
+                    used += format(r, buf + used, kMaxLine);
+                }
+            }
+            return flush(used) && ok;
+        }
+
+        static constexpr size_t kMaxLine = 512;
+
+        static size_t format(const FlightRecord &r, char *out, size_t cap) noexcept {
+            const char *file = "?";
+            const char *expr = "";
+            unsigned line = 0;
+#ifdef DODO_COMPACT_MODE
+            char id[16];
+            std::snprintf(id, sizeof(id), "site:%08x", static_cast<unsigned>(r.failure.site_id));
+            file = id;
+#else
+            if (r.failure.site != nullptr) {
+                file = r.failure.site->file != nullptr ? r.failure.site->file : "?";
+                expr = r.failure.site->expr != nullptr ? r.failure.site->expr : "";
+                line = r.failure.site->line;
+            }
+#endif
+            const int w = std::snprintf(out, cap, "%llu t%u %s %s:%u %s", static_cast<unsigned long long>(r.tsc),
+                                        static_cast<unsigned>(r.thread), code_name(r.failure.code), file, line, expr);
+            size_t n = w > 0 ? (static_cast<size_t>(w) < cap - 1 ? static_cast<size_t>(w) : cap - 1) : 0;
+            if (r.payload.kind != PayloadKind::None && cap - n > 3) {
+                out[n++] = ':';
+                out[n++] = ' ';
+                n += describe_failure(r.failure, r.payload, out + n, cap - n - 1);
+            }
+            out[n++] = '\n';
+            return n;
+        }
+
+    private:
+        bool flush(size_t used) noexcept {
+            if (used == 0) {
+                return true;
+            }
+            iovec iov{buf, used};
+            return internal::write_all(fd, &iov, 1);
+        }
+    };
+
+    // Datagrams of raw records on a connected datagram socket (UDP, or an
+    // AF_UNIX SOCK_DGRAM pair). Each datagram carries whole records and at most
+    // max_datagram bytes; the records are gathered with sendmsg, not copied.
+    struct DatagramSink {
+        int fd;
+        size_t max_datagram = 8192;
+
+        bool write(std::span<const RecordSpan> batch) noexcept {
+            const size_t per = max_datagram / sizeof(FlightRecord) != 0 ? max_datagram / sizeof(FlightRecord) : 1;
+            iovec iov[2 * DODO_REPORTER_PRODUCERS];
+            size_t niov = 0;
+            size_t in_dgram = 0;
+            bool ok = true;
+            for (RecordSpan s : batch) {
+                while (!s.empty()) {
+                    const size_t k = s.size() < per - in_dgram ? s.size() : per - in_dgram;
+                    iov[niov++] = internal::record_iovec(s.first(k));
+                    in_dgram += k;
+                    s = s.subspan(k);
+                    if (in_dgram == per || niov == std::size(iov)) {
+                        ok &= send(iov, niov);
+                        niov = 0;
+                        in_dgram = 0;
+                    }
+                }
+            }
+            return (niov == 0 || send(iov, niov)) && ok;
+        }
+
+    private:
+        bool send(iovec *iov, size_t n) const noexcept {
+            msghdr msg{};
+            msg.msg_iov = iov;
+            msg.msg_iovlen = static_cast<decltype(msg.msg_iovlen)>(n);
+            for (;;) {
+                if (::sendmsg(fd, &msg, MSG_DONTWAIT) >= 0) {
+                    return true;
+                }
+                if (errno != EINTR) {
+                    return false; // EAGAIN included: a full socket drops the datagram
+                }
+            }
+        }
+    };
+}
+
+#endif
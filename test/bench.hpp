@@ -0,0 +1,627 @@
+#ifndef DODO_BENCH_HPP
+#define DODO_BENCH_HPP
+
+// Cycle-level micro-benchmark harness for the stress test (x86-64).
+// Per-iteration rdtsc/rdtscp samples go into a preallocated buffer; the timer
+// overhead is calibrated and subtracted; results are reported as percentiles,
+// a log-linear histogram and (Linux, when permitted) PMU counters read through
+// perf_event_open. Not part of the library: Dodo.hpp stays I/O free.
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <x86intrin.h>
+
+#if defined(__linux__)
+    #include <linux/perf_event.h>
+    #include <pthread.h>
+    #include <sched.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #define DODO_BENCH_HAS_PERF 1
+#else
+    #define DODO_BENCH_HAS_PERF 0
+#endif
+
+namespace bench {
+    // --------------------------------------------------------------------------
+    // Timer: lfence-serialized rdtsc to open, rdtscp + lfence to close
+    // --------------------------------------------------------------------------
+
+    inline uint64_t tsc_begin() noexcept {
+        _mm_lfence();
+        const uint64_t t = __rdtsc();
+        _mm_lfence();
+        return t;
+    }
+
+    inline uint64_t tsc_end() noexcept {
+        unsigned aux = 0;
+        const uint64_t t = __rdtscp(&aux);
+        _mm_lfence();
+        return t;
+    }
+
+    // Pin the calling thread to one CPU. Returns false if unsupported or refused.
+    inline bool pin_to_core(int cpu) noexcept {
+#if defined(__linux__)
+        if (cpu < 0) {
+            return false;
+        }
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(static_cast<size_t>(cpu), &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+        (void) cpu;
+        return false;
+#endif
+    }
+
+    inline int current_cpu() noexcept {
+#if defined(__linux__)
+        return sched_getcpu();
+#else
+        return -1;
+#endif
+    }
+
+    // --------------------------------------------------------------------------
+    // Histogram: exact below 8 cycles, then 4 linear sub-buckets per octave
+    // --------------------------------------------------------------------------
+
+    constexpr size_t kBuckets = 8 + 29 * 4; // covers the full uint32_t sample range
+
+    constexpr size_t bucket_of(uint32_t v) noexcept {
+        if (v < 8u) {
+            return v;
+        }
+        const unsigned e = 31u - static_cast<unsigned>(__builtin_clz(v)); // >= 3
+        const unsigned sub = (v >> (e - 2u)) & 3u;
+        return 8u + (e - 3u) * 4u + sub;
+    }
+
+    constexpr uint64_t bucket_lo(size_t b) noexcept {
+        if (b < 8u) {
+            return b;
+        }
+        const size_t e = (b - 8u) / 4u + 3u;
+        const uint64_t sub = (b - 8u) % 4u;
+        return (4u + sub) << (e - 2u);
+    }
+
+    static_assert(bucket_of(8) == 8 && bucket_lo(8) == 8);
+    static_assert(bucket_of(15) == 11 && bucket_lo(11) == 14);
+    static_assert(bucket_of(0xFFFF'FFFFu) == kBuckets - 1);
+
+    struct Stats {
+        uint64_t n = 0;
+        double mean = 0.0;
+        uint32_t min = 0, p50 = 0, p90 = 0, p99 = 0, p999 = 0, max = 0;
+        std::array<uint64_t, kBuckets> hist{};
+    };
+
+    // Sorts `samples` in place.
+    inline Stats summarize(std::vector<uint32_t> &samples) {
+        Stats s;
+        s.n = samples.size();
+        if (samples.empty()) {
+            return s;
+        }
+        std::sort(samples.begin(), samples.end());
+        const auto at = [&](double q) noexcept {
+            const size_t i = static_cast<size_t>(q * static_cast<double>(samples.size() - 1) + 0.5);
+            return samples[i];
+        };
+        uint64_t sum = 0;
+        for (const uint32_t v : samples) {
+            sum += v;
+            ++s.hist[bucket_of(v)];
+        }
+        s.mean = static_cast<double>(sum) / static_cast<double>(s.n);
+        s.min = samples.front();
+        s.p50 = at(0.50);
+        s.p90 = at(0.90);
+        s.p99 = at(0.99);
+        s.p999 = at(0.999);
+        s.max = samples.back();
+        return s;
+    }
+
+    // --------------------------------------------------------------------------
+    // PMU counters (perf_event_open, user space only). Each counter opens on its
+    // own so a VM without an L1i event still reports branch misses.
+    // --------------------------------------------------------------------------
+
+    enum Counter : size_t { Instructions, BranchMisses, L1iMisses, kCounters };
+
+    inline constexpr const char *kCounterNames[kCounters] = {"instructions", "branch_misses", "l1i_misses"};
+
+    struct PmuReading {
+        std::array<int64_t, kCounters> value{-1, -1, -1}; // -1 = unavailable
+    };
+
+    // One counter for the calling thread (perf_event_open pid 0, any CPU).
+    // Unavailable (stop() returns -1) when the event cannot be opened.
+    class PerfEvent {
+    public:
+        PerfEvent(uint32_t type, uint64_t config) noexcept {
+#if DODO_BENCH_HAS_PERF
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = type;
+            attr.config = config;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fd_ = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+#else
+            (void) type;
+            (void) config;
+#endif
+        }
+
+        ~PerfEvent() {
+#if DODO_BENCH_HAS_PERF
+            if (fd_ >= 0) {
+                ::close(fd_);
+            }
+#endif
+        }
+
+        PerfEvent(const PerfEvent &) = delete;
+        PerfEvent &operator=(const PerfEvent &) = delete;
+
+        bool available() const noexcept { return fd_ >= 0; }
+
+        void start() noexcept {
+#if DODO_BENCH_HAS_PERF
+            if (fd_ >= 0) {
+                ::ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+                ::ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+        }
+
+        int64_t stop() noexcept {
+#if DODO_BENCH_HAS_PERF
+            if (fd_ >= 0) {
+                ::ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+                uint64_t v = 0;
+                if (::read(fd_, &v, sizeof(v)) == static_cast<ssize_t>(sizeof(v))) {
+                    return static_cast<int64_t>(v);
+                }
+            }
+#endif
+            return -1;
+        }
+
+    private:
+        int fd_ = -1;
+    };
+
+    class Pmu {
+    public:
+#if DODO_BENCH_HAS_PERF
+        Pmu() noexcept
+            : events_{{{PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+                       {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+                       {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1I | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)}}} {}
+#else
+        Pmu() noexcept : events_{{{0, 0}, {0, 0}, {0, 0}}} {}
+#endif
+
+        bool available(Counter c) const noexcept { return events_[c].available(); }
+
+        void start() noexcept {
+            for (PerfEvent &e : events_) {
+                e.start();
+            }
+        }
+
+        PmuReading stop() noexcept {
+            PmuReading r;
+            for (size_t i = 0; i < kCounters; ++i) {
+                r.value[i] = events_[i].stop();
+            }
+            return r;
+        }
+
+    private:
+        std::array<PerfEvent, kCounters> events_;
+    };
+
+    // --------------------------------------------------------------------------
+    // Failure traces: which iterations fail when replaying realistic failure
+    // rates (all-pass / all-fail runs train the branch predictor perfectly)
+    // --------------------------------------------------------------------------
+
+    // splitmix64: same stream on every platform, so a seed reproduces a trace.
+    struct Rng {
+        uint64_t state;
+
+        uint64_t next() noexcept {
+            uint64_t z = (state += 0x9E37'79B9'7F4A'7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58'476D'1CE4'E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D0'49BB'1331'11EBull;
+            return z ^ (z >> 31);
+        }
+
+        double uniform() noexcept { return static_cast<double>(next() >> 11) * 0x1.0p-53; } // [0, 1)
+        uint64_t below(uint64_t n) noexcept { return n == 0 ? 0 : next() % n; }
+    };
+
+    // Independent failures at `rate`, or, with burst_enter > 0, a two-state
+    // (Gilbert-Elliott) stream: the quiet state fails at `rate`, the burst state
+    // at `burst_rate`. Each iteration enters a burst with probability
+    // burst_enter and leaves it with burst_exit (mean burst 1 / burst_exit).
+    struct TraceSpec {
+        const char *name;
+        double rate = 0.0;
+        double burst_enter = 0.0;
+        double burst_exit = 0.0;
+        double burst_rate = 0.0;
+    };
+
+    using Trace = std::vector<uint8_t>; // one flag per iteration, 1 = fails
+
+    inline Trace make_trace(size_t n, const TraceSpec &spec, uint64_t seed) {
+        Trace t(n);
+        Rng rng{seed};
+        bool burst = false;
+        for (uint8_t &f : t) {
+            if (spec.burst_enter > 0.0) {
+                burst = burst ? rng.uniform() >= spec.burst_exit : rng.uniform() < spec.burst_enter;
+            }
+            f = rng.uniform() < (burst ? spec.burst_rate : spec.rate);
+        }
+        return t;
+    }
+
+    // Recorded trace: '0' (passes) or '1' (fails) per iteration, whitespace
+    // ignored. Empty if any other character appears.
+    inline Trace read_trace(std::istream &is) {
+        Trace t;
+        for (char c; is.get(c);) {
+            if (c == '0' || c == '1') {
+                t.push_back(c == '1');
+            } else if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+                return {};
+            }
+        }
+        return t;
+    }
+
+    inline size_t trace_failures(const Trace &t) noexcept {
+        return static_cast<size_t>(std::count(t.begin(), t.end(), uint8_t{1}));
+    }
+
+    // --------------------------------------------------------------------------
+    // Runner
+    // --------------------------------------------------------------------------
+
+    struct Report {
+        std::string label;
+        Stats cycles; // per iteration, timer overhead subtracted
+        uint64_t ok_count = 0;
+        uint64_t fail_count = 0;
+        uint16_t sink = 0;
+        uint64_t mismatches = 0; // replay(): calls whose outcome disagreed with the trace
+        PmuReading pmu; // totals over the sampled iterations (timer included)
+    };
+
+    class Runner {
+    public:
+        Runner(size_t iterations, size_t warmup) : iterations_{iterations}, warmup_{warmup} {
+            samples_.resize(iterations_); // the only allocation; reused by every run
+            calibrate();
+        }
+
+        // Median cost of an empty timed region, subtracted from every sample.
+        uint32_t overhead() const noexcept { return overhead_; }
+        size_t iterations() const noexcept { return iterations_; }
+        const Pmu &pmu() const noexcept { return pmu_; }
+
+        // f() returns a Dodo::Status (anything with ok() and code).
+        template<class Fn>
+        Report run(const char *label, Fn &&f) {
+            Report r;
+            r.label = label;
+            for (size_t i = 0; i < warmup_; ++i) {
+                sink_ = static_cast<uint16_t>(sink_ ^ static_cast<uint16_t>(f().code));
+            }
+
+            uint64_t ok = 0, fail = 0;
+            pmu_.start();
+            for (size_t i = 0; i < iterations_; ++i) {
+                std::atomic_signal_fence(std::memory_order_seq_cst);
+                const uint64_t t0 = tsc_begin();
+                const auto s = f();
+                const uint64_t t1 = tsc_end();
+                std::atomic_signal_fence(std::memory_order_seq_cst);
+
+                ok += static_cast<uint64_t>(s.ok());
+                fail += static_cast<uint64_t>(!s.ok());
+                sink_ = static_cast<uint16_t>(sink_ ^ static_cast<uint16_t>(s.code));
+                samples_[i] = sample(t1 - t0);
+            }
+            r.pmu = pmu_.stop();
+
+            r.cycles = summarize(samples_);
+            r.ok_count = ok;
+            r.fail_count = fail;
+            r.sink = sink_;
+            return r;
+        }
+
+        // f(bool fail) returns a Dodo::Status and must fail exactly when `fail`
+        // is set. Iteration k (warm-up first) replays trace[k % size]; the flag
+        // is loaded before the timed region opens.
+        template<class Fn>
+        Report replay(const char *label, const Trace &trace, Fn &&f) {
+            Report r;
+            r.label = label;
+            if (trace.empty()) {
+                return r;
+            }
+            const size_t n = trace.size();
+            size_t k = 0;
+            for (size_t i = 0; i < warmup_; ++i, k = k + 1 == n ? 0 : k + 1) {
+                sink_ = static_cast<uint16_t>(sink_ ^ static_cast<uint16_t>(f(trace[k] != 0).code));
+            }
+
+            uint64_t ok = 0, fail = 0, mismatches = 0;
+            pmu_.start();
+            for (size_t i = 0; i < iterations_; ++i, k = k + 1 == n ? 0 : k + 1) {
+                const bool expect_fail = trace[k] != 0;
+                std::atomic_signal_fence(std::memory_order_seq_cst);
+                const uint64_t t0 = tsc_begin();
+                const auto s = f(expect_fail);
+                const uint64_t t1 = tsc_end();
+                std::atomic_signal_fence(std::memory_order_seq_cst);
+
+                ok += static_cast<uint64_t>(s.ok());
+                fail += static_cast<uint64_t>(!s.ok());
+                mismatches += static_cast<uint64_t>(s.ok() == expect_fail);
+                sink_ = static_cast<uint16_t>(sink_ ^ static_cast<uint16_t>(s.code));
+                samples_[i] = sample(t1 - t0);
+            }
+            r.pmu = pmu_.stop();
+
+            r.cycles = summarize(samples_);
+            r.ok_count = ok;
+            r.fail_count = fail;
+            r.mismatches = mismatches;
+            r.sink = sink_;
+            return r;
+        }
+
+    private:
+        uint32_t sample(uint64_t dt) const noexcept {
+            const uint64_t net = dt > overhead_ ? dt - overhead_ : 0;
+            return net > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(net);
+        }
+
+        void calibrate() {
+            constexpr size_t kRounds = 100'000;
+            std::vector<uint32_t> empty(kRounds);
+            for (size_t i = 0; i < kRounds; ++i) {
+                std::atomic_signal_fence(std::memory_order_seq_cst);
+                const uint64_t t0 = tsc_begin();
+                const uint64_t t1 = tsc_end();
+                std::atomic_signal_fence(std::memory_order_seq_cst);
+                const uint64_t dt = t1 - t0;
+                empty[i] = dt > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(dt);
+            }
+            std::nth_element(empty.begin(), empty.begin() + kRounds / 2, empty.end());
+            overhead_ = empty[kRounds / 2];
+        }
+
+        size_t iterations_;
+        size_t warmup_;
+        uint32_t overhead_ = 0;
+        std::vector<uint32_t> samples_;
+        Pmu pmu_;
+        static inline volatile uint16_t sink_ = 0;
+    };
+
+    // --------------------------------------------------------------------------
+    // Output
+    // --------------------------------------------------------------------------
+
+    struct RunInfo {
+        std::string config; // build label, e.g. "O3" (set by run_stresstest.sh)
+        const char *compiler = "";
+        const char *isa = "";
+        bool fast_mode = false;
+        int cpu = -1; // pinned CPU, -1 if not pinned
+        uint32_t timer_overhead = 0;
+        size_t iterations = 0;
+    };
+
+    inline std::string json_escape(const std::string &s) {
+        std::string out;
+        out.reserve(s.size());
+        for (const char c : s) {
+            if (c == '"' || c == '\\') {
+                out += '\\';
+                out += c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+                out += buf;
+            } else {
+                out += c;
+            }
+        }
+        return out;
+    }
+
+    // One JSON document: run metadata plus, per scenario, percentiles, PMU
+    // per-iteration averages (null when unavailable) and non-empty histogram
+    // buckets as [lower_bound_cycles, count] pairs.
+    inline void write_json(std::ostream &os, const RunInfo &info, const std::vector<Report> &reports) {
+        os << "{\n";
+        os << "  \"config\": \"" << json_escape(info.config) << "\",\n";
+        os << "  \"compiler\": \"" << json_escape(info.compiler) << "\",\n";
+        os << "  \"isa\": \"" << json_escape(info.isa) << "\",\n";
+        os << "  \"fast_mode\": " << (info.fast_mode ? "true" : "false") << ",\n";
+        os << "  \"cpu\": " << info.cpu << ",\n";
+        os << "  \"timer_overhead_cycles\": " << info.timer_overhead << ",\n";
+        os << "  \"iterations\": " << info.iterations << ",\n";
+        os << "  \"scenarios\": [\n";
+        for (size_t i = 0; i < reports.size(); ++i) {
+            const Report &r = reports[i];
+            const Stats &c = r.cycles;
+            os << "    {\"name\": \"" << json_escape(r.label) << "\", "
+               << "\"ok\": " << r.ok_count << ", \"fail\": " << r.fail_count << ",\n"
+               << "     \"cycles\": {\"mean\": " << c.mean << ", \"min\": " << c.min
+               << ", \"p50\": " << c.p50 << ", \"p90\": " << c.p90 << ", \"p99\": " << c.p99
+               << ", \"p999\": " << c.p999 << ", \"max\": " << c.max << "},\n"
+               << "     \"pmu_per_iter\": {";
+            for (size_t k = 0; k < kCounters; ++k) {
+                os << (k ? ", " : "") << '"' << kCounterNames[k] << "\": ";
+                if (r.pmu.value[k] < 0 || c.n == 0) {
+                    os << "null";
+                } else {
+                    os << static_cast<double>(r.pmu.value[k]) / static_cast<double>(c.n);
+                }
+            }
+            os << "},\n     \"histogram\": [";
+            bool first = true;
+            for (size_t b = 0; b < kBuckets; ++b) {
+                if (c.hist[b] == 0) {
+                    continue;
+                }
+                os << (first ? "" : ", ") << '[' << bucket_lo(b) << ", " << c.hist[b] << ']';
+                first = false;
+            }
+            os << "]}" << (i + 1 < reports.size() ? "," : "") << "\n";
+        }
+        os << "  ]\n}\n";
+    }
+
+    // One row per scenario; PMU columns are per iteration, empty when unavailable.
+    inline void write_csv(std::ostream &os, const RunInfo &info, const std::vector<Report> &reports) {
+        os << "config,scenario,mean,min,p50,p90,p99,p999,max,ok,fail";
+        for (const char *name : kCounterNames) {
+            os << ',' << name;
+        }
+        os << '\n';
+        for (const Report &r : reports) {
+            const Stats &c = r.cycles;
+            os << info.config << ",\"" << r.label << "\"," << c.mean << ',' << c.min << ',' << c.p50 << ','
+               << c.p90 << ',' << c.p99 << ',' << c.p999 << ',' << c.max << ',' << r.ok_count << ','
+               << r.fail_count;
+            for (size_t k = 0; k < kCounters; ++k) {
+                os << ',';
+                if (r.pmu.value[k] >= 0 && c.n != 0) {
+                    os << static_cast<double>(r.pmu.value[k]) / static_cast<double>(c.n);
+                }
+            }
+            os << '\n';
+        }
+    }
+
+    // --------------------------------------------------------------------------
+    // Baseline comparison (reads the CSV written by write_csv)
+    // --------------------------------------------------------------------------
+
+    struct BaselineRow {
+        std::string scenario;
+        uint32_t p50 = 0;
+        uint32_t p99 = 0;
+    };
+
+    inline std::vector<BaselineRow> read_baseline_csv(std::istream &is) {
+        std::vector<BaselineRow> rows;
+        std::string line;
+        std::getline(is, line); // header
+        while (std::getline(is, line)) {
+            // config,"scenario",mean,min,p50,p90,p99,...
+            const size_t q0 = line.find('"');
+            const size_t q1 = q0 == std::string::npos ? q0 : line.find('"', q0 + 1);
+            if (q1 == std::string::npos) {
+                continue;
+            }
+            std::array<uint64_t, 5> f{}; // mean, min, p50, p90, p99
+            size_t pos = q1 + 1;
+            for (uint64_t &v : f) {
+                if (pos >= line.size() || line[pos] != ',') {
+                    break;
+                }
+                v = std::strtoull(line.c_str() + pos + 1, nullptr, 10);
+                pos = line.find(',', pos + 1);
+            }
+            rows.push_back({line.substr(q0 + 1, q1 - q0 - 1), static_cast<uint32_t>(f[2]), static_cast<uint32_t>(f[4])});
+        }
+        return rows;
+    }
+
+    // A metric regresses when it exceeds the baseline by more than `pct` percent
+    // AND by more than `slack` cycles (TSC granularity makes tiny p50s jumpy).
+    // Prints one line per regression; scenarios missing from the baseline are
+    // reported but never fail. Returns the number of regressions.
+    inline size_t compare_to_baseline(std::ostream &os, const std::vector<Report> &reports,
+                                      const std::vector<BaselineRow> &baseline, double pct, uint32_t slack) {
+        const auto regressed = [&](uint32_t now, uint32_t base) {
+            return now > base + slack && static_cast<double>(now) > static_cast<double>(base) * (1.0 + pct / 100.0);
+        };
+        size_t regressions = 0;
+        for (const Report &r : reports) {
+            const auto it = std::find_if(baseline.begin(), baseline.end(),
+                                         [&](const BaselineRow &b) { return b.scenario == r.label; });
+            if (it == baseline.end()) {
+                os << "  NEW        " << r.label << '\n';
+                continue;
+            }
+            const struct {
+                const char *name;
+                uint32_t now, base;
+            } metrics[] = {{"p50", r.cycles.p50, it->p50}, {"p99", r.cycles.p99, it->p99}};
+            for (const auto &m : metrics) {
+                if (regressed(m.now, m.base)) {
+                    os << "  REGRESSION " << r.label << ' ' << m.name << ": " << m.base << " -> " << m.now << " cycles\n";
+                    ++regressions;
+                }
+            }
+        }
+        return regressions;
+    }
+
+    // Text histogram of the buckets holding 99.9% of samples (the rest is
+    // summarized as the max).
+    inline void print_histogram(std::ostream &os, const Report &r, size_t width = 50) {
+        const Stats &c = r.cycles;
+        uint64_t peak = 0;
+        for (const uint64_t h : c.hist) {
+            peak = std::max(peak, h);
+        }
+        if (peak == 0) {
+            return;
+        }
+        os << r.label << " (cycles, max " << c.max << ")\n";
+        const size_t last = bucket_of(c.p999);
+        for (size_t b = bucket_of(c.min); b <= last; ++b) {
+            const size_t bar = static_cast<size_t>(static_cast<double>(c.hist[b]) / static_cast<double>(peak) *
+                                                   static_cast<double>(width));
+            char lo[24];
+            std::snprintf(lo, sizeof(lo), "%8llu", static_cast<unsigned long long>(bucket_lo(b)));
+            os << "  " << lo << " | " << std::string(bar, '#') << ' ' << c.hist[b] << '\n';
+        }
+    }
+}
+
+#endif
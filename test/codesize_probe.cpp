@@ -0,0 +1,83 @@
+// Runtime half of run_codesize.sh: calls the generated corpus functions (N
+// passing checks each) back to back and counts cycles, instructions and L1i
+// misses per call (perf_event_open through bench::Pmu; "n/a" where the PMU is
+// not exposed, e.g. most VMs). Dodo sites keep a compare, a branch and a
+// jump to .text.unlikely in the hot stream, so 1000 of them fit in L1i; the
+// naive corpus formats its message inline, as a hand-written
+// `if (!ok) { snprintf(...); }` does, and streams through the I-cache.
+// Linked against the generated corpus object; never part of the library.
+#include <cstdint>
+#include <cstdio>
+
+#include "Dodo.hpp"
+#include "bench.hpp"
+
+#ifndef CORPUS_SITES
+#error "build with -DCORPUS_SITES=<N> (run_codesize.sh does)"
+#endif
+
+extern "C" {
+    Dodo::Status corpus_require_n(const int *a) noexcept;
+    Dodo::Status corpus_range_n(const int *a) noexcept;
+    Dodo::Status corpus_naive_n(const int *a) noexcept;
+}
+
+namespace {
+    constexpr int kCalls = 20'000;
+    constexpr int kWarmup = 200;
+
+    struct Row {
+        const char *label;
+        Dodo::Status (*fn)(const int *) noexcept;
+    };
+
+    void format_per(char *buf, size_t cap, int64_t total, double div) {
+        if (total < 0) {
+            std::snprintf(buf, cap, "n/a");
+        } else {
+            std::snprintf(buf, cap, "%.3f", static_cast<double>(total) / div);
+        }
+    }
+}
+
+int main() {
+    static int input[CORPUS_SITES];
+    for (int i = 0; i < CORPUS_SITES; ++i) {
+        input[i] = i + 5; // passes a[i] > i and a[i] in [0, i + 10]
+    }
+
+    const Row rows[] = {
+        {"DODO_REQUIRE", corpus_require_n},
+        {"DODO_CHECK_RANGE", corpus_range_n},
+        {"naive inline snprintf", corpus_naive_n},
+    };
+
+    bench::Pmu pmu;
+    std::printf("%d passing checks per call, %d calls\n", CORPUS_SITES, kCalls);
+    std::printf("%-24s %12s %12s %14s %14s\n", "corpus", "cycles/call", "instr/call", "L1i miss/call", "L1i miss/site");
+    uint32_t failed = 0;
+    for (const Row &r : rows) {
+        for (int w = 0; w < kWarmup; ++w) {
+            failed += !r.fn(input).ok();
+        }
+        pmu.start();
+        const uint64_t t0 = __rdtsc();
+        for (int c = 0; c < kCalls; ++c) {
+            failed += !r.fn(input).ok();
+        }
+        const uint64_t cycles = __rdtsc() - t0;
+        const bench::PmuReading pr = pmu.stop();
+
+        char instr[32], miss[32], miss_site[32];
+        format_per(instr, sizeof(instr), pr.value[bench::Instructions], kCalls);
+        format_per(miss, sizeof(miss), pr.value[bench::L1iMisses], kCalls);
+        format_per(miss_site, sizeof(miss_site), pr.value[bench::L1iMisses], double(kCalls) * CORPUS_SITES);
+        std::printf("%-24s %12.1f %12s %14s %14s\n", r.label, static_cast<double>(cycles) / kCalls, instr, miss,
+                    miss_site);
+    }
+    if (failed != 0) {
+        std::fprintf(stderr, "codesize_probe: %u corpus calls failed; inputs out of sync with the generator\n", failed);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,365 @@
+// Multi-core failure storm: how many threads can share one fallback policy
+// before dispatch or counting becomes the bottleneck. Every thread fails
+// DODO_REQUIREs back to back; the sweep runs 1, 2, 4, ... up to every allowed
+// CPU, pinned compact (fill a NUMA node before the next) or spread
+// (round-robin over nodes), and compares:
+//
+//   hook + shared atomic     global hook, handler bumps one shared counter
+//   hook + Dodo::Stats       global hook, per-thread counter rows (stats_fallback)
+//   hook swapped + Stats     as above while thread 0 re-stores the hook every
+//                            256 failures (a live policy change under load)
+//   ScopedFallback + Stats   per-thread override, the global hook is never read
+//   Policy<stats_fallback>   compile-time policy, direct call, no hook load
+//
+// Per thread count it reports failures/s in total and per thread, scaling
+// against one thread, and per failure the LLC misses and remote-node
+// (NUMA) loads from perf_event_open. Those two count cache-line transfers
+// between cores and sockets; both are "n/a" where the PMU is not exposed.
+//
+// Usage: contention_bench [--threads N] [--iters N] [--placement compact|spread|none] [--csv PATH|-]
+// Built and run by MODE=contention ./run_stresstest.sh. Not part of the library.
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Dodo.hpp"
+#include "bench.hpp"
+
+namespace {
+    enum class Dispatch { SharedAtomic, Stats, StatsSwapped, ThreadOverride, StaticPolicy };
+
+    struct Variant {
+        const char* name;
+        Dispatch dispatch;
+    };
+
+    constexpr Variant kVariants[] = {
+        {"hook + shared atomic", Dispatch::SharedAtomic},
+        {"hook + Dodo::Stats", Dispatch::Stats},
+        {"hook swapped + Stats", Dispatch::StatsSwapped},
+        {"ScopedFallback + Stats", Dispatch::ThreadOverride},
+        {"Policy<stats_fallback>", Dispatch::StaticPolicy},
+    };
+
+    constexpr uint32_t kSwapEvery = 256; // failures between hook stores in StatsSwapped
+
+#if DODO_BENCH_HAS_PERF
+    constexpr uint32_t kLlcType = PERF_TYPE_HARDWARE;
+    constexpr uint64_t kLlcConfig = PERF_COUNT_HW_CACHE_MISSES;
+    constexpr uint32_t kNodeType = PERF_TYPE_HW_CACHE;
+    constexpr uint64_t kNodeConfig = PERF_COUNT_HW_CACHE_NODE | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                     (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+#else
+    constexpr uint32_t kLlcType = 0, kNodeType = 0;
+    constexpr uint64_t kLlcConfig = 0, kNodeConfig = 0;
+#endif
+
+    std::atomic<uint64_t> g_shared_failures{0};
+
+    Dodo::Status shared_atomic_fallback(const Dodo::Failure& f) noexcept {
+        g_shared_failures.fetch_add(1, std::memory_order_relaxed);
+        return Dodo::Status::fail(f.code);
+    }
+
+    // stats_fallback under a second address, so every swap really changes the hook.
+    Dodo::Status stats_fallback_alt(const Dodo::Failure& f) noexcept {
+        return Dodo::stats_fallback(f);
+    }
+
+    using StatsPolicy = Dodo::Policy<Dodo::default_panic, Dodo::stats_fallback>;
+
+    template<class P>
+    DODO_NOINLINE void fail_loop(uint64_t iters, bool swapper) noexcept {
+        for (uint64_t i = 0; i < iters; ++i) {
+            (void)Dodo::basic_require<P>(false, Dodo::Code::PreconditionFailed,
+                DODO_MAKE_FAIL(Dodo::Severity::Recoverable, Dodo::Code::PreconditionFailed, "storm"));
+            if (swapper && (i % kSwapEvery) == kSwapEvery - 1) {
+                Dodo::set_fallback_handler((i / kSwapEvery) % 2 ? Dodo::stats_fallback : stats_fallback_alt);
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Topology (Linux sysfs; elsewhere every CPU is node 0, package 0)
+    // ------------------------------------------------------------------------
+
+    struct Cpu {
+        int id;
+        int node;
+        int package;
+    };
+
+    // "0-3,8,10-11" -> {0,1,2,3,8,10,11}
+    std::vector<int> parse_cpulist(const std::string& s) {
+        std::vector<int> out;
+        const char* p = s.c_str();
+        while (*p != '\0') {
+            char* end = nullptr;
+            const long lo = std::strtol(p, &end, 10);
+            if (end == p) break;
+            long hi = lo;
+            p = end;
+            if (*p == '-') {
+                hi = std::strtol(p + 1, &end, 10);
+                p = end;
+            }
+            for (long c = lo; c <= hi; ++c) out.push_back(static_cast<int>(c));
+            while (*p == ',' || *p == '\n' || *p == ' ') ++p;
+        }
+        return out;
+    }
+
+    int read_int(const std::string& path, int fallback) {
+        std::ifstream in(path);
+        int v = fallback;
+        return (in >> v) ? v : fallback;
+    }
+
+    std::vector<Cpu> allowed_cpus() {
+        std::vector<Cpu> cpus;
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (int c = 0; c < CPU_SETSIZE; ++c) {
+                if (CPU_ISSET(static_cast<size_t>(c), &set)) {
+                    const std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(c);
+                    cpus.push_back({c, 0, read_int(base + "/topology/physical_package_id", 0)});
+                }
+            }
+        }
+        for (int n = 0; n < 1024; ++n) {
+            std::ifstream in("/sys/devices/system/node/node" + std::to_string(n) + "/cpulist");
+            std::string list;
+            if (!std::getline(in, list)) continue;
+            for (const int c : parse_cpulist(list)) {
+                for (Cpu& cpu : cpus) {
+                    if (cpu.id == c) cpu.node = n;
+                }
+            }
+        }
+#endif
+        if (cpus.empty()) {
+            const unsigned hw = std::thread::hardware_concurrency();
+            for (unsigned c = 0; c < (hw ? hw : 1u); ++c) cpus.push_back({static_cast<int>(c), 0, 0});
+        }
+        return cpus;
+    }
+
+    // compact: node by node (threads share a socket as long as possible).
+    // spread: one CPU from each node in turn (cross-node from 2 threads on).
+    std::vector<Cpu> place(std::vector<Cpu> cpus, const std::string& placement) {
+        std::stable_sort(cpus.begin(), cpus.end(), [](const Cpu& a, const Cpu& b) {
+            return a.node != b.node ? a.node < b.node : a.package != b.package ? a.package < b.package : a.id < b.id;
+        });
+        if (placement != "spread") return cpus;
+        std::vector<Cpu> out;
+        std::vector<size_t> next;
+        std::vector<int> nodes;
+        for (const Cpu& c : cpus) {
+            if (nodes.empty() || nodes.back() != c.node) nodes.push_back(c.node);
+        }
+        next.assign(nodes.size(), 0);
+        while (out.size() < cpus.size()) {
+            for (size_t n = 0; n < nodes.size(); ++n) {
+                size_t seen = 0;
+                for (const Cpu& c : cpus) {
+                    if (c.node != nodes[n]) continue;
+                    if (seen++ == next[n]) {
+                        out.push_back(c);
+                        ++next[n];
+                        break;
+                    }
+                }
+            }
+        }
+        return out;
+    }
+
+    // ------------------------------------------------------------------------
+    // One storm
+    // ------------------------------------------------------------------------
+
+    struct Sample {
+        double seconds = 0.0;
+        uint64_t failures = 0; // counted by the handler, checked against threads * iters
+        int64_t llc_misses = 0; // summed over threads, -1 if any thread could not count
+        int64_t node_misses = 0;
+    };
+
+    void add_counter(std::atomic<int64_t>& total, int64_t v) noexcept {
+        if (v < 0) {
+            total.store(-1, std::memory_order_relaxed);
+            return;
+        }
+        for (int64_t cur = total.load(std::memory_order_relaxed);
+             cur >= 0 && !total.compare_exchange_weak(cur, cur + v, std::memory_order_relaxed);) {
+        }
+    }
+
+    uint64_t handled_failures(Dispatch d) noexcept {
+        return d == Dispatch::SharedAtomic ? g_shared_failures.load(std::memory_order_relaxed)
+                                           : Dodo::stats().count(Dodo::Code::PreconditionFailed);
+    }
+
+    Sample run_storm(Dispatch d, const std::vector<Cpu>& cpus, bool pin, size_t threads, uint64_t iters) {
+        Dodo::set_fallback_handler(d == Dispatch::SharedAtomic ? shared_atomic_fallback : Dodo::stats_fallback);
+        const uint64_t before = handled_failures(d);
+
+        std::atomic<size_t> ready{0};
+        std::atomic<bool> go{false};
+        std::atomic<int64_t> llc{0}, node{0};
+        std::vector<std::thread> pool;
+        pool.reserve(threads);
+        for (size_t t = 0; t < threads; ++t) {
+            pool.emplace_back([&, t] {
+                if (pin) (void)bench::pin_to_core(cpus[t % cpus.size()].id);
+                bench::PerfEvent llc_ev{kLlcType, kLlcConfig};
+                bench::PerfEvent node_ev{kNodeType, kNodeConfig};
+                ready.fetch_add(1, std::memory_order_release);
+                while (!go.load(std::memory_order_acquire)) {
+                    _mm_pause();
+                }
+                llc_ev.start();
+                node_ev.start();
+                if (d == Dispatch::StaticPolicy) {
+                    fail_loop<StatsPolicy>(iters, false);
+                } else if (d == Dispatch::ThreadOverride) {
+                    Dodo::ScopedFallback local{Dodo::stats_fallback};
+                    fail_loop<Dodo::RuntimePolicy>(iters, false);
+                } else {
+                    fail_loop<Dodo::RuntimePolicy>(iters, d == Dispatch::StatsSwapped && t == 0);
+                }
+                add_counter(llc, llc_ev.stop());
+                add_counter(node, node_ev.stop());
+            });
+        }
+        while (ready.load(std::memory_order_acquire) != threads) {
+            std::this_thread::yield();
+        }
+        const auto t0 = std::chrono::steady_clock::now();
+        go.store(true, std::memory_order_release);
+        for (std::thread& th : pool) th.join();
+        Sample s;
+        s.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        s.failures = handled_failures(d) - before;
+        s.llc_misses = llc.load(std::memory_order_relaxed);
+        s.node_misses = node.load(std::memory_order_relaxed);
+        Dodo::set_fallback_handler(nullptr);
+        return s;
+    }
+
+    std::string per_failure(int64_t total, uint64_t failures) {
+        if (total < 0 || failures == 0) return "n/a";
+        std::ostringstream os;
+        os << std::fixed << std::setprecision(3) << static_cast<double>(total) / static_cast<double>(failures);
+        return os.str();
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t max_threads = 0;
+    uint64_t iters = 200'000;
+    std::string placement = "compact";
+    const char* csv_path = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (a == "--threads" && i + 1 < argc) max_threads = std::strtoul(argv[++i], nullptr, 10);
+        else if (a == "--iters" && i + 1 < argc) iters = std::strtoull(argv[++i], nullptr, 10);
+        else if (a == "--placement" && i + 1 < argc) placement = argv[++i];
+        else if (a == "--csv" && i + 1 < argc) csv_path = argv[++i];
+        else {
+            std::cerr << "usage: " << argv[0] << " [--threads N] [--iters N] [--placement compact|spread|none]"
+                      << " [--csv PATH|-]" << std::endl;
+            return 2;
+        }
+    }
+    if (placement != "compact" && placement != "spread" && placement != "none") {
+        std::cerr << "unknown placement " << placement << " (compact|spread|none)" << std::endl;
+        return 2;
+    }
+
+    const std::vector<Cpu> cpus = place(allowed_cpus(), placement);
+    if (max_threads == 0) max_threads = cpus.size();
+    std::vector<int> nodes, packages;
+    for (const Cpu& c : cpus) {
+        if (std::find(nodes.begin(), nodes.end(), c.node) == nodes.end()) nodes.push_back(c.node);
+        if (std::find(packages.begin(), packages.end(), c.package) == packages.end()) packages.push_back(c.package);
+    }
+    std::vector<size_t> counts;
+    for (size_t n = 1; n < max_threads; n *= 2) counts.push_back(n);
+    counts.push_back(max_threads);
+
+    std::cout << "Failure storm: " << iters << " failures per thread, " << cpus.size() << " CPUs allowed, "
+              << nodes.size() << " NUMA node(s), " << packages.size() << " package(s), placement " << placement;
+    if (max_threads > cpus.size()) std::cout << " (oversubscribed past " << cpus.size() << " threads)";
+    std::cout << std::endl;
+
+    std::ofstream csv_file;
+    std::ostream* csv = nullptr;
+    if (csv_path != nullptr) {
+        if (std::strcmp(csv_path, "-") == 0) {
+            csv = &std::cout;
+        } else {
+            csv_file.open(csv_path);
+            csv = &csv_file;
+        }
+        *csv << "variant,placement,threads,nodes_used,seconds,failures,mfail_s,mfail_s_per_thread,scaling,"
+                "llc_miss_per_fail,node_miss_per_fail\n";
+    }
+
+    int rc = 0;
+    for (const Variant& v : kVariants) {
+        std::cout << '\n' << v.name << std::endl;
+        std::cout << std::left << std::setw(9) << "Threads" << std::setw(7) << "Nodes" << std::setw(10) << "Mfail/s"
+                  << std::setw(12) << "per thread" << std::setw(9) << "scaling" << std::setw(14) << "LLCmiss/fail"
+                  << "NodeMiss/fail" << std::endl;
+        double single = 0.0;
+        size_t shares = 0; // most threads still at >= 80% of the one-thread rate
+        for (const size_t n : counts) {
+            const Sample s = run_storm(v.dispatch, cpus, placement != "none", n, iters);
+            const uint64_t expected = static_cast<uint64_t>(n) * iters;
+            if (s.failures != expected) {
+                std::cerr << v.name << ": " << s.failures << " failures counted, expected " << expected << std::endl;
+                rc = 1;
+            }
+            const double rate = static_cast<double>(expected) * 1e-6 / s.seconds;
+            const double per_thread = rate / static_cast<double>(n);
+            if (n == 1) single = per_thread;
+            const double scaling = single > 0.0 ? per_thread / single : 0.0;
+            if (scaling >= 0.8) shares = n;
+            std::vector<int> used;
+            for (size_t t = 0; t < n && placement != "none"; ++t) {
+                const int node = cpus[t % cpus.size()].node;
+                if (std::find(used.begin(), used.end(), node) == used.end()) used.push_back(node);
+            }
+            std::cout << std::left << std::setw(9) << n << std::setw(7) << used.size() << std::fixed
+                      << std::setprecision(1) << std::setw(10) << rate << std::setw(12) << per_thread
+                      << std::setprecision(2) << std::setw(9) << scaling << std::setw(14)
+                      << per_failure(s.llc_misses, expected) << per_failure(s.node_misses, expected) << std::endl;
+            if (csv != nullptr) {
+                *csv << std::defaultfloat << std::setprecision(6) << v.name << ',' << placement << ',' << n << ',' << used.size() << ',' << s.seconds << ','
+                     << s.failures << ',' << rate << ',' << per_thread << ',' << scaling << ','
+                     << (s.llc_misses < 0 ? "" : per_failure(s.llc_misses, expected)) << ','
+                     << (s.node_misses < 0 ? "" : per_failure(s.node_misses, expected)) << '\n';
+            }
+        }
+        std::cout << "  shares to " << shares << " thread(s) at >= 80% of the one-thread rate" << std::endl;
+    }
+    if (csv_file.is_open() && !csv_file) {
+        std::cerr << "failed to write " << csv_path << std::endl;
+        rc = 1;
+    }
+    return rc;
+}
@@ -0,0 +1,161 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+# Failure-path code-size / I-cache check for the DODO_COLD + DODO_NOINLINE claim.
+#
+# Generates a corpus of SITES check sites per kind (DODO_REQUIRE, DODO_CHECK_RANGE,
+# and a naive baseline that formats its message inline), compiles it per
+# configuration and reports from the object's symbol table:
+#   hot B/site   .text growth of the N-site function over the 1-site one
+#   cold B/site  growth of its `.cold` part (the per-site failure stubs)
+#   split        the function's cold part exists and sits in .text.unlikely
+#   endpoints    every Dodo fail_* endpoint is in .text.unlikely
+# A configuration fails when a Dodo corpus exceeds its hot budget in bytes per
+# site, when a configuration expected to split (GCC only partitions functions
+# at -O2 and above) has no .cold part, or when a Dodo endpoint leaves
+# .text.unlikely: the ways a compiler change can quietly pull the failure path
+# back into the hot stream. -Os keeps the per-site stubs inside the function,
+# so it is held to the looser OS_BUDGET. Results go to $OUTDIR/codesize.csv.
+#
+# RUN=1 also links test/codesize_probe.cpp against the O3 corpus and prints
+# cycles, instructions and L1i misses per call (perf_event_open).
+#
+# Usage: ./run_codesize.sh            SITES=1000 HOT_BUDGET=32 OS_BUDGET=64 RUN=1 ./run_codesize.sh
+OUTDIR="${OUTDIR:-./dodo_builds/codesize}"
+SITES="${SITES:-1000}"
+HOT_BUDGET="${HOT_BUDGET:-32}"
+OS_BUDGET="${OS_BUDGET:-64}"
+RUN="${RUN:-0}"
+CSV="$OUTDIR/codesize.csv"
+CORPUS="$OUTDIR/corpus.cpp"
+
+COMMON_WARN="-Wall -Wextra -Wpedantic -Werror -Wconversion -Wsign-conversion -Wshadow -Wundef -Wdouble-promotion -Wcast-align -Wcast-qual -Wformat=2 -Wnull-dereference"
+COMMON_BASE="-std=c++20 -fno-exceptions -fno-rtti -pthread -I.. -I."
+
+# tag|expects split|flags
+CONFIGS=(
+  "O3|yes|-O3 -DNDEBUG"
+  "O2|yes|-O2 -DNDEBUG"
+  "Os|no|-Os -DNDEBUG"
+  "fast_O3|yes|-O3 -DNDEBUG -DDODO_FAST_MODE"
+  "compact_O3|yes|-O3 -DNDEBUG -DDODO_COMPACT_MODE"
+  "nopayload_O3|yes|-O3 -DNDEBUG -DDODO_NO_FAILURE_PAYLOAD"
+  "native_O3|yes|-O3 -DNDEBUG -march=native"
+)
+
+if (( SITES < 2 )); then
+  echo "SITES must be at least 2" >&2
+  exit 2
+fi
+mkdir -p "$OUTDIR"
+
+# corpus_<kind>_1 / corpus_<kind>_n: 1 and SITES checks on a[i]. Inputs a[i] = i + 5
+# pass every check (codesize_probe.cpp relies on it).
+gen_fn() {
+  # $1 = kind, $2 = suffix, $3 = number of sites
+  echo "extern \"C\" Dodo::Status corpus_$1_$2(const int *a) noexcept {"
+  local i
+  for ((i = 0; i < $3; ++i)); do
+    case "$1" in
+      require) echo "    DODO_TRY(DODO_REQUIRE(a[$i] > $i, Dodo::Code::OutOfRange));" ;;
+      range)   echo "    DODO_TRY(DODO_CHECK_RANGE(a[$i], 0, $((i + 10)), Dodo::Code::OutOfRange));" ;;
+      naive)   echo "    if (!(a[$i] > $i)) { char m[96]; std::snprintf(m, sizeof(m), \"%s:%d: a[%d]=%d\", __FILE__, __LINE__, $i, a[$i]); naive_report(m); return Dodo::Status::fail(Dodo::Code::OutOfRange); }" ;;
+    esac
+  done
+  echo "    return Dodo::Status::ok_status();"
+  echo "}"
+}
+
+{
+  echo "// Generated by run_codesize.sh (SITES=$SITES). Do not edit."
+  echo "#include <cstdio>"
+  echo "#include \"Dodo.hpp\""
+  echo "static volatile char g_naive_sink;"
+  echo "extern \"C\" __attribute__((noinline)) void naive_report(const char *m) noexcept { g_naive_sink = m[0]; }"
+  for kind in require range naive; do
+    gen_fn "$kind" 1 1
+    gen_fn "$kind" n "$SITES"
+  done
+} > "$CORPUS"
+
+# "<section> <size> <name>" for every function symbol. objdump -t prints
+# "<addr> <flags> <section>\t<size> <name>"; flags contain F for functions.
+fn_symbols() {
+  objdump -t "$1" | awk -F'\t' '
+    function hex(s,   v, i, c) { v = 0; for (i = 1; i <= length(s); ++i) { c = index("0123456789abcdef", substr(s, i, 1)); v = v * 16 + c - 1 } return v }
+    NF == 2 && substr($1, 18, 7) ~ /F/ {
+      n = split($1, head, " "); split($2, tail, " ")
+      print head[n], hex(tail[1]), tail[2]
+    }'
+}
+
+sym_size() {
+  # $1 = symbols file, $2 = name
+  awk -v n="$2" '$3 == n { print $2; found = 1 } END { if (!found) print 0 }' "$1"
+}
+
+sym_section() {
+  awk -v n="$2" '$3 == n { print $1; found = 1 } END { if (!found) print "-" }' "$1"
+}
+
+per_site() {
+  # $1 = N-site bytes, $2 = 1-site bytes
+  awk -v a="$1" -v b="$2" -v n="$SITES" 'BEGIN { printf "%.1f", (a - b) / (n - 1) }'
+}
+
+FAILED=()
+echo "config,kind,sites,hot_bytes_per_site,cold_bytes_per_site,split,endpoints_in_unlikely" > "$CSV"
+printf "%-14s %-8s %12s %12s %7s %10s\n" config kind "hot B/site" "cold B/site" split endpoints
+for entry in "${CONFIGS[@]}"; do
+  IFS='|' read -r tag want_split flags <<< "$entry"
+  budget=$HOT_BUDGET
+  [[ "$want_split" == no ]] && budget=$OS_BUDGET
+  obj="$OUTDIR/corpus_$tag.o"
+  if ! g++ $COMMON_BASE $flags $COMMON_WARN -c "$CORPUS" -o "$obj" 2> "$OUTDIR/corpus_$tag.log"; then
+    FAILED+=("$tag: build (see $OUTDIR/corpus_$tag.log)")
+    continue
+  fi
+  syms="$OUTDIR/corpus_$tag.syms"
+  fn_symbols "$obj" > "$syms"
+
+  # Dodo cold endpoints (basic_fail_*, fail_*_at) outside .text.unlikely; the
+  # warm endpoint of DODO_REQUIRE_EXPECT is out of line but deliberately not cold.
+  stray=$(awk '$3 ~ /^_ZN4Dodo.*fail_/ && $3 !~ /fail_recoverable_warm/ && $1 !~ /^\.text\.unlikely/ { print $3 }' "$syms" | sort -u)
+  endpoints=yes
+  if [[ -n "$stray" ]]; then
+    endpoints=no
+    FAILED+=("$tag: cold endpoint outside .text.unlikely: $(echo "$stray" | c++filt | tr '\n' ' ')")
+  fi
+
+  for kind in require range naive; do
+    hot=$(per_site "$(sym_size "$syms" "corpus_${kind}_n")" "$(sym_size "$syms" "corpus_${kind}_1")")
+    cold=$(per_site "$(sym_size "$syms" "corpus_${kind}_n.cold")" "$(sym_size "$syms" "corpus_${kind}_1.cold")")
+    split=no
+    [[ "$(sym_section "$syms" "corpus_${kind}_n.cold")" == .text.unlikely* ]] && split=yes
+    printf "%-14s %-8s %12s %12s %7s %10s\n" "$tag" "$kind" "$hot" "$cold" "$split" "$endpoints"
+    echo "$tag,$kind,$SITES,$hot,$cold,$split,$endpoints" >> "$CSV"
+    [[ "$kind" == naive ]] && continue
+    if awk -v h="$hot" -v b="$budget" 'BEGIN { exit !(h > b) }'; then
+      FAILED+=("$tag: $kind hot path $hot B/site > budget $budget")
+    fi
+    if [[ "$want_split" == yes && "$split" == no ]]; then
+      FAILED+=("$tag: $kind has no .cold part in .text.unlikely")
+    fi
+  done
+done
+
+if [[ "$RUN" == 1 ]]; then
+  exe="$OUTDIR/codesize_probe"
+  if g++ $COMMON_BASE -O3 -DNDEBUG -DCORPUS_SITES="$SITES" $COMMON_WARN codesize_probe.cpp "$OUTDIR/corpus_O3.o" -o "$exe"; then
+    echo
+    "$exe" || FAILED+=("codesize_probe: exit $?")
+  else
+    FAILED+=("codesize_probe: build")
+  fi
+fi
+
+echo "Per-site sizes in: $CSV"
+if (( ${#FAILED[@]} )); then
+  printf 'FAILED: %s\n' "${FAILED[@]}"
+  exit 1
+fi
@@ -1,11 +1,33 @@
 set -euo pipefail
 
-SRC="stresstest.cpp"
+# MODE=bench (default): build + run every config, write JSON/CSV per config to
+#   $OUTDIR/results and diff each benchmarked config against $BASELINE_DIR/<tag>.csv.
+#   A p50 or p99 worse than THRESHOLD percent (and SLACK cycles) fails the sweep.
+#   UPDATE_BASELINE=1 copies this run's CSVs into $BASELINE_DIR instead.
+# MODE=size: build only and report .text/.rodata per config ($OUTDIR/sizes.csv),
+#   with deltas against $BASELINE_DIR/sizes.csv when present.
+# MODE=contention: build contention_bench.cpp (-O3) and run the multi-core failure
+#   storm sweep once per placement (compact, spread) into $RESULTS/contention_<placement>.csv.
+#   THREADS and ITERS override the thread ceiling (all allowed CPUs) and failures per thread.
+SRC="stresstest.cpp stresstest_tu.cpp"
 OUTDIR="${OUTDIR:-./dodo_builds}"
 LOG="${LOG:-./dodo_all_results.txt}"
+MODE="${MODE:-bench}"
+BASELINE_DIR="${BASELINE_DIR:-./dodo_baseline}"
+THRESHOLD="${THRESHOLD:-10}"
+SLACK="${SLACK:-2}"
+UPDATE_BASELINE="${UPDATE_BASELINE:-0}"
+RESULTS="$OUTDIR/results"
+SIZES="$OUTDIR/sizes.csv"
 
-mkdir -p "$OUTDIR"
+case "$MODE" in
+  bench|size|contention) ;;
+  *) echo "unknown MODE=$MODE (bench|size|contention)" >&2; exit 2 ;;
+esac
+
+mkdir -p "$OUTDIR" "$RESULTS"
 : > "$LOG"
+FAILED=()
 
 ts() { date +"%Y-%m-%d %H:%M:%S"; }
 
@@ -21,27 +43,86 @@ append() {
   } >> "$LOG"
 }
 
+# "section size" for .text/.rodata from `size -A`.
+section_size() {
+  size -A "$1" | awk -v sec="$2" '$1 == sec { print $2; found=1 } END { if (!found) print 0 }'
+}
+
+size_row() {
+  # $1 = tag, $2 = exe
+  local text rodata base_text base_rodata
+  text=$(section_size "$2" .text)
+  rodata=$(section_size "$2" .rodata)
+  echo "$1,$text,$rodata" >> "$SIZES"
+  if [[ -f "$BASELINE_DIR/sizes.csv" ]] && grep -q "^$1," "$BASELINE_DIR/sizes.csv"; then
+    IFS=, read -r _ base_text base_rodata < <(grep "^$1," "$BASELINE_DIR/sizes.csv")
+    printf "%-22s .text %8s (%+d)  .rodata %8s (%+d)\n" "$1" "$text" $((text - base_text)) "$rodata" $((rodata - base_rodata))
+  else
+    printf "%-22s .text %8s  .rodata %8s\n" "$1" "$text" "$rodata"
+  fi
+}
+
+# .text bytes per check site from size_probe.cpp (nm symbol sizes, 33 vs 1 checks).
+per_check_size() {
+  # $1 = label, rest = extra compile flags
+  local label="$1"; shift
+  local obj="$OUTDIR/size_probe.o"
+  if ! g++ $COMMON_BASE -Os -DNDEBUG "$@" $COMMON_WARN -c size_probe.cpp -o "$obj" >>"$LOG" 2>&1; then
+    FAILED+=("size_probe $label: build")
+    return 0
+  fi
+  nm -S "$obj" | awk -v l="$label" '
+    { n = $4; sub(/^_Z[0-9]+/, "", n); sub(/PKi$/, "", n); sz[n] = ("0x" $2) + 0 }
+    END { printf "%-22s require %5.1f B/check   check_range %5.1f B/check\n", l,
+          (sz["require_33"] - sz["require_1"]) / 32, (sz["range_33"] - sz["range_1"]) / 32 }'
+  rm -f "$obj"
+}
+
 run_one() {
   local label="$1"
   local compile_cmd="$2"
   local exe="$3"
   local run_cmd="$4"
+  local tag="$5"
+  local gate="$6" # 1 = benchmark numbers are meaningful (optimized, no sanitizer)
 
   append "$label (BUILD)" "$compile_cmd"
   if eval "$compile_cmd" >>"$LOG" 2>&1; then
     echo "[OK] build: $label" >>"$LOG"
   else
     echo "[FAIL] build: $label" >>"$LOG"
-    return 1
+    FAILED+=("$tag: build")
+    return 0
+  fi
+
+  if [[ "$MODE" == size ]]; then
+    size_row "$tag" "$exe" | tee -a "$LOG"
+    rm -f "$exe"
+    return 0
+  fi
+
+  local args="--config $tag --json \"$RESULTS/$tag.json\" --csv \"$RESULTS/$tag.csv\""
+  if [[ "$gate" == 1 && "$UPDATE_BASELINE" != 1 && -f "$BASELINE_DIR/$tag.csv" ]]; then
+    args="$args --baseline \"$BASELINE_DIR/$tag.csv\" --threshold $THRESHOLD --slack $SLACK"
   fi
 
-  append "$label (RUN)" "$run_cmd"
+  append "$label (RUN)" "$run_cmd $args"
   # run (do not stop whole script on runtime failure; record status)
   set +e
-  eval "$run_cmd" >>"$LOG" 2>&1
+  eval "$run_cmd $args" >>"$LOG" 2>&1
   local rc=$?
   set -e
   echo "[EXIT CODE] $rc" >>"$LOG"
+  case "$rc" in
+    0) ;;
+    3) FAILED+=("$tag: benchmark regression") ;;
+    *) FAILED+=("$tag: exit $rc") ;;
+  esac
+
+  if [[ "$gate" == 1 && "$UPDATE_BASELINE" == 1 && -f "$RESULTS/$tag.csv" ]]; then
+    mkdir -p "$BASELINE_DIR"
+    cp "$RESULTS/$tag.csv" "$BASELINE_DIR/$tag.csv"
+  fi
 
   # cleanup exe
   rm -f "$exe"
@@ -50,65 +131,173 @@ run_one() {
 }
 
 COMMON_WARN="-Wall -Wextra -Wpedantic -Werror -Wconversion -Wsign-conversion -Wshadow -Wundef -Wdouble-promotion -Wcast-align -Wcast-qual -Wformat=2 -Wnull-dereference"
-COMMON_BASE="-std=c++20 -fno-exceptions -fno-rtti -pthread"
+COMMON_BASE="-std=c++20 -fno-exceptions -fno-rtti -pthread -I.."
 
-echo "Dodo build+run sweep started at $(ts)" >>"$LOG"
+echo "Dodo build+run sweep started at $(ts) (MODE=$MODE)" >>"$LOG"
+[[ "$MODE" == size ]] && echo "config,text,rodata" > "$SIZES"
 echo "Source: $SRC" >>"$LOG"
 echo "Output dir: $OUTDIR" >>"$LOG"
 
+if [[ "$MODE" == contention ]]; then
+  EXEC="$OUTDIR/contention_bench"
+  CMDC="g++ $COMMON_BASE -O3 -DNDEBUG -march=native -mtune=native $COMMON_WARN contention_bench.cpp -o \"$EXEC\""
+  append "contention_bench (BUILD)" "$CMDC"
+  if ! eval "$CMDC" >>"$LOG" 2>&1; then
+    echo "FAILED: contention_bench: build (see $LOG)"
+    exit 1
+  fi
+  for placement in compact spread; do
+    args="--placement $placement --csv \"$RESULTS/contention_$placement.csv\""
+    [[ -n "${THREADS:-}" ]] && args="$args --threads $THREADS"
+    [[ -n "${ITERS:-}" ]] && args="$args --iters $ITERS"
+    append "contention_bench $placement (RUN)" "$EXEC $args"
+    set +e
+    eval "\"$EXEC\" $args" 2>&1 | tee -a "$LOG"
+    rc=${PIPESTATUS[0]}
+    set -e
+    [[ "$rc" == 0 ]] || FAILED+=("contention $placement: exit $rc")
+  done
+  rm -f "$EXEC"
+  echo "Per-placement CSV in: $RESULTS"
+  if (( ${#FAILED[@]} )); then
+    printf 'FAILED: %s\n' "${FAILED[@]}"
+    exit 1
+  fi
+  exit 0
+fi
+
 # 0) O3 strict
 EXE0="$OUTDIR/dodo_test_O3"
-CMD0="g++ $COMMON_BASE -O3 -DNDEBUG -march=native -mtune=native $COMMON_WARN \"$SRC\" -o \"$EXE0\""
+CMD0="g++ $COMMON_BASE -O3 -DNDEBUG -march=native -mtune=native $COMMON_WARN $SRC -o \"$EXE0\""
 RUN0="\"$EXE0\""
-run_one "O3 strict" "$CMD0" "$EXE0" "$RUN0"
+run_one "O3 strict" "$CMD0" "$EXE0" "$RUN0" O3 1
 
 # 1) O3 + LTO
 EXE1="$OUTDIR/dodo_test_O3_lto"
-CMD1="g++ $COMMON_BASE -O3 -DNDEBUG -march=native -mtune=native -flto -fuse-linker-plugin $COMMON_WARN \"$SRC\" -o \"$EXE1\""
+CMD1="g++ $COMMON_BASE -O3 -DNDEBUG -march=native -mtune=native -flto -fuse-linker-plugin $COMMON_WARN $SRC -o \"$EXE1\""
 RUN1="\"$EXE1\""
-run_one "O3 + LTO" "$CMD1" "$EXE1" "$RUN1"
+run_one "O3 + LTO" "$CMD1" "$EXE1" "$RUN1" O3_lto 1
 
 # 2) Debug
 EXE2="$OUTDIR/dodo_test_dbg"
-CMD2="g++ $COMMON_BASE -O0 -g3 $COMMON_WARN \"$SRC\" -o \"$EXE2\""
+CMD2="g++ $COMMON_BASE -O0 -g3 $COMMON_WARN $SRC -o \"$EXE2\""
 RUN2="\"$EXE2\""
-run_one "Debug O0" "$CMD2" "$EXE2" "$RUN2"
+run_one "Debug O0" "$CMD2" "$EXE2" "$RUN2" dbg 0
 
 # 3) FAST_MODE
 EXE3="$OUTDIR/dodo_test_fast_O3"
-CMD3="g++ $COMMON_BASE -O3 -DNDEBUG -DDODO_FAST_MODE -march=native -mtune=native $COMMON_WARN \"$SRC\" -o \"$EXE3\""
+CMD3="g++ $COMMON_BASE -O3 -DNDEBUG -DDODO_FAST_MODE -march=native -mtune=native $COMMON_WARN $SRC -o \"$EXE3\""
 RUN3="\"$EXE3\""
-run_one "FAST_MODE O3" "$CMD3" "$EXE3" "$RUN3"
+run_one "FAST_MODE O3" "$CMD3" "$EXE3" "$RUN3" fast_O3 1
 
 # 4) ASan + UBSan
 EXE4="$OUTDIR/dodo_test_asan_ubsan"
-CMD4="g++ $COMMON_BASE -O1 -g3 -fsanitize=address,undefined -fno-sanitize-recover=all -fno-omit-frame-pointer $COMMON_WARN \"$SRC\" -o \"$EXE4\""
+CMD4="g++ $COMMON_BASE -O1 -g3 -fsanitize=address,undefined -fno-sanitize-recover=all -fno-omit-frame-pointer $COMMON_WARN $SRC -o \"$EXE4\""
 RUN4="ASAN_OPTIONS=detect_leaks=1:halt_on_error=1:abort_on_error=1 UBSAN_OPTIONS=halt_on_error=1:print_stacktrace=1 \"$EXE4\""
-run_one "ASan+UBSan O1" "$CMD4" "$EXE4" "$RUN4"
+run_one "ASan+UBSan O1" "$CMD4" "$EXE4" "$RUN4" asan_ubsan 0
 
 # 5) UBSan only
 EXE5="$OUTDIR/dodo_test_ubsan"
-CMD5="g++ $COMMON_BASE -O1 -g3 -fsanitize=undefined -fno-sanitize-recover=all -fno-omit-frame-pointer $COMMON_WARN \"$SRC\" -o \"$EXE5\""
+CMD5="g++ $COMMON_BASE -O1 -g3 -fsanitize=undefined -fno-sanitize-recover=all -fno-omit-frame-pointer $COMMON_WARN $SRC -o \"$EXE5\""
 RUN5="UBSAN_OPTIONS=halt_on_error=1:print_stacktrace=1 \"$EXE5\""
-run_one "UBSan O1" "$CMD5" "$EXE5" "$RUN5"
+run_one "UBSan O1" "$CMD5" "$EXE5" "$RUN5" ubsan 0
 
 # 6) TSan
 EXE6="$OUTDIR/dodo_test_tsan"
-CMD6="g++ $COMMON_BASE -O1 -g3 -fsanitize=thread -fno-omit-frame-pointer $COMMON_WARN \"$SRC\" -o \"$EXE6\""
+CMD6="g++ $COMMON_BASE -O1 -g3 -fsanitize=thread -fno-omit-frame-pointer $COMMON_WARN $SRC -o \"$EXE6\""
 RUN6="TSAN_OPTIONS=halt_on_error=1:second_deadlock_stack=1 \"$EXE6\""
-run_one "TSan O1" "$CMD6" "$EXE6" "$RUN6"
+run_one "TSan O1" "$CMD6" "$EXE6" "$RUN6" tsan 0
 
 # 7) g++ -Os
 EXE7="$OUTDIR/dodo_test_Os"
-CMD7="g++ $COMMON_BASE -Os -DNDEBUG $COMMON_WARN \"$SRC\" -o \"$EXE7\""
+CMD7="g++ $COMMON_BASE -Os -DNDEBUG $COMMON_WARN $SRC -o \"$EXE7\""
 RUN7="\"$EXE7\""
-run_one "Os size" "$CMD7" "$EXE7" "$RUN7"
+run_one "Os size" "$CMD7" "$EXE7" "$RUN7" Os 1
+
+# 8) constinit handler table defined in one TU (DODO_EXTERN_HANDLER_TABLE)
+EXE8="$OUTDIR/dodo_test_extern_table"
+CMD8="g++ $COMMON_BASE -O3 -DNDEBUG -DDODO_EXTERN_HANDLER_TABLE $COMMON_WARN $SRC -o \"$EXE8\""
+RUN8="\"$EXE8\""
+run_one "EXTERN_HANDLER_TABLE O3" "$CMD8" "$EXE8" "$RUN8" extern_table 1
+
+# 9) COMPACT_MODE: 8-byte Failure with 32-bit site IDs, plus the offline sidecar map
+EXE9="$OUTDIR/dodo_test_compact_O3"
+CMD9="g++ $COMMON_BASE -O3 -DNDEBUG -DDODO_COMPACT_MODE -march=native -mtune=native $COMMON_WARN $SRC -o \"$EXE9\""
+RUN9="\"$EXE9\""
+run_one "COMPACT_MODE O3" "$CMD9" "$EXE9" "$RUN9" compact_O3 1
+
+# 10) Contract levels: QA build with *_AUDIT contracts on, release build with stripped invariants as assumptions
+EXE10="$OUTDIR/dodo_test_audit_O3"
+CMD10="g++ $COMMON_BASE -O3 -DNDEBUG -DDODO_CONTRACT_LEVEL=DODO_CONTRACT_AUDIT -march=native -mtune=native $COMMON_WARN $SRC -o \"$EXE10\""
+RUN10="\"$EXE10\""
+run_one "CONTRACT_LEVEL=AUDIT O3" "$CMD10" "$EXE10" "$RUN10" audit_O3 0
+
+EXE11="$OUTDIR/dodo_test_assume_O3"
+CMD11="g++ $COMMON_BASE -O3 -DNDEBUG -DDODO_CONTRACT_ASSUME -march=native -mtune=native $COMMON_WARN $SRC -o \"$EXE11\""
+RUN11="\"$EXE11\""
+run_one "CONTRACT_ASSUME O3" "$CMD11" "$EXE11" "$RUN11" assume_O3 0
+
+# 12) Site profile round trip: a DODO_SITE_PROFILE build exports per-site pass
+# rates, dodo_profgen turns them into a header, and the O3 build consumes it.
+PROF="$OUTDIR/stresstest.prof"
+PROF_HDR="$(cd "$OUTDIR" && pwd)/stresstest_profile.h" # absolute: #include resolves from Dodo.hpp
+EXE12="$OUTDIR/dodo_test_site_profile_O3"
+CMD12="g++ $COMMON_BASE -O3 -DNDEBUG -DDODO_SITE_PROFILE -march=native -mtune=native $COMMON_WARN $SRC -o \"$EXE12\""
+RUN12="\"$EXE12\" --site-profile \"$PROF\""
+run_one "SITE_PROFILE O3 (collect)" "$CMD12" "$EXE12" "$RUN12" site_profile_O3 0
+
+PROFTOOL="$OUTDIR/dodo_profgen"
+append "Site profile header" "dodo_profgen $PROF > $PROF_HDR"
+if [[ "$MODE" != size ]] && g++ $COMMON_BASE -O2 $COMMON_WARN ../tools/dodo_profgen.cpp -o "$PROFTOOL" >>"$LOG" 2>&1 &&
+   "$PROFTOOL" "$PROF" > "$PROF_HDR" 2>>"$LOG"; then
+  EXE13="$OUTDIR/dodo_test_profiled_O3"
+  CMD13="g++ $COMMON_BASE -O3 -DNDEBUG -DDODO_SITE_PROFILE_HEADER='\"$PROF_HDR\"' -march=native -mtune=native $COMMON_WARN $SRC -o \"$EXE13\""
+  RUN13="\"$EXE13\""
+  run_one "SITE_PROFILE_HEADER O3 (use)" "$CMD13" "$EXE13" "$RUN13" profiled_O3 1
+elif [[ "$MODE" != size ]]; then
+  echo "[FAIL] site profile header" >>"$LOG"
+  FAILED+=("profiled_O3: dodo_profgen")
+fi
+
+MAPTOOL="$OUTDIR/dodo_sitemap"
+MAP="$OUTDIR/stresstest.dodomap"
+append "COMPACT_MODE site map" "dodo_sitemap < g++ -E $SRC > $MAP"
+if g++ $COMMON_BASE -O2 $COMMON_WARN ../tools/dodo_sitemap.cpp -o "$MAPTOOL" >>"$LOG" 2>&1 &&
+   for f in $SRC; do g++ $COMMON_BASE -DNDEBUG -DDODO_COMPACT_MODE -E "$f"; done | "$MAPTOOL" > "$MAP" 2>>"$LOG"; then
+  echo "[OK] site map: $(wc -l < "$MAP") sites -> $MAP" >>"$LOG"
+else
+  echo "[FAIL] site map (build error or ID collision)" >>"$LOG"
+  FAILED+=("compact_O3: site map")
+fi
 
 echo >>"$LOG"
 echo "Dodo build+run sweep finished at $(ts)" >>"$LOG"
 echo "Log saved to: $LOG" >>"$LOG"
 
+if [[ "$MODE" == size ]]; then
+  echo "Per-check .text at -Os (size_probe.cpp):" | tee -a "$LOG"
+  per_check_size "full" | tee -a "$LOG"
+  per_check_size "FAST_MODE" -DDODO_FAST_MODE | tee -a "$LOG"
+  per_check_size "COMPACT_MODE" -DDODO_COMPACT_MODE | tee -a "$LOG"
+  per_check_size "CONTRACT_LEVEL=ALWAYS" -DDODO_CONTRACT_LEVEL=DODO_CONTRACT_ALWAYS | tee -a "$LOG"
+  per_check_size "NO_FAILURE_PAYLOAD" -DDODO_NO_FAILURE_PAYLOAD | tee -a "$LOG"
+fi
+
+if [[ "$MODE" == size && "$UPDATE_BASELINE" == 1 ]]; then
+  mkdir -p "$BASELINE_DIR"
+  cp "$SIZES" "$BASELINE_DIR/sizes.csv"
+fi
 
 #opt
 echo "Done. Results in: $LOG"
+if [[ "$MODE" == bench ]]; then
+  echo "Per-config JSON/CSV in: $RESULTS"
+  grep -h "REGRESSION" "$LOG" || true
+else
+  echo "Section sizes in: $SIZES"
+fi
+if (( ${#FAILED[@]} )); then
+  printf 'FAILED: %s\n' "${FAILED[@]}"
+  exit 1
+fi
 
@@ -0,0 +1,30 @@
+// Code-size probe for run_stresstest.sh (MODE=size): .text bytes added per check
+// site = (size(checks_33) - size(checks_1)) / 32. Compiled only, never run.
+#include "Dodo.hpp"
+
+#define PROBE_REQUIRE(i) DODO_TRY(DODO_REQUIRE(a[i] > (i), Dodo::Code::OutOfRange));
+#define PROBE_RANGE(i)   DODO_TRY(DODO_CHECK_RANGE(a[i], 0, (i) + 10, Dodo::Code::OutOfRange));
+#define PROBE_X8(m, i)   m(i) m(i + 1) m(i + 2) m(i + 3) m(i + 4) m(i + 5) m(i + 6) m(i + 7)
+#define PROBE_X32(m)     PROBE_X8(m, 1) PROBE_X8(m, 9) PROBE_X8(m, 17) PROBE_X8(m, 25)
+
+Dodo::Status require_1(const int *a) noexcept {
+    PROBE_REQUIRE(0)
+    return Dodo::Status::ok_status();
+}
+
+Dodo::Status require_33(const int *a) noexcept {
+    PROBE_REQUIRE(0)
+    PROBE_X32(PROBE_REQUIRE)
+    return Dodo::Status::ok_status();
+}
+
+Dodo::Status range_1(const int *a) noexcept {
+    PROBE_RANGE(0)
+    return Dodo::Status::ok_status();
+}
+
+Dodo::Status range_33(const int *a) noexcept {
+    PROBE_RANGE(0)
+    PROBE_X32(PROBE_RANGE)
+    return Dodo::Status::ok_status();
+}
@@ -3,11 +3,18 @@
 #include <cstdlib>
 #include <cstring>
 #include <atomic>
+#include <chrono>
 #include <thread>
 #include <string>
 #include <iostream>
 #include <vector>
 #include <iomanip>
+#include <sstream>
+#include <array>
+#include <algorithm>
+#include <limits>
+#include <span>
+#include <fstream>
 #include <x86intrin.h>
 
 #if defined(__linux__) || defined(__APPLE__)
@@ -19,8 +26,20 @@
 #endif
 
 #include "Dodo.hpp"
+#include "DodoFormat.hpp"
+#include "DodoParallel.hpp"
+#include "bench.hpp"
 
+#if DODO_HAS_FORK
+    #include "DodoReporter.hpp"
+    #include <sys/mman.h>
+    #include <sys/socket.h>
+#endif
+
+#ifndef ITERATIONS
 #define ITERATIONS 1'000'000
+#endif
+#define WARMUP_ITERATIONS 10'000
 
 // --- Mock Hardware / State ---
 struct MockMarketData {
@@ -35,15 +54,6 @@ struct MockDMA {
     size_t alignment;
 };
 
-// --- Statistics Tracking ---
-struct BenchResult {
-    const char* label;
-    uint64_t total_cycles;
-    double   avg;
-    uint64_t ok_count;
-    uint64_t fail_count;
-    uint16_t sink;
-};
 
 // --- Minimal Test Harness ---
 static int g_test_failures = 0;
@@ -78,8 +88,31 @@ struct FailureSnapshot {
     const char* file{nullptr};
     uint32_t line{0};
     const char* func{nullptr};
+    const Dodo::Site* site{nullptr};
+    uintptr_t site_bits{0}; // site identity in every mode (compact: the site ID)
+    bool has_payload{false};
+    Dodo::FailurePayload payload{};
+    char text[96]{}; // Dodo::describe_failure
 };
 
+static FailureSnapshot snapshot_of(const Dodo::Failure& f) noexcept {
+#ifdef DODO_COMPACT_MODE
+    FailureSnapshot snap{f.code, f.sev, nullptr, nullptr, 0, nullptr, nullptr, f.site_id};
+#else
+    const Dodo::Site* s = f.site;
+    FailureSnapshot snap{f.code, f.sev, nullptr, nullptr, 0, nullptr, nullptr, 0};
+    if (s != nullptr) {
+        snap = FailureSnapshot{f.code, f.sev, s->expr, s->file, s->line, s->func, s, Dodo::internal::site_bits(f)};
+    }
+#endif
+    if (const Dodo::FailurePayload* p = Dodo::payload_of(f)) {
+        snap.has_payload = true;
+        snap.payload = *p;
+        (void)Dodo::describe_failure(f, snap.text, sizeof(snap.text));
+    }
+    return snap;
+}
+
 static std::atomic<uint64_t> g_recoverable_hits{0};
 static std::atomic<bool> g_panic_triggered{false};
 static FailureSnapshot g_last_failure{};
@@ -87,7 +120,7 @@ static FailureSnapshot g_last_failure{};
 // Snapshotting fallback handler (single-thread use)
 Dodo::Status recording_fallback_handler(const Dodo::Failure& f) noexcept {
     g_recoverable_hits.fetch_add(1, std::memory_order_relaxed);
-    g_last_failure = FailureSnapshot{f.code, f.sev, f.expr, f.file, f.line, f.func};
+    g_last_failure = snapshot_of(f);
     return Dodo::Status::fail(f.code);
 }
 
@@ -101,10 +134,92 @@ Dodo::Status counting_fallback_handler(const Dodo::Failure& f) noexcept {
 // Panic handler: exit with code (used for death tests via fork)
 [[noreturn]] void stress_panic_handler(const Dodo::Failure& f) noexcept {
     g_panic_triggered.store(true, std::memory_order_relaxed);
-    g_last_failure = FailureSnapshot{f.code, f.sev, f.expr, f.file, f.line, f.func};
+    g_last_failure = snapshot_of(f);
     std::exit(static_cast<int>(f.code));
 }
 
+// Compile-time policies: direct-call fallback vs the runtime hook
+static std::atomic<uint64_t> g_policy_hits{0};
+Dodo::Status policy_fallback_handler(const Dodo::Failure& f) noexcept {
+    g_policy_hits.fetch_add(1, std::memory_order_relaxed);
+    return Dodo::Status::fail(f.code);
+}
+using StaticPolicy = Dodo::Policy<stress_panic_handler, policy_fallback_handler>;
+using TrivialPolicy = Dodo::Policy<Dodo::default_panic, Dodo::default_fallback>;
+
+// Pre-atomic hook layout (plain static pointer), kept as a benchmark baseline.
+static Dodo::FallbackFn g_plain_fallback = Dodo::default_fallback;
+struct PlainHookPolicy {
+    static void panic(const Dodo::Failure& f) noexcept { stress_panic_handler(f); }
+    static Dodo::Status fallback(const Dodo::Failure& f) noexcept { return g_plain_fallback(f); }
+};
+
+// Cold-path logging: binary records (formatted later by the reader) vs text formatted in the handler.
+static unsigned char g_encoded_log[4096];
+static size_t g_encoded_used = 0;
+Dodo::Status encoding_fallback_handler(const Dodo::Failure& f) noexcept {
+    if (sizeof(g_encoded_log) - g_encoded_used < Dodo::kMaxEncodedFailure) g_encoded_used = 0; // wrap
+    g_encoded_used += Dodo::encode_failure(f, g_encoded_log + g_encoded_used, sizeof(g_encoded_log) - g_encoded_used);
+    return Dodo::Status::fail(f.code);
+}
+
+static char g_text_log[256];
+Dodo::Status text_fallback_handler(const Dodo::Failure& f) noexcept {
+#ifdef DODO_COMPACT_MODE
+    int w = std::snprintf(g_text_log, sizeof(g_text_log), "%s site:%08x: ", Dodo::code_name(f.code), unsigned(f.site_id));
+#else
+    const Dodo::Site* s = f.site;
+    int w = std::snprintf(g_text_log, sizeof(g_text_log), "%s %s:%u %s: ", Dodo::code_name(f.code),
+                          s && s->file ? s->file : "?", s ? s->line : 0u, s && s->expr ? s->expr : "");
+#endif
+    const size_t n = w > 0 && size_t(w) < sizeof(g_text_log) ? size_t(w) : 0;
+    (void)Dodo::describe_failure(f, g_text_log + n, sizeof(g_text_log) - n);
+    return Dodo::Status::fail(f.code);
+}
+
+static std::atomic<uint64_t> g_scoped_hits{0};
+Dodo::Status scoped_fallback_handler(const Dodo::Failure&) noexcept {
+    g_scoped_hits.fetch_add(1, std::memory_order_relaxed);
+    return Dodo::Status::fail(Dodo::Code::ExternalFault);
+}
+
+// Threaded failure storm: `threads` workers released together, each failing
+// `iters` DODO_REQUIREs through the current fallback handler. Returns wall seconds.
+constexpr int kThreadedFailures = 800'000;
+constexpr size_t kParallelOrders = 200'000;
+constexpr int kStatsOverflowThreads = DODO_STATS_THREADS + 8;
+
+static double run_failing_threads(int threads, int iters) {
+    std::atomic<bool> go{false};
+    std::vector<std::thread> th;
+    th.reserve(static_cast<size_t>(threads));
+    for (int t = 0; t < threads; ++t) {
+        th.emplace_back([&go, iters]{
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (int i = 0; i < iters; ++i) {
+                (void)DODO_REQUIRE(false, Dodo::Code::PreconditionFailed);
+            }
+        });
+    }
+    const auto t0 = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& x : th) x.join();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// Manually advanced clock for deadline tests (ticks are ns).
+struct TestClock {
+    static inline uint64_t ticks = 0;
+    static uint64_t now() noexcept { return ticks; }
+    static uint64_t ticks_from_ns(uint64_t ns) noexcept { return ns; }
+};
+
+// Defined in stresstest_tu.cpp (separate translation unit).
+Dodo::Status other_tu_require(bool cond) noexcept;
+Dodo::FallbackFn other_tu_fallback_handler() noexcept;
+
 // ---Scenarios ---
 Dodo::Status scenario_nested_logic(const MockMarketData& md) noexcept {
     DODO_TRY(DODO_REQUIRE(md.price > 0.0, Dodo::Code::PreconditionFailed));
@@ -132,10 +247,420 @@ Dodo::Status scenario_local_fallback(bool fail) noexcept {
     return Dodo::fallback_or(s, local_recovery_action);
 }
 
+// Value-carrying chain: out-parameter leaf (Status) vs Result<T> leaf.
+// Leaves are noinline so the benchmark sees the real calling convention.
+DODO_NOINLINE Dodo::Status parse_volume_out(const MockMarketData& md, uint32_t* out) noexcept {
+    DODO_TRY(DODO_REQUIRE(md.volume > 0, Dodo::Code::PreconditionFailed));
+    *out = md.volume;
+    return Dodo::Status::ok_status();
+}
+
+DODO_NOINLINE Dodo::Result<uint32_t> parse_volume(const MockMarketData& md) noexcept {
+    DODO_TRY(DODO_REQUIRE(md.volume > 0, Dodo::Code::PreconditionFailed));
+    return Dodo::Result<uint32_t>::ok_result(md.volume);
+}
+
+Dodo::Status scenario_status_chain(const MockMarketData& md, uint32_t* out) noexcept {
+    uint32_t vol = 0;
+    DODO_TRY(parse_volume_out(md, &vol));
+    DODO_TRY(DODO_CHECK_RANGE(vol, 1u, 1'000'000u, Dodo::Code::OutOfRange));
+    *out = vol * 2u;
+    return Dodo::Status::ok_status();
+}
+
+Dodo::Result<uint32_t> scenario_result_chain(const MockMarketData& md) noexcept {
+    DODO_TRY_ASSIGN(const uint32_t vol, parse_volume(md));
+    DODO_TRY(DODO_CHECK_RANGE(vol, 1u, 1'000'000u, Dodo::Code::OutOfRange));
+    return Dodo::Result<uint32_t>::ok_result(vol * 2u);
+}
+
+// Notional = px * qty, overflow detected by division (the hand-rolled baseline) vs CPU flags.
+DODO_NOINLINE Dodo::Result<int64_t> scenario_notional_div(int64_t px, int64_t qty) noexcept {
+    DODO_TRY(DODO_REQUIRE(qty == 0 || (px <= INT64_MAX / qty && px >= INT64_MIN / qty), Dodo::Code::Overflow));
+    return Dodo::Result<int64_t>::ok_result(px * qty);
+}
+
+DODO_NOINLINE Dodo::Result<int64_t> scenario_notional_checked(int64_t px, int64_t qty) noexcept {
+    return DODO_CHECK_MUL(px, qty);
+}
+
+// Every edge-value pair: portable_*_overflow agrees with the builtin on the flag and the wrapped result.
+template<class T, class B>
+bool portable_overflow_matches() noexcept {
+    auto edges = [](auto zero) {
+        using V = decltype(zero);
+        const V lo = std::numeric_limits<V>::min();
+        const V hi = std::numeric_limits<V>::max();
+        return std::array<V, 9>{lo, static_cast<V>(lo + 1), static_cast<V>(lo / 2), V{0}, V{1}, static_cast<V>(V{0} - V{1}),
+                                static_cast<V>(hi / 2), static_cast<V>(hi - 1), hi};
+    };
+    for (const T a : edges(T{})) {
+        for (const B b : edges(B{})) {
+            T r1{}, r2{};
+            if (Dodo::internal::add_overflow(a, b, &r1) != Dodo::internal::portable_add_overflow(a, b, &r2) || r1 != r2 ||
+                Dodo::internal::sub_overflow(a, b, &r1) != Dodo::internal::portable_sub_overflow(a, b, &r2) || r1 != r2 ||
+                Dodo::internal::mul_overflow(a, b, &r1) != Dodo::internal::portable_mul_overflow(a, b, &r2) || r1 != r2) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Batch notional for a 10-level book side (price x size per level).
+constexpr size_t kNotionalLevels = 16;
+
+DODO_NOINLINE Dodo::Status scenario_notional_all(const int32_t* px, const int32_t* qty, int32_t* out) noexcept {
+    return DODO_CHECK_MUL_ALL(std::span<const int32_t>(px, kNotionalLevels), std::span<const int32_t>(qty, kNotionalLevels),
+                              std::span<int32_t>(out, kNotionalLevels));
+}
+
+// 10-level book, 4 fields per level (bid/ask px and qty), one range contract each.
+constexpr size_t kBookFields = 40;
+
+Dodo::Status scenario_book_scalar(const int32_t* fields) noexcept {
+    for (size_t i = 0; i < kBookFields; ++i) {
+        DODO_TRY(DODO_CHECK_RANGE(fields[i], 0, 1'000'000, Dodo::Code::OutOfRange));
+    }
+    return Dodo::Status::ok_status();
+}
+
+Dodo::Status scenario_book_batched(const int32_t* fields) noexcept {
+    return DODO_CHECK_RANGE_ALL(std::span<const int32_t>(fields, kBookFields), 0, 1'000'000, Dodo::Code::OutOfRange);
+}
+
+// Same check plus an O(n) "fields sorted" audit invariant: free unless DODO_CONTRACT_AUDIT.
+Dodo::Status scenario_book_audited(const int32_t* fields) noexcept {
+    DODO_INVARIANT_AUDIT(std::is_sorted(fields, fields + kBookFields), Dodo::Code::InvariantBroken);
+    return DODO_CHECK_RANGE_ALL(std::span<const int32_t>(fields, kBookFields), 0, 1'000'000, Dodo::Code::OutOfRange);
+}
+
+// Static instrument table validated at compile time with the same checks used at runtime.
+struct MockInstrument {
+    uint32_t tick;
+    uint32_t lot;
+    uint64_t mmio_base;
+};
+
+constexpr MockInstrument kInstruments[] = {{1, 100, 0x1000}, {5, 10, 0x2040}, {25, 1, 0x30C0}};
+
+constexpr Dodo::Status validate_instruments(std::span<const MockInstrument> table) noexcept {
+    for (const MockInstrument& i : table) {
+        DODO_TRY(DODO_CHECK_RANGE(i.tick, 1u, 100u, Dodo::Code::OutOfRange));
+        DODO_TRY(DODO_REQUIRE(i.lot != 0, Dodo::Code::PreconditionFailed));
+        DODO_TRY(DODO_CHECK_ALIGNED(i.mmio_base, 64, Dodo::Code::Misaligned));
+        DODO_TRY_ASSIGN(const uint32_t notional_unit, DODO_CHECK_MUL(i.tick, i.lot));
+        DODO_TRY(DODO_CHECK_NARROW(uint16_t, notional_unit));
+        DODO_INVARIANT(i.tick <= 100u, Dodo::Code::InvariantBroken);
+    }
+    return Dodo::Status::ok_status();
+}
+
+static_assert(validate_instruments(kInstruments).ok());
+static_assert(Dodo::fallback_or(Dodo::Status::ok_status(), nullptr).ok());
+static_assert(sizeof(Dodo::Result<uint16_t>) == 4);
+// A failed Status converts into a Result; an ok Status must not become an ok Result.
+static_assert(Dodo::Result<uint32_t>{Dodo::Status::fail(Dodo::Code::Timeout)}.code == Dodo::Code::Timeout);
+static_assert(Dodo::Result<uint32_t>{Dodo::Status::ok_status()}.code == Dodo::Code::InternalFault);
+
+// DODO_TRY returns a plain Status, so deduced return types still agree with ok_status().
+constexpr auto deduced_try = [](int x) noexcept {
+    DODO_TRY(DODO_REQUIRE(x > 0, Dodo::Code::OutOfRange));
+    return Dodo::Status::ok_status();
+};
+static_assert(std::is_same_v<decltype(deduced_try(1)), Dodo::Status>);
+static_assert(deduced_try(1).ok());
+
+Dodo::Result<uint32_t> result_try(int x) noexcept {
+    DODO_TRY(DODO_REQUIRE(x > 0, Dodo::Code::OutOfRange));
+    return Dodo::Result<uint32_t>::ok_result(static_cast<uint32_t>(x));
+}
+
+// Checks directly at namespace scope, in a static_assert and a constexpr initializer.
+static_assert(DODO_REQUIRE(1 > 0, Dodo::Code::OutOfRange).ok());
+static_assert(DODO_CHECK_ADD(uint8_t{200}, 55).value == 255);
+constexpr Dodo::Status kNamespaceCheck = DODO_CHECK_RANGE(7, 0, 10, Dodo::Code::OutOfRange);
+static_assert(kNamespaceCheck.ok());
+
+// Checks in namespace-scope initializers: dynamically initialized, since the
+// condition is not a constant; the site has no enclosing function.
+static int g_ns_qty = 5;
+static const Dodo::Status g_ns_reject = DODO_REQUIRE(g_ns_qty < 3, Dodo::Code::OutOfRange);
+static const Dodo::Status g_ns_accept = DODO_CHECK_RANGE(g_ns_qty, 0, 10, Dodo::Code::OutOfRange);
+
+// Application code domain: venue errors packed into Dodo::Code next to the core codes.
+enum class VenueError : uint16_t { None, Rejected, Throttled, SessionDown };
+
+constexpr Dodo::CodeInfo kVenueCodes[] = {
+    {"None", Dodo::Severity::Recoverable},
+    {"Rejected", Dodo::Severity::Recoverable},
+    {"Throttled", Dodo::Severity::Recoverable},
+    {"SessionDown", Dodo::Severity::Fatal},
+};
+constexpr Dodo::CodeDomain kVenue{3, "venue", kVenueCodes};
+
+static_assert(Dodo::code_domain(kVenue.code(VenueError::Throttled)) == 3);
+static_assert(Dodo::code_value(kVenue.code(VenueError::Throttled)) == 2);
+static_assert(!Dodo::Status::fail(kVenue.code(VenueError::None)).ok()); // only Code 0 is success
+static_assert(kVenue.info(kVenue.code(VenueError::SessionDown)).severity == Dodo::Severity::Fatal);
+static_assert(Dodo::kCoreDomain.contains(Dodo::Code::Timeout) && !kVenue.contains(Dodo::Code::Timeout));
+static_assert(sizeof(Dodo::Status) == 2);
+
+static Dodo::Status venue_send(uint32_t credits) noexcept {
+    DODO_TRY(DODO_REQUIRE(credits != 0, kVenue.code(VenueError::Throttled)));
+    return Dodo::Status::ok_status();
+}
+
+static std::atomic<uint64_t> g_venue_hits{0};
+
+// Routes on the domain bits alone: no table lookup on the cold path.
+static Dodo::Status domain_routing_fallback(const Dodo::Failure& f) noexcept {
+    if (kVenue.contains(f.code)) {
+        g_venue_hits.fetch_add(1, std::memory_order_relaxed);
+    }
+    return Dodo::Status::fail(f.code);
+}
+
+#if DODO_HAS_FORK
+// Reporter sink that keeps every record (drain thread only), optionally slow.
+struct CollectSink {
+    std::vector<Dodo::FlightRecord>* out;
+    uint32_t delay_us = 0;
+
+    bool write(std::span<const Dodo::RecordSpan> batch) noexcept {
+        for (const Dodo::RecordSpan& seg : batch) out->insert(out->end(), seg.begin(), seg.end());
+        if (delay_us != 0) std::this_thread::sleep_for(std::chrono::microseconds(delay_us));
+        return true;
+    }
+};
+
+struct NullSink {
+    bool write(std::span<const Dodo::RecordSpan>) noexcept { return true; }
+};
+
+static Dodo::FlightRecord make_record(Dodo::Severity sev) noexcept {
+    return Dodo::FlightRecord{0, Dodo::Failure{Dodo::Code::ExternalFault, sev, {}}, 0, {}};
+}
+#endif
+
+#if DODO_HAS_COROUTINES
+// Minimal lazy task over Dodo::CoPromise: counts frames so tests can check
+// that short-circuited coroutines are still destroyed.
+static int g_live_frames = 0;
+static size_t g_last_frame_bytes = 0;
+
+template<class R>
+struct CoTask {
+    struct promise_type : Dodo::CoPromise<R> {
+        static void* operator new(size_t n) noexcept {
+            ++g_live_frames;
+            g_last_frame_bytes = n;
+            return std::malloc(n);
+        }
+        static void operator delete(void* p) noexcept {
+            --g_live_frames;
+            std::free(p);
+        }
+        static CoTask get_return_object_on_allocation_failure() noexcept { return CoTask{nullptr}; }
+        CoTask get_return_object() noexcept { return CoTask{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        struct Final {
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept { return h.promise().exit_to(); }
+            void await_resume() noexcept {}
+        };
+        Final final_suspend() noexcept { return {}; }
+    };
+
+    explicit CoTask(std::coroutine_handle<promise_type> h) noexcept : h_{h} {}
+    CoTask(CoTask&& o) noexcept : h_{std::exchange(o.h_, {})} {}
+    ~CoTask() { if (h_) h_.destroy(); }
+
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> c) noexcept {
+        h_.promise().continuation = c;
+        return h_;
+    }
+    R await_resume() const noexcept { return h_.promise().result; }
+
+    R run() noexcept {
+        h_.resume();
+        return h_.promise().result;
+    }
+    const promise_type& promise() const noexcept { return h_.promise(); }
+
+private:
+    std::coroutine_handle<promise_type> h_;
+};
+
+static CoTask<Dodo::Result<int>> co_leaf(int v) {
+    DODO_CO_TRY(DODO_CHECK_RANGE(v, 0, 100, Dodo::Code::OutOfRange));
+    co_return Dodo::Result<int>::ok_result(v);
+}
+
+static CoTask<Dodo::Result<int>> co_sum_try(int a, int b) {
+    DODO_CO_TRY_ASSIGN(const int x, co_await co_leaf(a));
+    DODO_CO_TRY_ASSIGN(const int y, co_await co_leaf(b));
+    co_return Dodo::Result<int>::ok_result(x + y);
+}
+
+static CoTask<Dodo::Result<int>> co_sum_unchecked(int a, int b) {
+    const int x = (co_await co_leaf(a)).value;
+    const int y = (co_await co_leaf(b)).value;
+    co_return Dodo::Result<int>::ok_result(x + y);
+}
+
+static CoTask<Dodo::Result<int>> co_sum_check(int a, int b) {
+    co_return Dodo::Result<int>::ok_result(co_await Dodo::co_check(co_await co_leaf(a)) +
+                                           co_await Dodo::co_check(co_await co_leaf(b)));
+}
+
+static CoTask<Dodo::Status> co_outer(int a, int b) {
+    DODO_CO_TRY(co_await co_sum_check(a, b));
+    co_await Dodo::co_check(DODO_REQUIRE(a != b, Dodo::Code::PreconditionFailed));
+    co_return Dodo::Status::ok_status();
+}
+#endif
+
+// Order-entry message: 12 field contracts, early-exit chain vs one-branch Validator.
+struct MockOrder {
+    const char* symbol;
+    int64_t price;
+    uint32_t qty, side, tif, type, account, venue, flags, seq, min_qty, display_qty;
+};
+
+DODO_NOINLINE Dodo::Status scenario_decode_chain(const MockOrder& o) noexcept {
+    DODO_TRY(DODO_CHECK_NOT_NULL(o.symbol, Dodo::Code::NullPointer));
+    DODO_TRY(DODO_CHECK_RANGE(o.price, int64_t(1), int64_t(1'000'000'000), Dodo::Code::OutOfRange));
+    DODO_TRY(DODO_CHECK_RANGE(o.qty, 1u, 1'000'000u, Dodo::Code::OutOfRange));
+    DODO_TRY(DODO_REQUIRE(o.side < 2u, Dodo::Code::PreconditionFailed));
+    DODO_TRY(DODO_REQUIRE(o.tif < 4u, Dodo::Code::PreconditionFailed));
+    DODO_TRY(DODO_REQUIRE(o.type < 3u, Dodo::Code::PreconditionFailed));
+    DODO_TRY(DODO_REQUIRE(o.account != 0u, Dodo::Code::PreconditionFailed));
+    DODO_TRY(DODO_CHECK_RANGE(o.venue, 1u, 64u, Dodo::Code::OutOfRange));
+    DODO_TRY(DODO_REQUIRE((o.flags & 0xFFFF'0000u) == 0u, Dodo::Code::PreconditionFailed));
+    DODO_TRY(DODO_REQUIRE(o.seq != 0u, Dodo::Code::PreconditionFailed));
+    DODO_TRY(DODO_REQUIRE(o.min_qty <= o.qty, Dodo::Code::PreconditionFailed));
+    DODO_TRY(DODO_REQUIRE(o.display_qty <= o.qty, Dodo::Code::PreconditionFailed));
+    return Dodo::Status::ok_status();
+}
+
+DODO_NOINLINE Dodo::Status scenario_decode_validator(const MockOrder& o) noexcept {
+    DODO_VALIDATOR(v);
+    DODO_VALIDATE_NOT_NULL(v, o.symbol, Dodo::Code::NullPointer);
+    DODO_VALIDATE_RANGE(v, o.price, int64_t(1), int64_t(1'000'000'000), Dodo::Code::OutOfRange);
+    DODO_VALIDATE_RANGE(v, o.qty, 1u, 1'000'000u, Dodo::Code::OutOfRange);
+    DODO_VALIDATE(v, o.side < 2u, Dodo::Code::PreconditionFailed);
+    DODO_VALIDATE(v, o.tif < 4u, Dodo::Code::PreconditionFailed);
+    DODO_VALIDATE(v, o.type < 3u, Dodo::Code::PreconditionFailed);
+    DODO_VALIDATE(v, o.account != 0u, Dodo::Code::PreconditionFailed);
+    DODO_VALIDATE_RANGE(v, o.venue, 1u, 64u, Dodo::Code::OutOfRange);
+    DODO_VALIDATE(v, (o.flags & 0xFFFF'0000u) == 0u, Dodo::Code::PreconditionFailed);
+    DODO_VALIDATE(v, o.seq != 0u, Dodo::Code::PreconditionFailed);
+    DODO_VALIDATE(v, o.min_qty <= o.qty, Dodo::Code::PreconditionFailed);
+    DODO_VALIDATE(v, o.display_qty <= o.qty, Dodo::Code::PreconditionFailed);
+    return v.finish();
+}
+
+template<class P>
+Dodo::Status scenario_policy_null(const int* sensor_val) noexcept {
+    return Dodo::basic_check_not_null<P>(sensor_val, Dodo::Code::NullPointer,
+        DODO_MAKE_FAIL(Dodo::Severity::Recoverable, Dodo::Code::NullPointer, DODO_EXPR_STR(sensor_val)));
+}
+
 void scenario_fatal_logic(bool corruption) noexcept {
     DODO_INVARIANT(!corruption, Dodo::Code::InvariantBroken);
 }
 
+// --- Replay / fuzz ---
+// Reference verdict for scenario_decode_*: the first broken contract's code.
+static Dodo::Code reference_order_code(const MockOrder& o) noexcept {
+    if (o.symbol == nullptr) return Dodo::Code::NullPointer;
+    if (o.price < 1 || o.price > 1'000'000'000) return Dodo::Code::OutOfRange;
+    if (o.qty < 1u || o.qty > 1'000'000u) return Dodo::Code::OutOfRange;
+    if (o.side >= 2u || o.tif >= 4u || o.type >= 3u || o.account == 0u) return Dodo::Code::PreconditionFailed;
+    if (o.venue < 1u || o.venue > 64u) return Dodo::Code::OutOfRange;
+    if ((o.flags & 0xFFFF'0000u) != 0u || o.seq == 0u || o.min_qty > o.qty || o.display_qty > o.qty) {
+        return Dodo::Code::PreconditionFailed;
+    }
+    return Dodo::Code::Ok;
+}
+
+// Boundary-heavy replacement for one MockOrder field.
+static void mutate_order(MockOrder& o, bench::Rng& rng) noexcept {
+    static constexpr uint32_t kEdges[] = {0u, 1u, 2u, 3u, 4u, 63u, 64u, 65u, 1'000'000u, 1'000'001u, 0xFFFFu, 0x1'0000u, UINT32_MAX};
+    const uint32_t u = rng.below(4) == 0 ? static_cast<uint32_t>(rng.next()) : kEdges[rng.below(std::size(kEdges))];
+    switch (rng.below(12)) {
+        case 0: o.symbol = nullptr; break;
+        case 1: o.price = rng.below(2) ? static_cast<int64_t>(u) - 1 : 1'000'000'000 + static_cast<int64_t>(rng.below(3)) - 1; break;
+        case 2: o.qty = u; break;
+        case 3: o.side = u; break;
+        case 4: o.tif = u; break;
+        case 5: o.type = u; break;
+        case 6: o.account = u; break;
+        case 7: o.venue = u; break;
+        case 8: o.flags = u; break;
+        case 9: o.seq = u; break;
+        case 10: o.min_qty = u; break;
+        default: o.display_qty = u; break;
+    }
+}
+
+// One differential fuzz round, deterministic per seed: `n` calls whose
+// pass/fail pattern comes from a random (possibly bursty) trace. Failing
+// calls get 1-3 mutated MockOrder fields and an out-of-range or null sensor.
+// Checks the early-exit chain and the Validator against reference_order_code,
+// scenario_safety_limits against its contract, and that every failing call
+// reached the fallback handler exactly once. Returns the number of
+// disagreements; the first is printed with its seed and index.
+static size_t fuzz_round(uint64_t seed, size_t n) {
+    static constexpr double kRates[] = {0.0001, 0.01, 0.1, 0.5};
+    bench::Rng rng{seed};
+    bench::TraceSpec spec{"fuzz", kRates[rng.below(std::size(kRates))]};
+    if (rng.below(2) != 0) {
+        spec.burst_enter = spec.rate / 10.0;
+        spec.burst_exit = 0.05;
+        spec.burst_rate = 0.9;
+    }
+    const bench::Trace trace = bench::make_trace(n, spec, rng.next());
+    const MockOrder good{"ESZ6", 450'025, 10, 1, 0, 2, 77, 5, 0x3u, 9, 1, 5};
+
+    Dodo::set_fallback_handler(counting_fallback_handler);
+    size_t bad = 0;
+    const auto check = [&](size_t i, const char* what, uint64_t got, uint64_t want) {
+        if (got != want && bad++ == 0) {
+            std::cerr << "fuzz seed " << seed << " index " << i << ": " << what << " " << got << ", expected "
+                      << want << std::endl;
+        }
+    };
+    const auto code = [](Dodo::Code c) { return static_cast<uint64_t>(c); };
+    for (size_t i = 0; i < n; ++i) {
+        MockOrder o = good;
+        int sensor = static_cast<int>(rng.below(1025));
+        const int* sensor_ptr = &sensor;
+        if (trace[i] != 0) {
+            for (uint64_t m = 0, k = 1 + rng.below(3); m < k; ++m) mutate_order(o, rng);
+            if (rng.below(4) == 0) sensor_ptr = nullptr;
+            else sensor = rng.below(2) ? -1 - static_cast<int>(rng.below(1000)) : 1025 + static_cast<int>(rng.below(1000));
+        }
+        const Dodo::Code want = reference_order_code(o);
+        const Dodo::Code want_sensor = sensor_ptr == nullptr ? Dodo::Code::NullPointer
+                                     : (sensor < 0 || sensor > 1024) ? Dodo::Code::OutOfRange : Dodo::Code::Ok;
+        const uint64_t before = g_recoverable_hits.load(std::memory_order_relaxed);
+        const Dodo::Code chain = scenario_decode_chain(o).code;
+        const Dodo::Code validator = scenario_decode_validator(o).code;
+        const Dodo::Code safety = scenario_safety_limits(sensor_ptr).code;
+        const uint64_t dispatched = g_recoverable_hits.load(std::memory_order_relaxed) - before;
+        const uint64_t expected = 2u * (want != Dodo::Code::Ok) + (want_sensor != Dodo::Code::Ok);
+        check(i, "decode chain code", code(chain), code(want));
+        check(i, "decode validator code", code(validator), code(want));
+        check(i, "safety limits code", code(safety), code(want_sensor));
+        check(i, "fallback dispatches", dispatched, expected);
+    }
+    Dodo::set_fallback_handler(recording_fallback_handler);
+    return bad;
+}
+
 static void run_unit_tests() {
     // Handlers for deterministic recording.
     Dodo::set_fallback_handler(recording_fallback_handler);
@@ -165,12 +690,17 @@ static void run_unit_tests() {
         TEST_EQ(g_last_failure.code, Dodo::Code::PreconditionFailed);
         TEST_EQ(g_last_failure.sev, Dodo::Severity::Recoverable);
 
-#ifdef DODO_FAST_MODE
+#if defined(DODO_FAST_MODE) || defined(DODO_COMPACT_MODE)
         TEST_ASSERT(g_last_failure.expr == nullptr);
         TEST_ASSERT(g_last_failure.file == nullptr);
         TEST_EQ(g_last_failure.line, 0u);
         TEST_ASSERT(g_last_failure.func == nullptr);
-#else
+#endif
+#if defined(DODO_COMPACT_MODE)
+        // The ID is FNV-1a of "file:line:expr", exactly what tools/dodo_sitemap recomputes.
+        const std::string key = std::string(__FILE__) + ":" + std::to_string(expected_line) + ":1 == 2";
+        TEST_EQ(g_last_failure.site_bits, uintptr_t{Dodo::internal::site_id_of(key.data(), key.size())});
+#elif !defined(DODO_FAST_MODE)
         TEST_ASSERT(g_last_failure.expr != nullptr);
         TEST_ASSERT(std::strstr(g_last_failure.expr, "1 == 2") != nullptr);
         TEST_ASSERT(g_last_failure.file != nullptr);
@@ -243,27 +773,36 @@ static void run_unit_tests() {
     }
 
     
-    { // 7) Threaded stress (init-only handler set, then parallel calls)
-        g_recoverable_hits.store(0, std::memory_order_relaxed);
-        Dodo::set_fallback_handler(counting_fallback_handler);
-
-        constexpr int kThreads = 4;
-        constexpr int kItersPerThread = 200'000;
-
-        std::vector<std::thread> th;
-        th.reserve(kThreads);
-
-        for (int t = 0; t < kThreads; ++t) {
-            th.emplace_back([]{
-                for (int i = 0; i < kItersPerThread; ++i) {
-                    (void)DODO_REQUIRE(false, Dodo::Code::PreconditionFailed);
-                }
-            });
+    { // 7) Threaded stress: shared atomic counter vs Dodo::Stats per-thread rows, 4..72 threads
+        for (const int threads : {4, 32, kStatsOverflowThreads}) {
+            const int iters = kThreadedFailures / threads;
+            const uint64_t expected = uint64_t(threads) * uint64_t(iters);
+
+            g_recoverable_hits.store(0, std::memory_order_relaxed);
+            Dodo::set_fallback_handler(counting_fallback_handler);
+            (void)run_failing_threads(threads, iters);
+            TEST_EQ(g_recoverable_hits.load(std::memory_order_relaxed), expected);
+            g_recoverable_hits.store(0, std::memory_order_relaxed);
+
+            // Past DODO_STATS_THREADS rows the extra threads share the overflow row.
+            const uint64_t before = Dodo::stats().count(Dodo::Code::PreconditionFailed);
+            const uint64_t total_before = Dodo::stats().total();
+            Dodo::set_fallback_handler(Dodo::stats_fallback);
+            (void)run_failing_threads(threads, iters);
+            TEST_EQ(Dodo::stats().count(Dodo::Code::PreconditionFailed) - before, expected);
+            TEST_EQ(Dodo::stats().total() - total_before, expected);
+            TEST_EQ(g_recoverable_hits.load(std::memory_order_relaxed), 0ull); // stats_fallback is standalone
         }
-        for (auto& x : th) x.join();
+        uint64_t seen = 0;
+        Dodo::stats().for_each([&](Dodo::Code c, uint64_t n) noexcept {
+            if (c == Dodo::Code::PreconditionFailed) seen = n;
+        });
+        TEST_EQ(seen, Dodo::stats().count(Dodo::Code::PreconditionFailed));
 
-        const uint64_t expected = uint64_t(kThreads) * uint64_t(kItersPerThread);
-        TEST_EQ(g_recoverable_hits.load(std::memory_order_relaxed), expected);
+        // Exited workers hand their thread index back: a new thread reuses a low row.
+        uint32_t fresh_index = UINT32_MAX;
+        std::thread([&] { fresh_index = Dodo::internal::thread_index(); }).join();
+        TEST_ASSERT(fresh_index < DODO_STATS_THREADS);
 
         // Restore recording handler for remaining tests/bench.
         Dodo::set_fallback_handler(recording_fallback_handler);
@@ -291,37 +830,1396 @@ static void run_unit_tests() {
     // Non-POSIX: cannot death-test without external framework.
     // Still validates other correctness properties above.
 #endif
-}
 
-// Benchmark
-static volatile uint16_t g_sink = 0;
-template<typename Func>
-BenchResult run_bench(const char* label, Func f) {
-    uint64_t ok = 0, fail = 0;
+    { // 9) Result<T>: value chain, Status interop, DODO_TRY_ASSIGN early return
+        MockMarketData md_ok{1.0, 42, "X"};
+        MockMarketData md_bad{1.0, 0, "X"};
+
+        Dodo::Result<uint32_t> r = scenario_result_chain(md_ok);
+        TEST_ASSERT(r.ok());
+        TEST_EQ(r.value, 84u);
+
+        Dodo::Result<uint32_t> bad = scenario_result_chain(md_bad);
+        TEST_ASSERT(!bad.ok());
+        TEST_EQ(bad.code, Dodo::Code::PreconditionFailed);
+        TEST_EQ(bad.value, 0u);
+
+        MockMarketData md_big{1.0, 2'000'000, "X"};
+        TEST_EQ(scenario_result_chain(md_big).code, Dodo::Code::OutOfRange);
+
+        // Result -> Status (DODO_TRY on a Result) and Status -> Result propagation.
+        auto f = [](const MockMarketData& md) noexcept -> Dodo::Status {
+            DODO_TRY(parse_volume(md));
+            return Dodo::Status::ok_status();
+        };
+        TEST_ASSERT(f(md_ok).ok());
+        TEST_EQ(f(md_bad).code, Dodo::Code::PreconditionFailed);
+
+        uint32_t out = 0;
+        TEST_ASSERT(scenario_status_chain(md_ok, &out).ok());
+        TEST_EQ(out, r.value);
+    }
+
+    { // 10) Per-site descriptors: distinct sites, hit counters, registry walk
+        auto fail_a = []() noexcept -> Dodo::Status {
+            return DODO_REQUIRE(false, Dodo::Code::PreconditionFailed);
+        };
+        auto fail_b = []() noexcept -> Dodo::Status {
+            return DODO_CHECK_RANGE(99, 0, 10, Dodo::Code::OutOfRange);
+        };
+#ifdef DODO_COMPACT_MODE
+        // No Site statics: identity is the 32-bit ID, and the registry stays empty.
+        (void)fail_a();
+        const uintptr_t id_a = g_last_failure.site_bits;
+        (void)fail_b();
+        const uintptr_t id_b = g_last_failure.site_bits;
+        TEST_ASSERT(id_a != 0 && id_b != 0 && id_a != id_b);
+        (void)fail_a();
+        TEST_EQ(g_last_failure.site_bits, id_a);
+        int registered = 0;
+        Dodo::for_each_site([&](const Dodo::Site&) noexcept { ++registered; });
+        TEST_EQ(registered, 0);
+#else
+
+        (void)fail_a();
+        const Dodo::Site* site_a = g_last_failure.site;
+        (void)fail_b();
+        const Dodo::Site* site_b = g_last_failure.site;
+
+        TEST_ASSERT(site_a != nullptr);
+        TEST_ASSERT(site_b != nullptr);
+        TEST_ASSERT(site_a != site_b); // identity holds even in DODO_FAST_MODE
+
+        Dodo::reset_site_counters();
+        for (int i = 0; i < 3; ++i) (void)fail_a();
+        (void)fail_b();
+        TEST_EQ(site_a->hits.load(std::memory_order_relaxed), 3ull);
+        TEST_EQ(site_b->hits.load(std::memory_order_relaxed), 1ull);
+
+        int seen_a = 0, seen_b = 0;
+        uint64_t total = 0;
+        Dodo::for_each_site([&](const Dodo::Site& s) noexcept {
+            seen_a += (&s == site_a);
+            seen_b += (&s == site_b);
+            total += s.hits.load(std::memory_order_relaxed);
+        });
+        TEST_EQ(seen_a, 1);
+        TEST_EQ(seen_b, 1);
+        TEST_EQ(total, 4ull);
+
+        Dodo::reset_site_counters();
+        TEST_EQ(site_a->hits.load(std::memory_order_relaxed), 0ull);
+#endif
+
+        TEST_EQ(g_ns_reject.code, Dodo::Code::OutOfRange);
+        TEST_ASSERT(g_ns_accept.ok());
+#if !defined(DODO_FAST_MODE) && !defined(DODO_COMPACT_MODE)
+        const Dodo::Site* ns_site = nullptr;
+        Dodo::for_each_site([&](const Dodo::Site& s) noexcept {
+            if (s.expr != nullptr && std::strcmp(s.expr, "g_ns_qty < 3") == 0) {
+                ns_site = &s;
+            }
+        });
+        TEST_ASSERT(ns_site != nullptr && ns_site->func != nullptr && ns_site->func[0] == '\0');
+#endif
+    }
+
+    { // 11) Flight recorder: chained handlers, ordered per-thread records, concurrent consumer
+        Dodo::FlightRecorder& fr = Dodo::flight_recorder();
+        (void)fr.consume([](const Dodo::FlightRecord&) noexcept {}); // start from a clean cursor
+
+        Dodo::install_flight_recorder();
+        Dodo::install_flight_recorder(); // idempotent: must not chain to itself
+        g_recoverable_hits.store(0, std::memory_order_relaxed);
+
+        Dodo::Status s1 = DODO_REQUIRE(false, Dodo::Code::PreconditionFailed);
+        Dodo::Status s2 = DODO_CHECK_RANGE(50, 0, 10, Dodo::Code::OutOfRange);
+        TEST_EQ(s1.code, Dodo::Code::PreconditionFailed);
+        TEST_EQ(s2.code, Dodo::Code::OutOfRange);
+        TEST_EQ(g_recoverable_hits.load(std::memory_order_relaxed), 2ull); // forwarded to previous handler
+
+        Dodo::FlightRecord got[2]{};
+        size_t n = 0;
+        const size_t delivered = fr.consume([&](const Dodo::FlightRecord& r) noexcept {
+            if (n < 2) got[n] = r;
+            ++n;
+        });
+        TEST_EQ(delivered, 2u);
+        TEST_EQ(got[0].failure.code, Dodo::Code::PreconditionFailed);
+        TEST_EQ(got[1].failure.code, Dodo::Code::OutOfRange);
+#ifndef DODO_NO_FAILURE_PAYLOAD
+        TEST_ASSERT(got[0].payload.kind == Dodo::PayloadKind::None);
+        TEST_ASSERT(got[1].payload.kind == Dodo::PayloadKind::Range && got[1].payload.count == 3);
+        TEST_EQ(got[1].payload.operands[0], 50ull);
+        TEST_EQ(got[1].payload.operands[2], 10ull);
+#endif
+        TEST_ASSERT(Dodo::internal::site_bits(got[0].failure) != 0);
+        TEST_ASSERT(Dodo::internal::site_bits(got[0].failure) != Dodo::internal::site_bits(got[1].failure));
+        TEST_ASSERT(got[1].tsc >= got[0].tsc);
+        TEST_EQ(fr.consume([](const Dodo::FlightRecord&) noexcept {}), 0u); // nothing new
+
+        // Writers race a live consumer; every record is delivered, lost or untracked.
+        Dodo::set_fallback_handler(counting_fallback_handler);
+        Dodo::install_flight_recorder(); // re-chain in front of the thread-safe handler
+        constexpr int kWriters = 4;
+        constexpr int kPerWriter = 20'000;
+        std::atomic<int> running{kWriters};
+        const uint64_t lost_before = fr.lost();
+        const uint64_t untracked_before = fr.untracked();
+        uint64_t consumed = 0;
+
+        std::vector<std::thread> th;
+        for (int t = 0; t < kWriters; ++t) {
+            th.emplace_back([&running]{
+                for (int i = 0; i < kPerWriter; ++i) {
+                    (void)DODO_REQUIRE(false, Dodo::Code::Timeout);
+                }
+                running.fetch_sub(1, std::memory_order_release);
+            });
+        }
+        bool ordered = true;
+        uint64_t last_tsc[Dodo::FlightRecorder::max_threads]{};
+        auto check = [&](const Dodo::FlightRecord& r) noexcept {
+            if (r.failure.code != Dodo::Code::Timeout) ordered = false;
+            if (r.thread < Dodo::FlightRecorder::max_threads) {
+                if (r.tsc < last_tsc[r.thread]) ordered = false;
+                last_tsc[r.thread] = r.tsc;
+            }
+        };
+        while (running.load(std::memory_order_acquire) != 0) {
+            consumed += fr.consume(check);
+        }
+        for (auto& x : th) x.join();
+        consumed += fr.consume(check);
+
+        const uint64_t accounted = consumed + (fr.lost() - lost_before) + (fr.untracked() - untracked_before);
+        TEST_EQ(accounted, uint64_t(kWriters) * uint64_t(kPerWriter));
+        TEST_ASSERT(ordered);
+
+        Dodo::set_fallback_handler(recording_fallback_handler);
+        Dodo::set_panic_handler(stress_panic_handler);
+    }
+
+    { // 12) Compile-time policies bypass the runtime hooks but keep site accounting
+        g_recoverable_hits.store(0, std::memory_order_relaxed);
+        g_policy_hits.store(0, std::memory_order_relaxed);
+        int x = 1;
+
+        TEST_ASSERT(scenario_policy_null<StaticPolicy>(&x).ok());
+        Dodo::Status s = scenario_policy_null<StaticPolicy>(nullptr);
+        TEST_EQ(s.code, Dodo::Code::NullPointer);
+        TEST_EQ(g_policy_hits.load(std::memory_order_relaxed), 1ull);
+        TEST_EQ(g_recoverable_hits.load(std::memory_order_relaxed), 0ull);
+
+        TEST_EQ(scenario_policy_null<TrivialPolicy>(nullptr).code, Dodo::Code::NullPointer);
+        TEST_EQ(g_recoverable_hits.load(std::memory_order_relaxed), 0ull);
+
+        // RuntimePolicy is what the plain functions and default macros use.
+        TEST_EQ(scenario_policy_null<Dodo::RuntimePolicy>(nullptr).code, Dodo::Code::NullPointer);
+        TEST_EQ(g_recoverable_hits.load(std::memory_order_relaxed), 1ull);
+
+        // One site per instantiation, each counted once.
+        int policy_sites = 0;
+        Dodo::for_each_site([&](const Dodo::Site& site) noexcept {
+            if (site.func != nullptr && std::strstr(site.func, "scenario_policy_null") != nullptr) {
+                policy_sites += (site.hits.load(std::memory_order_relaxed) >= 1);
+            }
+        });
+#if !defined(DODO_FAST_MODE) && !defined(DODO_COMPACT_MODE)
+        TEST_EQ(policy_sites, 3);
+#else
+        (void)policy_sites;
+#endif
+    }
+
+    { // 13) Atomic hooks: per-thread ScopedFallback overrides + hot swap under load
+        g_recoverable_hits.store(0, std::memory_order_relaxed);
+        g_scoped_hits.store(0, std::memory_order_relaxed);
+        Dodo::set_fallback_handler(counting_fallback_handler);
+        TEST_ASSERT(Dodo::get_fallback_handler() == counting_fallback_handler);
+
+        {
+            Dodo::ScopedFallback scope(scoped_fallback_handler);
+            TEST_EQ(DODO_REQUIRE(false, Dodo::Code::PreconditionFailed).code, Dodo::Code::ExternalFault);
+            {
+                Dodo::ScopedFallback inner(nullptr); // nullptr -> default_fallback for this scope
+                TEST_EQ(DODO_REQUIRE(false, Dodo::Code::PreconditionFailed).code, Dodo::Code::PreconditionFailed);
+            }
+            TEST_EQ(DODO_REQUIRE(false, Dodo::Code::PreconditionFailed).code, Dodo::Code::ExternalFault);
+
+            // Other threads keep the process-wide handler.
+            std::thread other([]{
+                (void)DODO_REQUIRE(false, Dodo::Code::PreconditionFailed);
+            });
+            other.join();
+        }
+        (void)DODO_REQUIRE(false, Dodo::Code::PreconditionFailed);
+        TEST_EQ(g_scoped_hits.load(std::memory_order_relaxed), 2ull);
+        TEST_EQ(g_recoverable_hits.load(std::memory_order_relaxed), 2ull);
+
+        // Swap the global policy while workers fail; every failure hits one of the two.
+        g_recoverable_hits.store(0, std::memory_order_relaxed);
+        g_scoped_hits.store(0, std::memory_order_relaxed);
+        constexpr int kWorkers = 4;
+        constexpr int kIters = 50'000;
+        std::atomic<int> running{kWorkers};
+        std::vector<std::thread> th;
+        for (int t = 0; t < kWorkers; ++t) {
+            th.emplace_back([&running]{
+                for (int i = 0; i < kIters; ++i) {
+                    (void)DODO_REQUIRE(false, Dodo::Code::PreconditionFailed);
+                }
+                running.fetch_sub(1, std::memory_order_release);
+            });
+        }
+        bool flip = false;
+        while (running.load(std::memory_order_acquire) != 0) {
+            Dodo::set_fallback_handler(flip ? counting_fallback_handler : scoped_fallback_handler);
+            flip = !flip;
+        }
+        for (auto& x : th) x.join();
+        TEST_EQ(g_recoverable_hits.load(std::memory_order_relaxed) + g_scoped_hits.load(std::memory_order_relaxed),
+                uint64_t(kWorkers) * uint64_t(kIters));
+
+        Dodo::set_fallback_handler(recording_fallback_handler);
+    }
+
+    { // 14) One hook table per process: a handler set here drives checks compiled in another TU
+        Dodo::set_fallback_handler(counting_fallback_handler);
+        TEST_ASSERT(other_tu_fallback_handler() == counting_fallback_handler);
+
+        Dodo::set_fallback_handler(recording_fallback_handler);
+        TEST_ASSERT(other_tu_fallback_handler() == recording_fallback_handler);
+
+        g_recoverable_hits.store(0, std::memory_order_relaxed);
+        TEST_ASSERT(other_tu_require(true).ok());
+        TEST_EQ(other_tu_require(false).code, Dodo::Code::ExternalFault);
+        TEST_EQ(g_recoverable_hits.load(std::memory_order_relaxed), 1ull);
+        TEST_EQ(g_last_failure.code, Dodo::Code::ExternalFault);
+#if !defined(DODO_FAST_MODE) && !defined(DODO_COMPACT_MODE)
+        TEST_ASSERT(g_last_failure.file != nullptr && std::strstr(g_last_failure.file, "stresstest_tu.cpp") != nullptr);
+#endif
+    }
+
+    { // 15) Batched span checks: SIMD block compare + scalar first-failure index
+        int32_t book[kBookFields];
+        for (size_t i = 0; i < kBookFields; ++i) book[i] = static_cast<int32_t>(i * 100);
+        TEST_ASSERT(scenario_book_batched(book).ok());
+
+        size_t bad_at = 999;
+        book[37] = -5; // lands in the scalar tail for every lane width
+        Dodo::Status s = DODO_CHECK_RANGE_ALL(book, 0, 1'000'000, Dodo::Code::OutOfRange, &bad_at);
+        TEST_EQ(s.code, Dodo::Code::OutOfRange);
+        TEST_EQ(bad_at, 37u);
+        book[3] = 2'000'000; // inside the first SIMD block
+        TEST_ASSERT(!DODO_CHECK_RANGE_ALL(book, 0, 1'000'000, Dodo::Code::OutOfRange, &bad_at).ok());
+        TEST_EQ(bad_at, 3u);
+        TEST_EQ(scenario_book_scalar(book).code, Dodo::Code::OutOfRange);
+
+        // Unsigned lanes must compare unsigned (values above INT32_MAX).
+        std::vector<uint32_t> u(33, 0x9000'0000u);
+        TEST_ASSERT(DODO_CHECK_RANGE_ALL(u, 0x8000'0000u, 0xA000'0000u, Dodo::Code::OutOfRange).ok());
+        u[20] = 5;
+        TEST_ASSERT(!DODO_CHECK_RANGE_ALL(u, 0x8000'0000u, 0xA000'0000u, Dodo::Code::OutOfRange, &bad_at).ok());
+        TEST_EQ(bad_at, 20u);
+
+        // Floating point: NaN fails, as with the scalar check.
+        float fpx[19];
+        for (float& x : fpx) x = 1.5f;
+        TEST_ASSERT(DODO_CHECK_RANGE_ALL(fpx, 0.0f, 2.0f, Dodo::Code::OutOfRange).ok());
+        fpx[9] = std::numeric_limits<float>::quiet_NaN();
+        TEST_ASSERT(!DODO_CHECK_RANGE_ALL(fpx, 0.0f, 2.0f, Dodo::Code::OutOfRange, &bad_at).ok());
+        TEST_EQ(bad_at, 9u);
+
+        std::array<double, 11> dpx{};
+        dpx.fill(100.25);
+        TEST_ASSERT(DODO_CHECK_RANGE_ALL(dpx, 100.0, 101.0, Dodo::Code::OutOfRange).ok());
+        dpx[10] = 101.5;
+        TEST_ASSERT(!DODO_CHECK_RANGE_ALL(dpx, 100.0, 101.0, Dodo::Code::OutOfRange, &bad_at).ok());
+        TEST_EQ(bad_at, 10u);
+
+        // Generic (non-SIMD) element type, empty span, inverted bounds.
+        int64_t big[5] = {1, 2, 3, 4, int64_t(1) << 40};
+        TEST_ASSERT(!DODO_CHECK_RANGE_ALL(big, int64_t(0), int64_t(10), Dodo::Code::OutOfRange, &bad_at).ok());
+        TEST_EQ(bad_at, 4u);
+        TEST_ASSERT(DODO_CHECK_RANGE_ALL(std::span<const int32_t>(), 0, 1, Dodo::Code::OutOfRange).ok());
+        TEST_ASSERT(!DODO_CHECK_RANGE_ALL(std::span<const int32_t>(book, 2), 10, 0, Dodo::Code::OutOfRange, &bad_at).ok());
+        TEST_EQ(bad_at, 0u);
+
+        // Null checks over pointer ranges.
+        int x = 0;
+        std::vector<const int*> ptrs(13, &x);
+        TEST_ASSERT(DODO_CHECK_NOT_NULL_ALL(ptrs, Dodo::Code::NullPointer).ok());
+        ptrs[11] = nullptr;
+        TEST_EQ(DODO_CHECK_NOT_NULL_ALL(ptrs, Dodo::Code::NullPointer, &bad_at).code, Dodo::Code::NullPointer);
+        TEST_EQ(bad_at, 11u);
+        TEST_EQ(g_last_failure.code, Dodo::Code::NullPointer);
+    }
+
+    { // 16) Validator: all checks folded, one dispatch carrying the first failing site
+        Dodo::set_fallback_handler(recording_fallback_handler);
+        const MockOrder good{"ESZ6", 450'025, 10, 1, 0, 2, 77, 5, 0x3u, 9, 1, 5};
+        TEST_ASSERT(scenario_decode_validator(good).ok());
+        TEST_ASSERT(scenario_decode_chain(good).ok());
+
+        MockOrder bad = good;
+        bad.venue = 0;      // 8th check
+        bad.display_qty = 11; // 12th check
+        const uint64_t before = g_recoverable_hits.load(std::memory_order_relaxed);
+        TEST_EQ(scenario_decode_validator(bad).code, Dodo::Code::OutOfRange);
+        TEST_EQ(g_recoverable_hits.load(std::memory_order_relaxed), before + 1); // one dispatch, not two
+        TEST_EQ(g_last_failure.code, Dodo::Code::OutOfRange);
+        TEST_ASSERT(g_last_failure.site_bits != 0);
+#if !defined(DODO_FAST_MODE) && !defined(DODO_COMPACT_MODE)
+        TEST_ASSERT(g_last_failure.expr != nullptr && std::strcmp(g_last_failure.expr, "o.venue") == 0);
+#endif
+        // Same verdict as the early-exit chain, but the chain stops at the 8th check.
+        TEST_EQ(scenario_decode_chain(bad).code, Dodo::Code::OutOfRange);
+
+        Dodo::Validator v;
+        TEST_ASSERT(v.ok());
+        TEST_EQ(v.failure().code, Dodo::Code::Ok);
+        TEST_ASSERT(Dodo::internal::site_bits(v.failure()) == 0);
+        int x = 0;
+        v.check_not_null(&x, Dodo::Code::NullPointer, DODO_CTX(Dodo::Code::NullPointer, Dodo::Severity::Recoverable));
+        v.check_aligned(&x, alignof(int), Dodo::Code::Misaligned, DODO_CTX(Dodo::Code::Misaligned, Dodo::Severity::Recoverable));
+        TEST_ASSERT(v.finish().ok());
+        v.check_range(1.5, 0.0, 1.0, Dodo::Code::OutOfRange, DODO_CTX(Dodo::Code::OutOfRange, Dodo::Severity::Recoverable));
+        v.require(false, Dodo::Code::Timeout, DODO_CTX(Dodo::Code::Timeout, Dodo::Severity::Recoverable));
+        TEST_ASSERT(!v.ok());
+        TEST_EQ(v.failed(), 2u);
+        TEST_EQ(v.failure().code, Dodo::Code::OutOfRange);
+        TEST_EQ(v.finish().code, Dodo::Code::OutOfRange);
+    }
+
+    { // 17) Failure sampling: token bucket + 1-in-N, suppressed failures still fail and are counted
+        Dodo::set_fallback_handler(counting_fallback_handler);
+        Dodo::install_fallback_sampler();
+        Dodo::install_fallback_sampler(); // idempotent: must not chain to itself
+        TEST_ASSERT(Dodo::get_fallback_handler() == Dodo::sampled_fallback);
+
+        // Default rule admits everything.
+        g_recoverable_hits.store(0, std::memory_order_relaxed);
+        const uint64_t base = Dodo::suppressed_count(Dodo::Code::Timeout);
+        for (int i = 0; i < 10; ++i) {
+            TEST_EQ(DODO_REQUIRE(false, Dodo::Code::Timeout).code, Dodo::Code::Timeout);
+        }
+        TEST_EQ(g_recoverable_hits.load(std::memory_order_relaxed), 10ull);
+        TEST_EQ(Dodo::suppressed_count(Dodo::Code::Timeout), base);
+
+        // Burst of 3 that never refills, then nothing.
+        Dodo::set_sample_rule(Dodo::Code::Timeout, Dodo::SampleRule{3, 0, 0});
+        TEST_EQ(Dodo::get_sample_rule(Dodo::Code::Timeout).burst, 3u);
+        g_recoverable_hits.store(0, std::memory_order_relaxed);
+        for (int i = 0; i < 100; ++i) {
+            TEST_EQ(DODO_REQUIRE(false, Dodo::Code::Timeout).code, Dodo::Code::Timeout);
+        }
+        TEST_EQ(g_recoverable_hits.load(std::memory_order_relaxed), 3ull);
+        TEST_EQ(Dodo::suppressed_count(Dodo::Code::Timeout), base + 97);
+
+        // Other codes are unaffected.
+        TEST_EQ(DODO_REQUIRE(false, Dodo::Code::Overflow).code, Dodo::Code::Overflow);
+        TEST_EQ(g_recoverable_hits.load(std::memory_order_relaxed), 4ull);
+
+        // Bucket drained: 1 in 10 of the rest. A fresh thread primes its own bucket.
+        Dodo::set_sample_rule(Dodo::Code::Timeout, Dodo::SampleRule{2, 10, 0});
+        g_recoverable_hits.store(0, std::memory_order_relaxed);
+        std::thread sampler_thread([]{
+            for (int i = 0; i < 102; ++i) {
+                (void)DODO_REQUIRE(false, Dodo::Code::Timeout);
+            }
+        });
+        sampler_thread.join();
+        TEST_EQ(g_recoverable_hits.load(std::memory_order_relaxed), 2ull + 10ull);
+        TEST_EQ(Dodo::suppressed_count(Dodo::Code::Timeout), base + 97 + 90);
+
+        // Refill: one token per tick admits again once time has passed.
+        Dodo::set_sample_rule(Dodo::Code::Timeout, Dodo::SampleRule{1, 0, 1});
+        g_recoverable_hits.store(0, std::memory_order_relaxed);
+        (void)DODO_REQUIRE(false, Dodo::Code::Timeout);
+        (void)DODO_REQUIRE(false, Dodo::Code::Timeout);
+        TEST_ASSERT(g_recoverable_hits.load(std::memory_order_relaxed) >= 1ull);
+
+        // Compile-time form: the inner fallback is only called for admitted failures.
+        g_policy_hits.store(0, std::memory_order_relaxed);
+        Dodo::set_sample_rule(Dodo::Code::NullPointer, Dodo::SampleRule{0, 4, 0});
+        for (int i = 0; i < 8; ++i) {
+            TEST_EQ(scenario_policy_null<Dodo::SampledPolicy<StaticPolicy>>(nullptr).code, Dodo::Code::NullPointer);
+        }
+        TEST_EQ(g_policy_hits.load(std::memory_order_relaxed), 2ull);
+
+        Dodo::set_sample_rule(Dodo::Code::Timeout, Dodo::SampleRule{});
+        Dodo::set_sample_rule(Dodo::Code::NullPointer, Dodo::SampleRule{});
+        Dodo::set_fallback_handler(recording_fallback_handler);
+    }
+
+    { // 18) CircuitBreaker: trip on N failures, short-circuit while open, half-open probe
+        using State = Dodo::CircuitBreaker::State;
+        const Dodo::Status bad = Dodo::Status::fail(Dodo::Code::ExternalFault);
+        const Dodo::Status good = Dodo::Status::ok_status();
+
+        Dodo::CircuitBreaker cb{{.threshold = 3, .window_ticks = 0, .cooldown_ticks = UINT64_MAX}};
+        TEST_ASSERT(cb.allow().ok());
+        TEST_EQ(cb.record(bad).code, Dodo::Code::ExternalFault); // passes the Status through
+        TEST_ASSERT(cb.record(good).ok());
+        (void)cb.record(bad);
+        TEST_ASSERT(cb.state() == State::Closed);
+        TEST_EQ(cb.failures(), 2u);
+        (void)cb.record(bad);
+        TEST_ASSERT(cb.state() == State::Open);
+        g_recoverable_hits.store(0, std::memory_order_relaxed);
+        TEST_EQ(cb.allow().code, Dodo::Code::ExternalFault);
+        TEST_EQ(g_recoverable_hits.load(std::memory_order_relaxed), 0ull); // no handler dispatch
+        (void)cb.record(good); // straggler, ignored while open
+        TEST_ASSERT(cb.state() == State::Open);
+        cb.reset();
+        TEST_ASSERT(cb.state() == State::Closed);
+        TEST_EQ(cb.failures(), 0u);
+
+        // Zero cooldown: the next allow() becomes the probe.
+        Dodo::CircuitBreaker probe{{.threshold = 1, .window_ticks = 0, .cooldown_ticks = 0, .open_code = Dodo::Code::Timeout}};
+        (void)probe.record(bad);
+        TEST_ASSERT(probe.state() == State::Open);
+        TEST_ASSERT(probe.allow().ok());
+        TEST_ASSERT(probe.state() == State::HalfOpen);
+        (void)probe.record(bad);
+        TEST_ASSERT(probe.state() == State::Open);
+        TEST_EQ(probe.call([]{ return Dodo::Status::ok_status(); }).code, Dodo::Code::Ok);
+        TEST_ASSERT(probe.state() == State::Closed);
+        TEST_EQ(probe.call([&]{ return scenario_policy_null<TrivialPolicy>(nullptr); }).code, Dodo::Code::NullPointer);
+        TEST_ASSERT(probe.state() == State::Open);
+
+#if defined(__x86_64__) || defined(__i386__)
+        // One probe per cooldown; an abandoned probe (no record()) is replaced after another cooldown.
+        constexpr uint64_t kCooldown = 2'000'000;
+        const auto wait_cooldown = [] {
+            const uint64_t t0 = Dodo::internal::read_tsc();
+            while (Dodo::internal::read_tsc() - t0 <= kCooldown) {
+            }
+        };
+        Dodo::CircuitBreaker lost{{.threshold = 1, .window_ticks = 0, .cooldown_ticks = kCooldown, .open_code = Dodo::Code::Timeout}};
+        (void)lost.record(bad);
+        TEST_EQ(lost.allow().code, Dodo::Code::Timeout); // still cooling down
+        wait_cooldown();
+        TEST_ASSERT(lost.allow().ok());
+        TEST_ASSERT(lost.state() == State::HalfOpen);
+        TEST_EQ(lost.allow().code, Dodo::Code::Timeout); // one probe at a time
+        wait_cooldown(); // the probe's caller returned early and never recorded
+        TEST_ASSERT(lost.allow().ok());
+        TEST_EQ(lost.allow().code, Dodo::Code::Timeout);
+        TEST_ASSERT(lost.record(good).ok());
+        TEST_ASSERT(lost.state() == State::Closed);
+
+        // One-tick window: failures never accumulate, so it never trips.
+        Dodo::CircuitBreaker decay{{.threshold = 2, .window_ticks = 1, .cooldown_ticks = UINT64_MAX}};
+        for (int i = 0; i < 100; ++i) {
+            (void)decay.record(bad);
+        }
+        TEST_ASSERT(decay.state() == State::Closed);
+#endif
+
+        // Concurrent callers: the breaker ends open and every caller sees a valid Status.
+        Dodo::CircuitBreaker shared{{.threshold = 64, .window_ticks = 0, .cooldown_ticks = UINT64_MAX}};
+        std::atomic<uint64_t> short_circuited{0};
+        std::vector<std::thread> th;
+        for (int t = 0; t < 4; ++t) {
+            th.emplace_back([&]{
+                for (int i = 0; i < 10'000; ++i) {
+                    const Dodo::Status st = shared.call([]{ return Dodo::Status::fail(Dodo::Code::Timeout); });
+                    if (st.code == Dodo::Code::ExternalFault) {
+                        short_circuited.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            });
+        }
+        for (auto& x : th) x.join();
+        TEST_ASSERT(shared.state() == State::Open);
+        TEST_ASSERT(short_circuited.load(std::memory_order_relaxed) >= 40'000u - 64u - 4u);
+    }
+
+    { // 19) Deadlines: Code::Timeout from a clock read + compare, pluggable clock
+        Dodo::set_fallback_handler(recording_fallback_handler);
+        using TestDeadline = Dodo::BasicDeadline<TestClock>;
+        TestClock::ticks = 1'000;
+        const TestDeadline d = TestDeadline::after_us(5);
+        TEST_EQ(d.at, 6'000ull);
+        TEST_ASSERT(DODO_CHECK_DEADLINE(d).ok());
+        TestClock::ticks = 5'999;
+        TEST_ASSERT(DODO_CHECK_DEADLINE(d).ok());
+        TEST_EQ(d.remaining(), 1ull);
+        TestClock::ticks = 6'000;
+        TEST_ASSERT(d.expired());
+        TEST_EQ(d.remaining(), 0ull);
+        TEST_EQ(DODO_CHECK_DEADLINE(d).code, Dodo::Code::Timeout);
+        TEST_EQ(g_last_failure.code, Dodo::Code::Timeout);
+#if !defined(DODO_FAST_MODE) && !defined(DODO_COMPACT_MODE)
+        TEST_ASSERT(g_last_failure.expr != nullptr && std::strcmp(g_last_failure.expr, "d") == 0);
+#endif
+        TEST_ASSERT(Dodo::check_deadline(TestDeadline::never(), DODO_CTX(Dodo::Code::Timeout, Dodo::Severity::Recoverable)).ok());
+        TestClock::ticks = UINT64_MAX - 10;
+        TEST_EQ(TestDeadline::after_ms(1).at, UINT64_MAX); // saturates
+        TEST_ASSERT(!TestDeadline::at_ticks(UINT64_MAX).expired());
+        TestClock::ticks = 1'000;
+        TEST_EQ(TestDeadline::after_ms(UINT64_MAX / 1'000'000 + 1).at, UINT64_MAX); // ms -> ns would wrap
+        TEST_EQ(TestDeadline::after_us(UINT64_MAX / 1'000 + 1).at, UINT64_MAX); // us -> ns would wrap
+        TEST_EQ(TestDeadline::after_ms(UINT64_MAX).at, UINT64_MAX);
+        TEST_EQ(TestDeadline::after_ms(7).at, 7'001'000ull);
+
+        TEST_EQ(Dodo::internal::mul_q32(1'000, uint64_t{3} << 32), 3'000ull);
+        TEST_EQ(Dodo::internal::mul_q32(uint64_t{1} << 40, uint64_t{1} << 31), uint64_t{1} << 39);
+        TEST_EQ(Dodo::internal::mul_q32(UINT64_MAX, uint64_t{3} << 32), UINT64_MAX); // 3 ticks/ns: saturates
+
+        // TSC clock: calibrated against steady_clock, so a 200 us deadline takes >= ~200 us.
+        Dodo::TscClock::calibrate();
+        TEST_ASSERT(Dodo::TscClock::ticks_per_ns_q32() != 0);
+        TEST_ASSERT(DODO_CHECK_DEADLINE(Dodo::Deadline::after_ms(1'000)).ok());
+        const auto t0 = std::chrono::steady_clock::now();
+        const Dodo::Deadline soon = Dodo::Deadline::after_us(200);
+        while (DODO_CHECK_DEADLINE(soon).ok()) {
+        }
+        const auto waited = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0);
+        TEST_ASSERT(waited.count() >= 150);
+
+        const Dodo::BasicDeadline<Dodo::SteadyClock> sd = Dodo::BasicDeadline<Dodo::SteadyClock>::after_ms(1'000);
+        TEST_ASSERT(DODO_CHECK_DEADLINE(sd).ok());
+        TEST_ASSERT(!DODO_CHECK_DEADLINE(Dodo::BasicDeadline<Dodo::SteadyClock>::at_ticks(0)).ok());
+    }
+
+    { // 20) Checked arithmetic: exact value or Code::Overflow through the fallback handler
+        Dodo::set_fallback_handler(recording_fallback_handler);
+        g_recoverable_hits.store(0, std::memory_order_relaxed);
+        const int64_t px = 450'025;
+        const int64_t qty = 1'000;
+        const Dodo::Result<int64_t> n = DODO_CHECK_MUL(px, qty);
+        TEST_ASSERT(n.ok());
+        TEST_EQ(n.value, int64_t{450'025'000});
+        TEST_EQ(scenario_notional_checked(px, qty).value, scenario_notional_div(px, qty).value);
+        TEST_EQ(g_recoverable_hits.load(std::memory_order_relaxed), 0ull);
+
+        const int64_t big = INT64_MAX / 2 + 1;
+        TEST_EQ(DODO_CHECK_MUL(big, int64_t{2}).code, Dodo::Code::Overflow);
+        TEST_EQ(g_last_failure.code, Dodo::Code::Overflow);
+#if !defined(DODO_FAST_MODE) && !defined(DODO_COMPACT_MODE)
+        TEST_ASSERT(g_last_failure.expr != nullptr && std::strcmp(g_last_failure.expr, "big * int64_t{2}") == 0);
+#endif
+        TEST_EQ(scenario_notional_checked(big, -3).code, Dodo::Code::Overflow);
+        TEST_EQ(scenario_notional_div(big, -3).code, Dodo::Code::Overflow);
+        TEST_EQ(DODO_CHECK_MUL(INT64_MIN, int64_t{-1}).code, Dodo::Code::Overflow);
+        TEST_EQ(DODO_CHECK_MUL(INT64_MIN, int64_t{1}).value, INT64_MIN);
+
+        TEST_EQ(DODO_CHECK_ADD(INT32_MAX, 1).code, Dodo::Code::Overflow);
+        TEST_EQ(DODO_CHECK_ADD(INT32_MAX - 1, 1).value, INT32_MAX);
+        TEST_EQ(DODO_CHECK_ADD(uint8_t{200}, 55).value, uint8_t{255});
+        TEST_EQ(DODO_CHECK_ADD(uint8_t{200}, 56).code, Dodo::Code::Overflow);
+        TEST_EQ(DODO_CHECK_SUB(0u, 1u).code, Dodo::Code::Overflow);
+        TEST_EQ(DODO_CHECK_SUB(INT64_MIN + 1, int64_t{1}).value, INT64_MIN);
+        TEST_EQ(DODO_CHECK_SUB(INT64_MIN, int64_t{1}).code, Dodo::Code::Overflow);
+
+        // Mixed operand types are checked exactly, without converting b first.
+        const int32_t px32 = 2;
+        const int64_t qty64 = 5'000'000'001;
+        TEST_EQ(DODO_CHECK_MUL(px32, qty64).code, Dodo::Code::Overflow); // b alone does not fit int32_t
+        TEST_EQ(DODO_CHECK_MUL(int32_t{3}, int64_t{7}).value, 21);
+        static_assert(std::is_same_v<decltype(DODO_CHECK_MUL(px32, qty64).value), int32_t>);
+        TEST_EQ(DODO_CHECK_ADD(uint8_t{200}, -100).value, uint8_t{100});
+        TEST_EQ(DODO_CHECK_ADD(int32_t{-1}, uint64_t{1} << 32).code, Dodo::Code::Overflow);
+        TEST_EQ(DODO_CHECK_SUB(int8_t{27}, 155u).value, int8_t{-128});
+        TEST_EQ(DODO_CHECK_SUB(int8_t{26}, 155u).code, Dodo::Code::Overflow);
+        TEST_EQ(DODO_CHECK_MUL(uint16_t{300}, uint16_t{300}).code, Dodo::Code::Overflow);
+
+        TEST_EQ(DODO_CHECK_NARROW(int32_t, int64_t{INT32_MAX}).value, INT32_MAX);
+        TEST_EQ(DODO_CHECK_NARROW(int32_t, int64_t{INT32_MAX} + 1).code, Dodo::Code::Overflow);
+        TEST_EQ(DODO_CHECK_NARROW(uint32_t, -1).code, Dodo::Code::Overflow); // sign change
+        TEST_EQ(DODO_CHECK_NARROW(int8_t, 200u).code, Dodo::Code::Overflow);
+        TEST_EQ(DODO_CHECK_NARROW(uint64_t, int16_t{7}).value, 7ull);
+
+        // Overflow predicates agree with widened arithmetic on edge cases.
+        for (const int32_t a : {0, 1, -1, 46'341, -46'341, INT32_MAX, INT32_MIN}) {
+            for (const int32_t b : {0, 1, -1, 46'341, 2, INT32_MAX, INT32_MIN}) {
+                int32_t r = 0;
+                const int64_t wide = int64_t{a} * int64_t{b};
+                TEST_EQ(Dodo::internal::mul_overflow(a, b, &r), wide < INT32_MIN || wide > INT32_MAX);
+                const int64_t sum = int64_t{a} + int64_t{b};
+                TEST_EQ(Dodo::internal::add_overflow(a, b, &r), sum < INT32_MIN || sum > INT32_MAX);
+            }
+        }
+
+        // The portable predicates (non-GCC/Clang builds) match the builtins, mixed types included.
+        TEST_ASSERT((portable_overflow_matches<int32_t, int64_t>()));
+        TEST_ASSERT((portable_overflow_matches<int64_t, uint64_t>()));
+        TEST_ASSERT((portable_overflow_matches<uint64_t, int64_t>()));
+        TEST_ASSERT((portable_overflow_matches<uint8_t, int>()));
+        TEST_ASSERT((portable_overflow_matches<int8_t, unsigned>()));
+        TEST_ASSERT((portable_overflow_matches<uint16_t, uint16_t>()));
+        TEST_ASSERT((portable_overflow_matches<int16_t, int16_t>()));
+        TEST_ASSERT((portable_overflow_matches<int64_t, int64_t>()));
+
+        // Span form: one branch per batch, first bad index on failure.
+        int32_t pxs[kNotionalLevels];
+        int32_t qtys[kNotionalLevels];
+        int32_t out[kNotionalLevels];
+        for (size_t i = 0; i < kNotionalLevels; ++i) {
+            pxs[i] = static_cast<int32_t>(10'000 + i);
+            qtys[i] = static_cast<int32_t>(100 + i);
+        }
+        TEST_ASSERT(scenario_notional_all(pxs, qtys, out).ok());
+        TEST_EQ(out[3], 10'003 * 103);
+        qtys[9] = 1'000'000;
+        qtys[12] = 1'000'000;
+        size_t bad_at = 0;
+        TEST_EQ(DODO_CHECK_MUL_ALL(std::span<const int32_t>(pxs), std::span<const int32_t>(qtys), std::span<int32_t>(out),
+                                   &bad_at).code, Dodo::Code::Overflow);
+        TEST_EQ(bad_at, 9u);
+        bad_at = 0;
+        TEST_EQ(DODO_CHECK_MUL_ALL(std::span<const int32_t>(pxs, 4), std::span<const int32_t>(qtys, 3),
+                                   std::span<int32_t>(out), &bad_at).code, Dodo::Code::Overflow); // size mismatch
+        TEST_EQ(bad_at, 3u);
+    }
+
+    { // 21) Contract levels: *_AUDIT stripped (unevaluated) below DODO_CONTRACT_AUDIT, *_ALWAYS never
+        Dodo::set_fallback_handler(recording_fallback_handler);
+        int evaluated = 0;
+        const auto touch = [&evaluated](bool v) { ++evaluated; return v; };
+#if DODO_CONTRACT_LEVEL >= DODO_CONTRACT_AUDIT
+        TEST_EQ(DODO_REQUIRE_AUDIT(touch(false), Dodo::Code::PreconditionFailed).code, Dodo::Code::PreconditionFailed);
+        TEST_EQ(DODO_ENSURE_AUDIT(touch(false), Dodo::Code::PostconditionFailed).code, Dodo::Code::PostconditionFailed);
+        DODO_INVARIANT_AUDIT(touch(true), Dodo::Code::InvariantBroken);
+        TEST_EQ(evaluated, 3);
+#else
+        TEST_ASSERT(DODO_REQUIRE_AUDIT(touch(false), Dodo::Code::PreconditionFailed).ok());
+        TEST_ASSERT(DODO_ENSURE_AUDIT(touch(false), Dodo::Code::PostconditionFailed).ok());
+#if !defined(DODO_CONTRACT_ASSUME)
+        DODO_INVARIANT_AUDIT(touch(false), Dodo::Code::InvariantBroken); // would panic if compiled in
+#endif
+        TEST_EQ(evaluated, 0);
+#endif
+        evaluated = 0;
+        TEST_EQ(DODO_REQUIRE_ALWAYS(touch(false), Dodo::Code::PreconditionFailed).code, Dodo::Code::PreconditionFailed);
+        DODO_INVARIANT_ALWAYS(touch(true), Dodo::Code::InvariantBroken);
+        TEST_EQ(evaluated, 2);
+
+        int32_t book[kBookFields];
+        for (size_t i = 0; i < kBookFields; ++i) book[i] = static_cast<int32_t>(1000 + i);
+        TEST_ASSERT(scenario_book_audited(book).ok());
+    }
+
+    { // 22) constexpr checks: the compile-time validator also runs (and fails normally) at runtime
+        Dodo::set_fallback_handler(recording_fallback_handler);
+        TEST_ASSERT(validate_instruments(kInstruments).ok());
+        static_assert(DODO_CHECK_ADD(uint8_t{200}, 55).value == 255); // macros at block scope
+        MockInstrument bad[] = {{1, 100, 0x1000}, {5, 10, 0x2044}};
+        TEST_EQ(validate_instruments(bad).code, Dodo::Code::Misaligned);
+        TEST_EQ(g_last_failure.code, Dodo::Code::Misaligned);
+#if !defined(DODO_FAST_MODE) && !defined(DODO_COMPACT_MODE)
+        TEST_ASSERT(g_last_failure.func != nullptr && std::strcmp(g_last_failure.func, "validate_instruments") == 0);
+#endif
+        bad[1] = {5, 20'000, 0x2040};
+        TEST_EQ(validate_instruments(bad).code, Dodo::Code::Overflow); // 100'000 does not fit uint16_t
+        TEST_ASSERT(Dodo::check_aligned(uintptr_t{0x40}, 64, Dodo::Code::Misaligned,
+                                        DODO_CTX(Dodo::Code::Misaligned, Dodo::Severity::Recoverable)).ok());
+
+        // DODO_TRY early returns: a Status in a deduced-return lambda, a Result<T> otherwise.
+        TEST_EQ(deduced_try(0).code, Dodo::Code::OutOfRange);
+        TEST_EQ(result_try(0).code, Dodo::Code::OutOfRange);
+        TEST_EQ(result_try(3).value, 3u);
+        const Dodo::Result<uint32_t> from_ok = Dodo::Status::ok_status();
+        TEST_EQ(from_ok.code, Dodo::Code::InternalFault);
+    }
+
+    { // 23) Code domains: packed into Status, propagated by DODO_TRY, named through the registry
+        Dodo::set_fallback_handler(domain_routing_fallback);
+        g_venue_hits.store(0, std::memory_order_relaxed);
+        TEST_ASSERT(venue_send(1).ok());
+        const Dodo::Status s = venue_send(0);
+        TEST_EQ(s.code, kVenue.code(VenueError::Throttled));
+        TEST_EQ(g_venue_hits.load(std::memory_order_relaxed), 1ull);
+        TEST_EQ(scenario_safety_limits(nullptr).code, Dodo::Code::NullPointer);
+        TEST_EQ(g_venue_hits.load(std::memory_order_relaxed), 1ull); // core codes are domain 0
+
+        TEST_ASSERT(std::strcmp(Dodo::code_name(Dodo::Code::Overflow), "Overflow") == 0);
+        TEST_ASSERT(std::strcmp(Dodo::code_name(s.code), "unknown") == 0); // not registered yet
+        TEST_ASSERT(Dodo::register_code_domain(kVenue));
+        TEST_ASSERT(Dodo::register_code_domain(kVenue)); // idempotent
+        static constexpr Dodo::CodeDomain kClash{3, "clash", kVenueCodes};
+        TEST_ASSERT(!Dodo::register_code_domain(kClash));
+        TEST_ASSERT(!Dodo::register_code_domain(Dodo::kCoreDomain));
+        TEST_ASSERT(Dodo::find_code_domain(3) == &kVenue);
+        TEST_ASSERT(std::strcmp(Dodo::code_name(s.code), "Throttled") == 0);
+        TEST_ASSERT(Dodo::code_severity(kVenue.code(VenueError::SessionDown)) == Dodo::Severity::Fatal);
+        TEST_ASSERT(Dodo::code_severity(Dodo::Code::InvariantBroken) == Dodo::Severity::Fatal);
+        TEST_ASSERT(std::strcmp(Dodo::code_name(kVenue.code(900)), "unknown") == 0);
+
+        // Stats and sampler slots are per domain: venue codes neither share a slot
+        // with each other nor with the core code of the same value.
+        const Dodo::Code rejected = kVenue.code(VenueError::Rejected);
+        const Dodo::Code throttled = kVenue.code(VenueError::Throttled);
+        const Dodo::Code core_twin = static_cast<Dodo::Code>(Dodo::code_value(throttled));
+        constexpr auto stats_slot = Dodo::internal::code_slot<Dodo::Stats::kDomains, Dodo::Stats::kCodes>;
+        TEST_ASSERT(stats_slot(throttled) != stats_slot(core_twin));
+        Dodo::set_fallback_handler(Dodo::stats_fallback);
+        const uint64_t rejected_before = Dodo::stats().count(rejected);
+        const uint64_t throttled_before = Dodo::stats().count(throttled);
+        const uint64_t twin_before = Dodo::stats().count(core_twin);
+        for (int i = 0; i < 3; ++i) {
+            (void)DODO_REQUIRE(false, rejected);
+        }
+        (void)DODO_REQUIRE(false, throttled);
+        TEST_EQ(Dodo::stats().count(rejected) - rejected_before, 3ull);
+        TEST_EQ(Dodo::stats().count(throttled) - throttled_before, 1ull);
+        TEST_EQ(Dodo::stats().count(core_twin), twin_before);
+        uint64_t reported = 0;
+        Dodo::stats().for_each([&](Dodo::Code c, uint64_t n) noexcept {
+            if (c == rejected) {
+                reported = n;
+            }
+        });
+        TEST_EQ(reported, Dodo::stats().count(rejected));
+
+        Dodo::install_fallback_sampler();
+        Dodo::set_sample_rule(rejected, Dodo::SampleRule{0, 0, 0}); // admit none
+        TEST_EQ(Dodo::get_sample_rule(throttled).one_in, 1u);
+        TEST_EQ(Dodo::get_sample_rule(core_twin).one_in, 1u);
+        const uint64_t suppressed_before = Dodo::suppressed_count(rejected);
+        const uint64_t throttled_suppressed = Dodo::suppressed_count(throttled);
+        for (int i = 0; i < 4; ++i) {
+            TEST_EQ(DODO_REQUIRE(false, rejected).code, rejected);
+            TEST_EQ(DODO_REQUIRE(false, throttled).code, throttled);
+        }
+        TEST_EQ(Dodo::suppressed_count(rejected) - suppressed_before, 4ull);
+        TEST_EQ(Dodo::suppressed_count(throttled), throttled_suppressed);
+        TEST_EQ(Dodo::stats().count(rejected) - rejected_before, 3ull); // suppressed before stats_fallback
+        TEST_EQ(Dodo::stats().count(throttled) - throttled_before, 5ull);
+        Dodo::set_sample_rule(rejected, Dodo::SampleRule{});
+
+        Dodo::set_fallback_handler(recording_fallback_handler);
+    }
+
+    { // 24) Failure payload: operands reach the handler and the flight recorder, only on failure
+        Dodo::set_fallback_handler(recording_fallback_handler);
+        const auto text_is = [](const char* with_expr, const char* without_expr) noexcept {
+#if defined(DODO_FAST_MODE) || defined(DODO_COMPACT_MODE)
+            (void)with_expr;
+            return std::strcmp(g_last_failure.text, without_expr) == 0;
+#else
+            (void)without_expr;
+            return std::strcmp(g_last_failure.text, with_expr) == 0;
+#endif
+        };
+#ifndef DODO_NO_FAILURE_PAYLOAD
+        const uint32_t size = 5'242'880;
+        TEST_EQ(DODO_CHECK_RANGE(size, 1u, 4'194'304u, Dodo::Code::OutOfRange).code, Dodo::Code::OutOfRange);
+        TEST_ASSERT(g_last_failure.has_payload && g_last_failure.payload.kind == Dodo::PayloadKind::Range);
+        TEST_ASSERT(g_last_failure.payload.types[0] == Dodo::OperandType::Unsigned);
+        TEST_ASSERT(text_is("size=5242880 not in [1, 4194304]", "value=5242880 not in [1, 4194304]"));
+
+        const int32_t level = -5;
+        (void)DODO_CHECK_RANGE(level, 0, 10, Dodo::Code::OutOfRange);
+        TEST_ASSERT(text_is("level=-5 not in [0, 10]", "value=-5 not in [0, 10]"));
+        const double px = 1.5;
+        (void)DODO_CHECK_RANGE(px, 2.0, 3.0, Dodo::Code::OutOfRange);
+        TEST_ASSERT(text_is("px=1.5 not in [2, 3]", "value=1.5 not in [2, 3]"));
+
+        (void)Dodo::check_aligned(uintptr_t{0x2044}, 64, Dodo::Code::Misaligned,
+                                  DODO_MAKE_FAIL(Dodo::Severity::Recoverable, Dodo::Code::Misaligned, DODO_EXPR_STR(base)));
+        TEST_ASSERT(text_is("base=0x2044 not aligned to 64", "value=0x2044 not aligned to 64"));
+        alignas(8) const unsigned char buf[16]{};
+        (void)DODO_CHECK_ALIGNED(buf + 1, 8, Dodo::Code::Misaligned);
+        TEST_EQ(g_last_failure.payload.operands[0], static_cast<uint64_t>(reinterpret_cast<uintptr_t>(buf + 1)));
+
+        const int32_t qty = 100'000;
+        TEST_EQ(DODO_CHECK_MUL(qty, qty).code, Dodo::Code::Overflow);
+        TEST_ASSERT(std::strcmp(g_last_failure.text, "100000 * 100000 overflows") == 0);
+        (void)DODO_CHECK_SUB(uint8_t{1}, 2);
+        TEST_ASSERT(std::strcmp(g_last_failure.text, "1 - 2 overflows") == 0);
+        (void)DODO_CHECK_NARROW(uint8_t, qty);
+        TEST_ASSERT(text_is("qty=100000 does not fit the target type", "value=100000 does not fit the target type"));
+
+        const MockOrder order{};
+        const int64_t limit = 10;
+        const int64_t want = 25;
+        TEST_ASSERT(DODO_REQUIRE_WITH(want <= limit, Dodo::Code::OutOfRange, &order, want, limit, &order).code ==
+                    Dodo::Code::OutOfRange);
+        TEST_ASSERT(g_last_failure.payload.kind == Dodo::PayloadKind::Values && g_last_failure.payload.count == 3);
+        TEST_ASSERT(g_last_failure.payload.context == &order);
+        TEST_ASSERT(g_last_failure.payload.types[2] == Dodo::OperandType::Pointer);
+        TEST_ASSERT(std::strncmp(g_last_failure.text, "want <= limit failed with 25, 10, 0x", 36) == 0 ||
+                    std::strncmp(g_last_failure.text, "value failed with 25, 10, 0x", 28) == 0);
+        TEST_ASSERT(DODO_REQUIRE_WITH(true, Dodo::Code::OutOfRange, nullptr, want).ok());
+
+        TestClock::ticks = 500;
+        (void)DODO_CHECK_DEADLINE(Dodo::BasicDeadline<TestClock>::at_ticks(400));
+        TEST_ASSERT(std::strcmp(g_last_failure.text, "now=500 past deadline 400") == 0);
+
+        const int32_t lanes[] = {1, 2, 3, 40, 5};
+        size_t bad = 0;
+        (void)DODO_CHECK_RANGE_ALL(lanes, 0, 10, Dodo::Code::OutOfRange, &bad);
+        TEST_EQ(bad, 3u);
+        TEST_EQ(g_last_failure.payload.operands[0], 40ull);
+
+        // Checks without operands, hand-built failures and copies carry no payload.
+        (void)DODO_REQUIRE(false, Dodo::Code::PreconditionFailed);
+        TEST_ASSERT(!g_last_failure.has_payload && g_last_failure.text[0] == '\0');
+        Dodo::set_fallback_handler([](const Dodo::Failure& f) noexcept {
+            const Dodo::Failure copy = f;
+            g_recoverable_hits.store(Dodo::payload_of(f) != nullptr && Dodo::payload_of(copy) == nullptr,
+                                     std::memory_order_relaxed);
+            return Dodo::Status::fail(f.code);
+        });
+        (void)DODO_CHECK_RANGE(size, 1u, 10u, Dodo::Code::OutOfRange);
+        TEST_EQ(g_recoverable_hits.load(std::memory_order_relaxed), 1ull);
+        Dodo::set_fallback_handler(recording_fallback_handler);
+        const Dodo::Failure hand_built{Dodo::Code::InternalFault, Dodo::Severity::Recoverable, {}};
+        TEST_ASSERT(Dodo::payload_of(hand_built) == nullptr);
+
+        // Truncation keeps the output NUL-terminated.
+        char small[8];
+        const Dodo::FailurePayload range{Dodo::PayloadKind::Range, 3, {}, {123456789, 0, 1}, nullptr};
+        TEST_EQ(Dodo::describe_failure(Dodo::Failure{}, range, small, sizeof(small)), 7u);
+        TEST_ASSERT(std::strcmp(small, "value=1") == 0);
+
+        // The flight recorder keeps the operands with the record.
+        Dodo::FlightRecorder& fr = Dodo::flight_recorder();
+        (void)fr.consume([](const Dodo::FlightRecord&) noexcept {});
+        Dodo::install_flight_recorder();
+        (void)DODO_CHECK_RANGE(size, 1u, 4'194'304u, Dodo::Code::OutOfRange);
+        char line[96] = "";
+        (void)fr.consume([&](const Dodo::FlightRecord& r) noexcept {
+            (void)Dodo::describe_failure(r.failure, r.payload, line, sizeof(line));
+        });
+        TEST_ASSERT(text_is("size=5242880 not in [1, 4194304]", "value=5242880 not in [1, 4194304]"));
+        TEST_ASSERT(std::strcmp(line, g_last_failure.text) == 0);
+        Dodo::set_fallback_handler(recording_fallback_handler);
+#else
+        (void)text_is;
+        (void)DODO_CHECK_RANGE(50, 0, 10, Dodo::Code::OutOfRange);
+        TEST_ASSERT(!g_last_failure.has_payload);
+#endif
+    }
+
+#if DODO_HAS_FORK
+    { // 25) Reporter: SPSC rings to a drain thread, exact accounting, shedding, fd/datagram sinks
+        std::vector<Dodo::FlightRecord> got;
+        {
+            Dodo::BasicReporter<CollectSink, 64, 8> rep{CollectSink{&got}};
+            Dodo::set_fallback_handler(counting_fallback_handler);
+            Dodo::install_reporter(rep);
+            Dodo::install_reporter(rep); // idempotent
+            g_recoverable_hits.store(0, std::memory_order_relaxed);
+            for (int i = 0; i < 3; ++i) (void)DODO_CHECK_RANGE(100 + i, 0, 10, Dodo::Code::OutOfRange);
+            TEST_EQ(g_recoverable_hits.load(std::memory_order_relaxed), 3ull); // forwarded
+            TEST_EQ(rep.drain_once(), 3u); // manual drain while not started
+            TEST_EQ(got.size(), 3u);
+#ifndef DODO_NO_FAILURE_PAYLOAD
+            TEST_ASSERT(got.size() == 3 && got[2].payload.kind == Dodo::PayloadKind::Range && got[2].payload.operands[0] == 102);
+#endif
+
+            // Threads fail concurrently with a live drain thread.
+            constexpr int kProducers = 4;
+            constexpr int kPerProducer = 20'000;
+            got.clear();
+            TEST_ASSERT(rep.start());
+            TEST_ASSERT(!rep.start());
+            std::vector<std::thread> th;
+            for (int t = 0; t < kProducers; ++t) {
+                th.emplace_back([] {
+                    for (int i = 0; i < kPerProducer; ++i) (void)DODO_CHECK_RANGE(1000 + i, 0, 10, Dodo::Code::OutOfRange);
+                });
+            }
+            for (auto& t : th) t.join();
+            rep.stop();
+            TEST_ASSERT(!rep.running());
+            const Dodo::ReporterCounters c = rep.counters();
+            TEST_EQ(c.pushed + c.dropped + c.shed + c.untracked, uint64_t(kProducers) * kPerProducer + 3);
+            TEST_EQ(c.delivered, c.pushed); // stop() flushed everything
+            TEST_EQ(got.size() + 3, c.delivered);
+            TEST_EQ(c.sink_errors, 0ull);
+            TEST_ASSERT(c.max_depth <= 64);
+            // Per producer, records arrive in push order.
+            uint64_t last[64]{};
+            bool ordered = true;
+            for (const Dodo::FlightRecord& r : got) {
+                ordered &= r.thread < 64 && r.tsc >= last[r.thread];
+                if (r.thread < 64) last[r.thread] = r.tsc;
+            }
+            TEST_ASSERT(ordered);
+            Dodo::uninstall_reporter();
+        }
+
+        { // Backpressure: a full ring drops, recoverable records are shed first, producers never wait
+            Dodo::BasicReporter<NullSink, 8, 4> rep{NullSink{}, {.batch = 256, .idle_sleep_us = 200, .shed_at = 6}};
+            int accepted = 0;
+            for (int i = 0; i < 7; ++i) accepted += rep.push(make_record(Dodo::Severity::Recoverable));
+            TEST_EQ(accepted, 6);
+            TEST_ASSERT(rep.push(make_record(Dodo::Severity::Fatal)));
+            TEST_ASSERT(rep.push(make_record(Dodo::Severity::Fatal)));
+            TEST_ASSERT(!rep.push(make_record(Dodo::Severity::Fatal)));
+            const Dodo::ReporterCounters c = rep.counters();
+            TEST_EQ(c.pushed, 8ull);
+            TEST_EQ(c.shed, 1ull);
+            TEST_EQ(c.dropped, 1ull);
+            TEST_EQ(rep.drain_once(), 8u);
+            TEST_ASSERT(rep.push(make_record(Dodo::Severity::Recoverable))); // space again
+        }
+
+        { // Slow sink: pushes stay non-blocking, overflow is counted
+            std::vector<Dodo::FlightRecord> slow;
+            Dodo::BasicReporter<CollectSink, 16, 4> rep{CollectSink{&slow, 5000}};
+            TEST_ASSERT(rep.start());
+            for (int i = 0; i < 2000; ++i) (void)rep.push(make_record(Dodo::Severity::Recoverable));
+            rep.stop();
+            const Dodo::ReporterCounters c = rep.counters();
+            TEST_ASSERT(c.dropped + c.shed > 0);
+            TEST_EQ(c.pushed + c.dropped + c.shed, 2000ull);
+            TEST_EQ(slow.size(), c.pushed);
+        }
+
+        { // Binary and text fd sinks through a pipe
+            int fds[2];
+            TEST_ASSERT(::pipe(fds) == 0);
+            Dodo::BasicReporter<Dodo::BinaryFdSink, 8, 4> bin{Dodo::BinaryFdSink{fds[1]}};
+            Dodo::install_reporter(bin);
+            (void)DODO_CHECK_RANGE(77, 0, 10, Dodo::Code::OutOfRange);
+            (void)DODO_REQUIRE(false, Dodo::Code::PreconditionFailed);
+            TEST_EQ(bin.drain_once(), 2u);
+            Dodo::FlightRecord back[2]{};
+            TEST_EQ(::read(fds[0], back, sizeof(back)), static_cast<ssize_t>(sizeof(back)));
+            TEST_EQ(back[0].failure.code, Dodo::Code::OutOfRange);
+#ifndef DODO_NO_FAILURE_PAYLOAD
+            TEST_EQ(back[0].payload.operands[0], 77ull);
+#endif
+            TEST_EQ(back[1].failure.code, Dodo::Code::PreconditionFailed);
+
+            Dodo::BasicReporter<Dodo::TextFdSink, 8, 4> text{Dodo::TextFdSink{fds[1], {}}};
+            Dodo::install_reporter(text);
+            (void)DODO_CHECK_RANGE(77, 0, 10, Dodo::Code::OutOfRange);
+            TEST_EQ(text.drain_once(), 1u);
+            char line[512]{};
+            const ssize_t n = ::read(fds[0], line, sizeof(line) - 1);
+            TEST_ASSERT(n > 0 && line[n - 1] == '\n');
+            TEST_ASSERT(std::strstr(line, " OutOfRange ") != nullptr);
+#ifndef DODO_NO_FAILURE_PAYLOAD
+            TEST_ASSERT(std::strstr(line, "=77 not in [0, 10]") != nullptr);
+#endif
+            Dodo::uninstall_reporter();
+            ::close(fds[0]);
+            ::close(fds[1]);
+        }
+
+        { // Datagram sink: whole records per datagram, gathered with sendmsg
+            int sv[2];
+            TEST_ASSERT(::socketpair(AF_UNIX, SOCK_DGRAM, 0, sv) == 0);
+            Dodo::BasicReporter<Dodo::DatagramSink, 8, 4> dg{Dodo::DatagramSink{sv[0], 3 * sizeof(Dodo::FlightRecord)}};
+            for (int i = 0; i < 7; ++i) TEST_ASSERT(dg.push(make_record(Dodo::Severity::Fatal)));
+            TEST_EQ(dg.drain_once(), 7u);
+            Dodo::FlightRecord buf[8];
+            ssize_t sizes[3]{};
+            for (ssize_t& sz : sizes) sz = ::recv(sv[1], buf, sizeof(buf), MSG_DONTWAIT);
+            TEST_EQ(sizes[0], static_cast<ssize_t>(3 * sizeof(Dodo::FlightRecord)));
+            TEST_EQ(sizes[1], static_cast<ssize_t>(3 * sizeof(Dodo::FlightRecord)));
+            TEST_EQ(sizes[2], static_cast<ssize_t>(sizeof(Dodo::FlightRecord)));
+            TEST_EQ(dg.counters().sink_errors, 0ull);
+            ::close(sv[0]);
+            ::close(sv[1]);
+        }
+        Dodo::set_fallback_handler(recording_fallback_handler);
+    }
+
+    { // 26) Crash record: fatal failure + flight-recorder history in a shared mapping, read after the child dies
+        Dodo::set_panic_handler(stress_panic_handler); // drop the chains earlier tests installed
+        alignas(8) unsigned char small[Dodo::crash_record_bytes(1) + 8]{};
+        TEST_ASSERT(!Dodo::install_crash_record(small, Dodo::crash_record_bytes(1) - 1));
+        TEST_ASSERT(!Dodo::install_crash_record(small + 4, Dodo::crash_record_bytes(1)));
+        TEST_ASSERT(Dodo::get_panic_handler() == stress_panic_handler);
+
+        const size_t bytes = Dodo::crash_record_bytes(4);
+        void* region = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        TEST_ASSERT(region != MAP_FAILED);
+        const pid_t pid = ::fork();
+        if (pid == 0) {
+            // Crash record first, recorder in front of it: the fatal failure is
+            // already in the ring when the record is written and is not repeated.
+            if (!Dodo::install_crash_record(region, bytes, static_cast<uint64_t>(::getpid()))) std::_Exit(112);
+            Dodo::install_flight_recorder();
+            for (int i = 0; i < 5; ++i) (void)DODO_CHECK_RANGE(100 + i, 0, 10, Dodo::Code::OutOfRange);
+            scenario_fatal_logic(true);
+            std::_Exit(111);
+        }
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        TEST_ASSERT(WIFEXITED(status));
+        TEST_EQ(WEXITSTATUS(status), static_cast<int>(Dodo::Code::InvariantBroken));
+
+        const Dodo::CrashHeader& h = *static_cast<const Dodo::CrashHeader*>(region);
+        TEST_EQ(h.magic, Dodo::kCrashMagic);
+        TEST_EQ(h.version, Dodo::kCrashVersion);
+        TEST_EQ(h.state.load(std::memory_order_acquire), static_cast<uint32_t>(Dodo::CrashState::Complete));
+        TEST_EQ(h.tag, static_cast<uint64_t>(pid));
+        TEST_EQ(h.capacity, 4u);
+        TEST_EQ(h.count.load(std::memory_order_relaxed), 4u); // fatal + newest 3 of 5
+        TEST_EQ(h.later.load(std::memory_order_relaxed), 0u);
+        TEST_ASSERT(h.tsc_per_ns_q32 != 0 && h.crash_tsc >= h.install_tsc);
+
+        const Dodo::CrashEntry* e = Dodo::crash_entries(h);
+        TEST_EQ(e[0].code, static_cast<uint16_t>(Dodo::Code::InvariantBroken));
+        TEST_EQ(e[0].sev, static_cast<uint8_t>(Dodo::Severity::Fatal));
+        TEST_EQ(e[0].tsc, h.crash_tsc);
+        TEST_EQ(e[0].thread, h.thread);
+        for (int i = 1; i < 4; ++i) {
+            TEST_EQ(e[i].code, static_cast<uint16_t>(Dodo::Code::OutOfRange));
+            TEST_ASSERT(e[i].tsc <= e[i - 1].tsc);
+#ifndef DODO_NO_FAILURE_PAYLOAD
+            TEST_EQ(e[i].kind, static_cast<uint8_t>(Dodo::PayloadKind::Range));
+            TEST_EQ(e[i].operands[0], static_cast<uint64_t>(105 - i));
+#endif
+        }
+#if !defined(DODO_FAST_MODE) && !defined(DODO_COMPACT_MODE)
+        TEST_ASSERT(std::strcmp(e[0].expr, "!corruption") == 0);
+        TEST_ASSERT(std::strstr(e[0].file, "stresstest.cpp") != nullptr);
+        TEST_ASSERT(e[0].line != 0 && e[0].func[0] != '\0');
+#endif
+        ::munmap(region, bytes);
+    }
+#endif
+
+#if DODO_HAS_COROUTINES
+    { // 27) Coroutines: DODO_CO_TRY / DODO_CO_TRY_ASSIGN co_return, co_check short-circuits, frames freed
+        g_recoverable_hits.store(0, std::memory_order_relaxed);
+        {
+            CoTask<Dodo::Result<int>> ok = co_sum_try(2, 3);
+            const Dodo::Result<int> r = ok.run();
+            TEST_ASSERT(r.ok());
+            TEST_EQ(r.value, 5);
+
+            CoTask<Dodo::Result<int>> bad = co_sum_try(2, 300);
+            const Dodo::Result<int> e = bad.run();
+            TEST_EQ(e.code, Dodo::Code::OutOfRange);
+            TEST_ASSERT(!bad.promise().short_circuited);
+            TEST_EQ(g_recoverable_hits.load(std::memory_order_relaxed), 1u);
+        }
+        TEST_EQ(g_live_frames, 0);
+
+        { // The macros add no frame state over an unchecked co_await.
+            CoTask<Dodo::Result<int>> checked = co_sum_try(1, 1);
+            const size_t checked_bytes = g_last_frame_bytes;
+            CoTask<Dodo::Result<int>> unchecked = co_sum_unchecked(1, 1);
+            TEST_ASSERT(checked_bytes <= g_last_frame_bytes);
+        }
+
+        {
+            CoTask<Dodo::Result<int>> early = co_sum_check(-1, 3);
+            TEST_EQ(early.run().code, Dodo::Code::OutOfRange);
+            TEST_ASSERT(early.promise().short_circuited);
+
+            // Nested: the short-circuited child resumes its awaiting parent.
+            CoTask<Dodo::Status> outer = co_outer(7, 500);
+            TEST_EQ(outer.run().code, Dodo::Code::OutOfRange);
+            TEST_ASSERT(!outer.promise().short_circuited);
+
+            CoTask<Dodo::Status> same = co_outer(4, 4);
+            TEST_EQ(same.run().code, Dodo::Code::PreconditionFailed);
+            TEST_ASSERT(same.promise().short_circuited);
+
+            CoTask<Dodo::Status> fine = co_outer(4, 5);
+            TEST_ASSERT(fine.run().ok());
+        }
+        TEST_EQ(g_live_frames, 0);
+        TEST_EQ(g_recoverable_hits.load(std::memory_order_relaxed), 4u);
+    }
+#endif
 
-    _mm_lfence();
-    uint64_t start = __rdtsc();
-    _mm_lfence();
+    { // 28) parallel_validate: every element once, lowest failing index, stop/cancel per chunk, inline re-entry
+        Dodo::BasicThreadPool<8> pool{3};
+        TEST_EQ(pool.workers(), 3u);
+
+        std::vector<std::atomic<uint32_t>> seen(10'007);
+        pool.run(seen.size(), [&](size_t t) noexcept { seen[t].fetch_add(1, std::memory_order_relaxed); });
+        size_t once = 0;
+        for (const auto& s : seen) once += s.load(std::memory_order_relaxed) == 1;
+        TEST_EQ(once, seen.size());
+
+        std::vector<uint32_t> items(10'007);
+        for (size_t i = 0; i < items.size(); ++i) items[i] = static_cast<uint32_t>(i);
+        const auto validate = [](const uint32_t& v) noexcept { // TrivialPolicy: no shared test recorder across threads
+            return Dodo::basic_check_range<TrivialPolicy>(v % 1000u, 0u, 996u, Dodo::Code::OutOfRange,
+                                                          Dodo::Failure{Dodo::Code::OutOfRange, Dodo::Severity::Recoverable, {}});
+        };
 
-    for (int i = 0; i < ITERATIONS; ++i) {
-        const Dodo::Status s = f();
+        const Dodo::ParallelResult none = Dodo::parallel_validate(std::span<const uint32_t>{items.data(), 990}, validate, pool);
+        TEST_ASSERT(none.status.ok());
+        TEST_EQ(none.failed, 0u);
+        TEST_EQ(none.processed, 990u);
+        TEST_EQ(none.first_failed, SIZE_MAX);
+        TEST_ASSERT(!none.cancelled);
+
+        std::vector<Dodo::Code> codes(items.size(), Dodo::Code::InternalFault);
+        const Dodo::ParallelResult all = Dodo::parallel_validate(items, validate, pool, {.codes = codes, .chunk = 64});
+        TEST_EQ(all.status.code, Dodo::Code::OutOfRange);
+        TEST_EQ(all.first_failed, 997u);
+        TEST_EQ(all.failed, 30u); // 997..999 in each of 10 thousands
+        TEST_EQ(all.processed, items.size());
+        size_t bad_codes = 0;
+        for (size_t i = 0; i < codes.size(); ++i) {
+            bad_codes += codes[i] != (i % 1000 >= 997 ? Dodo::Code::OutOfRange : Dodo::Code::Ok);
+        }
+        TEST_EQ(bad_codes, 0u);
+
+        const Dodo::ParallelResult first = Dodo::parallel_validate(items, validate, pool, {.stop_on_failure = true, .chunk = 64});
+        TEST_EQ(first.status.code, Dodo::Code::OutOfRange);
+        TEST_ASSERT(first.cancelled);
+        TEST_ASSERT(first.failed >= 1 && first.first_failed % 1000 >= 997);
+
+        const std::atomic<bool> abort{true};
+        const Dodo::ParallelResult cancelled = Dodo::parallel_validate(items, validate, pool, {.cancel = &abort, .cancel_code = Dodo::Code::Timeout});
+        TEST_EQ(cancelled.processed, 0u);
+        TEST_ASSERT(cancelled.cancelled);
+        TEST_EQ(cancelled.status.code, Dodo::Code::Timeout);
+
+        // run() from inside a task runs inline instead of deadlocking.
+        std::atomic<size_t> inner{0};
+        pool.run(4, [&](size_t) noexcept { pool.run(5, [&](size_t) noexcept { inner.fetch_add(1, std::memory_order_relaxed); }); });
+        TEST_EQ(inner.load(std::memory_order_relaxed), 20u);
+
+        Dodo::BasicThreadPool<8> serial{0};
+        TEST_EQ(Dodo::parallel_validate(items, validate, serial).failed, 30u);
+
+        // A failure on the last element stops nothing: not reported as cancelled.
+        const Dodo::ParallelResult last = Dodo::parallel_validate(std::span<const uint32_t>{items.data(), 998}, validate,
+                                                                  serial, {.stop_on_failure = true, .chunk = 64});
+        TEST_EQ(last.status.code, Dodo::Code::OutOfRange);
+        TEST_EQ(last.first_failed, 997u);
+        TEST_EQ(last.processed, 998u);
+        TEST_ASSERT(!last.cancelled);
+    }
 
-        ok   += static_cast<uint64_t>(s.ok());
-        fail += static_cast<uint64_t>(!s.ok());
+    { // 29) Failure traces: deterministic per seed, rates and bursts as specified; differential fuzz
+        const bench::TraceSpec uniform{"1%", 0.01};
+        const bench::Trace a = bench::make_trace(200'000, uniform, 42);
+        TEST_ASSERT(a == bench::make_trace(200'000, uniform, 42));
+        TEST_ASSERT(a != bench::make_trace(200'000, uniform, 43));
+        const size_t fails = bench::trace_failures(a);
+        TEST_ASSERT(fails > 1'700 && fails < 2'300);
+        TEST_EQ(bench::trace_failures(bench::make_trace(10'000, {"0%", 0.0}, 1)), 0u);
+
+        // Same mean rate, bursty: failures cluster, so far more fail right after a failure.
+        const bench::Trace b = bench::make_trace(200'000, {"bursty", 0.0001, 0.001, 0.05, 0.5}, 42);
+        const auto follow_rate = [](const bench::Trace& t) {
+            size_t pairs = 0;
+            for (size_t i = 1; i < t.size(); ++i) pairs += static_cast<size_t>(t[i - 1] & t[i]);
+            return double(pairs) / double(bench::trace_failures(t));
+        };
+        TEST_ASSERT(bench::trace_failures(b) > 1'000 && bench::trace_failures(b) < 3'000);
+        TEST_ASSERT(follow_rate(b) > 0.3 && follow_rate(a) < 0.05);
+
+        std::istringstream recorded("0010\n 01\t1\n");
+        TEST_ASSERT((bench::read_trace(recorded) == bench::Trace{0, 0, 1, 0, 0, 1, 1}));
+        std::istringstream garbage("0102");
+        TEST_ASSERT(bench::read_trace(garbage).empty());
 
-        g_sink ^= static_cast<uint16_t>(s.code);
-        std::atomic_signal_fence(std::memory_order_seq_cst);
+        for (uint64_t seed = 1; seed <= 8; ++seed) {
+            TEST_EQ(fuzz_round(seed, 2'000), 0u);
+        }
     }
 
-    _mm_lfence();
-    uint64_t end = __rdtsc();
-    _mm_lfence();
+    { // 30) DODO_REQUIRE_EXPECT: same results on the warm and cold endpoints; site profile export
+        Dodo::set_fallback_handler(recording_fallback_handler);
+        g_recoverable_hits.store(0, std::memory_order_relaxed);
+        const auto often = [](int v) noexcept { return DODO_REQUIRE_EXPECT(v > 3, Dodo::Code::OutOfRange, 0.7); };
+        const auto rarely = [](int v) noexcept { return DODO_REQUIRE_EXPECT(v > 3, Dodo::Code::OutOfRange, 0.999); };
+        const auto unprofiled = [](int v) noexcept { return DODO_REQUIRE_EXPECT(v > 3, Dodo::Code::OutOfRange, -1); };
+        Dodo::reset_site_counters();
+        for (int v = 0; v < 10; ++v) {
+            const Dodo::Code want = v > 3 ? Dodo::Code::Ok : Dodo::Code::OutOfRange;
+            TEST_EQ(often(v).code, want);
+            TEST_EQ(rarely(v).code, want);
+            TEST_EQ(unprofiled(v).code, want);
+        }
+        TEST_EQ(g_recoverable_hits.load(std::memory_order_relaxed), 12ull);
+
+        g_policy_hits.store(0, std::memory_order_relaxed);
+        TEST_EQ((Dodo::basic_require_expect<StaticPolicy, 0.5>(
+                    false, Dodo::Code::OutOfRange,
+                    DODO_MAKE_FAIL(Dodo::Severity::Recoverable, Dodo::Code::OutOfRange, "policy")).code),
+                Dodo::Code::OutOfRange);
+        TEST_EQ(g_policy_hits.load(std::memory_order_relaxed), 1ull);
+
+        constexpr auto positive = [](int v) constexpr { return DODO_REQUIRE_EXPECT(v > 0, Dodo::Code::OutOfRange, 0.3).ok(); };
+        static_assert(positive(1));
+        static_assert(Dodo::internal::profiled_pass("nowhere.cpp", 1) < 0.0);
+
+#if !defined(DODO_FAST_MODE) && !defined(DODO_COMPACT_MODE)
+        (void)often(0);
+        const Dodo::Site* site = g_last_failure.site;
+        TEST_ASSERT(site != nullptr);
+        static char profile[1 << 16];
+        const size_t len = Dodo::format_site_profile(profile, sizeof(profile));
+        TEST_EQ(len, std::strlen(profile));
+        char want[512];
+#ifdef DODO_SITE_PROFILE
+        std::snprintf(want, sizeof(want), "%s\t%u\t11\t5\n", site->file, site->line);
+#else
+        std::snprintf(want, sizeof(want), "%s\t%u\t0\t5\n", site->file, site->line);
+#endif
+        TEST_ASSERT(std::strstr(profile, want) != nullptr);
+
+        // A short buffer keeps whole lines only.
+        const size_t first = static_cast<size_t>(std::strchr(profile, '\n') - profile) + 1;
+        char small[512];
+        TEST_ASSERT(first + 2 <= sizeof(small));
+        TEST_EQ(Dodo::format_site_profile(small, first + 2), first);
+        TEST_EQ(std::strlen(small), first);
+#endif
+    }
 
-    const uint64_t total = end - start;
-    return { label, total, static_cast<double>(total) / ITERATIONS, ok, fail, g_sink };
+    { // 31) Binary failure encoding: round trip through a handler, streams, truncation, malformed input
+        Dodo::set_fallback_handler(encoding_fallback_handler);
+        g_encoded_used = 0;
+        const int bad = -7;
+        TEST_EQ(scenario_safety_limits(&bad).code, Dodo::Code::OutOfRange);
+        TEST_EQ(scenario_safety_limits(nullptr).code, Dodo::Code::NullPointer);
+        int ctx = 0;
+        const auto with = [&](int64_t a, uint64_t b, double c) noexcept {
+            return DODO_REQUIRE_WITH(false, Dodo::Code::PreconditionFailed, &ctx, a, b, c);
+        };
+        TEST_EQ(with(-123456789, UINT64_MAX, -0.5).code, Dodo::Code::PreconditionFailed);
+        Dodo::set_fallback_handler(recording_fallback_handler);
+        (void)with(0, 0, 0.0);
+        const uint64_t with_site = g_last_failure.site_bits;
+
+        Dodo::DecodedFailure d[3];
+        size_t at = 0;
+        for (Dodo::DecodedFailure& r : d) {
+            const size_t n = Dodo::decode_failure(g_encoded_log + at, g_encoded_used - at, r);
+            TEST_ASSERT(n != 0 && n <= Dodo::kMaxEncodedFailure);
+            at += n;
+        }
+        TEST_EQ(at, g_encoded_used);
+        TEST_EQ(d[0].code, Dodo::Code::OutOfRange);
+        TEST_EQ(d[0].sev, Dodo::Severity::Recoverable);
+#ifndef DODO_NO_FAILURE_PAYLOAD
+        TEST_EQ(d[0].payload.kind, Dodo::PayloadKind::Range);
+        TEST_EQ(d[0].payload.count, 3);
+        TEST_EQ(int64_t(d[0].payload.operands[0]), -7);
+        TEST_EQ(d[0].payload.operands[2], 1024u);
+        TEST_EQ(d[2].payload.kind, Dodo::PayloadKind::Values);
+        TEST_EQ(int64_t(d[2].payload.operands[0]), -123456789);
+        TEST_EQ(d[2].payload.operands[1], UINT64_MAX);
+        TEST_EQ(std::bit_cast<double>(d[2].payload.operands[2]), -0.5);
+        TEST_ASSERT(d[2].payload.types[2] == Dodo::OperandType::Float && d[2].payload.context == &ctx);
+#endif
+        TEST_EQ(d[1].code, Dodo::Code::NullPointer);
+        TEST_EQ(d[2].site, with_site);
+
+        char text[256];
+        TEST_ASSERT(Dodo::format_failure(d[0], text, sizeof(text), Dodo::kSameProcess) == std::strlen(text));
+        TEST_ASSERT(std::strncmp(text, "OutOfRange ", 11) == 0);
+#ifndef DODO_NO_FAILURE_PAYLOAD
+        TEST_ASSERT(std::strstr(text, "=-7 not in [0, 1024]") != nullptr);
+#endif
+#if !defined(DODO_FAST_MODE) && !defined(DODO_COMPACT_MODE)
+        TEST_ASSERT(std::strstr(text, "stresstest.cpp:") != nullptr);
+#endif
+        TEST_ASSERT(Dodo::format_failure(d[0], text, sizeof(text)) == std::strlen(text)); // never reads the Site
+        TEST_ASSERT(std::strstr(text, " site:") != nullptr);
+        Dodo::DecodedFailure foreign = d[0];
+        foreign.site = 0x10; // an address from another process: must not be dereferenced
+        (void)Dodo::format_failure(foreign, text, sizeof(text));
+        TEST_ASSERT(std::strstr(text, " site:00000010") != nullptr);
+
+        unsigned char rec[Dodo::kMaxEncodedFailure];
+        const Dodo::Failure plain{Dodo::Code::Timeout, Dodo::Severity::Fatal, {}};
+        const size_t len = Dodo::encode_failure(plain, nullptr, rec, sizeof(rec));
+        TEST_EQ(len, 8u);
+        TEST_EQ(Dodo::encode_failure(plain, nullptr, rec, len - 1), 0u);
+        TEST_EQ(Dodo::decode_failure(rec, len - 1, d[0]), 0u); // truncated
+        TEST_EQ(Dodo::decode_failure(rec, len, d[0]), len);
+        TEST_EQ(d[0].sev, Dodo::Severity::Fatal);
+        TEST_EQ(d[0].payload.kind, Dodo::PayloadKind::None);
+        rec[4] = 0xff; // unknown payload kind
+        TEST_EQ(Dodo::decode_failure(rec, len, d[0]), 0u);
+        rec[4] = 0;
+        rec[7] = 0x80; // site varint runs past the record
+        TEST_EQ(Dodo::decode_failure(rec, len, d[0]), 0u);
+    }
 }
 
-int main() {
+// Benchmark
+static volatile uint32_t g_value_sink = 0;
+
+// Usage: stresstest [--json PATH|-] [--csv PATH|-] [--config NAME] [--cpu N] [--hist]
+//                   [--baseline CSV [--threshold PCT] [--slack CYCLES]]
+//                   [--seed N] [--trace PATH] [--fuzz ROUNDS] [--site-profile PATH]
+// Exit code 3 when a scenario's p50 or p99 regresses against the baseline.
+// --seed picks the failure-replay streams; --trace adds a recorded one
+// (bench::read_trace format). --fuzz runs ROUNDS differential fuzz rounds
+// from --seed after the unit tests, instead of the benchmark.
+// --site-profile writes Dodo::format_site_profile() after the run (the input of
+// tools/dodo_profgen; evals are counted in -DDODO_SITE_PROFILE builds).
+static void write_report(const char* path, void (*writer)(std::ostream&, const bench::RunInfo&, const std::vector<bench::Report>&),
+                         const bench::RunInfo& info, const std::vector<bench::Report>& results, int& rc) {
+    if (std::strcmp(path, "-") == 0) {
+        writer(std::cout, info, results);
+        return;
+    }
+    std::ofstream out(path);
+    writer(out, info, results);
+    if (!out) {
+        std::cerr << "failed to write " << path << std::endl;
+        rc = 1;
+    }
+}
+
+static void write_site_profile(const char* path, int& rc) {
+    static char profile[1 << 20];
+    const size_t len = Dodo::format_site_profile(profile, sizeof(profile));
+    std::ofstream out(path);
+    out.write(profile, static_cast<std::streamsize>(len));
+    if (!out) {
+        std::cerr << "failed to write " << path << std::endl;
+        rc = 1;
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* json_path = nullptr;
+    const char* csv_path = nullptr;
+    const char* baseline_path = nullptr;
+    double threshold_pct = 10.0;
+    uint32_t slack_cycles = 2;
+    bench::RunInfo info;
+    info.config = "default";
+    info.compiler = __VERSION__;
+    info.isa = DODO_SIMD_ISA;
+#ifdef DODO_FAST_MODE
+    info.fast_mode = true;
+#endif
+    int cpu = bench::current_cpu();
+    bool show_hist = false;
+    uint64_t seed = 0x5EED;
+    const char* trace_path = nullptr;
+    long fuzz_rounds = 0;
+    const char* site_profile_path = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (a == "--json" && i + 1 < argc) json_path = argv[++i];
+        else if (a == "--csv" && i + 1 < argc) csv_path = argv[++i];
+        else if (a == "--baseline" && i + 1 < argc) baseline_path = argv[++i];
+        else if (a == "--threshold" && i + 1 < argc) threshold_pct = std::atof(argv[++i]);
+        else if (a == "--slack" && i + 1 < argc) slack_cycles = static_cast<uint32_t>(std::atoi(argv[++i]));
+        else if (a == "--config" && i + 1 < argc) info.config = argv[++i];
+        else if (a == "--cpu" && i + 1 < argc) cpu = std::atoi(argv[++i]);
+        else if (a == "--hist") show_hist = true;
+        else if (a == "--seed" && i + 1 < argc) seed = std::strtoull(argv[++i], nullptr, 0);
+        else if (a == "--trace" && i + 1 < argc) trace_path = argv[++i];
+        else if (a == "--fuzz" && i + 1 < argc) fuzz_rounds = std::atol(argv[++i]);
+        else if (a == "--site-profile" && i + 1 < argc) site_profile_path = argv[++i];
+        else {
+            std::cerr << "usage: " << argv[0] << " [--json PATH|-] [--csv PATH|-] [--config NAME] [--cpu N] [--hist]"
+                      << " [--baseline CSV [--threshold PCT] [--slack CYCLES]]"
+                      << " [--seed N] [--trace PATH] [--fuzz ROUNDS] [--site-profile PATH]" << std::endl;
+            return 2;
+        }
+    }
+
     // Run correctness + recording tests first.
     run_unit_tests();
 
@@ -330,65 +2228,380 @@ int main() {
         return 1;
     }
 
+    if (fuzz_rounds > 0) {
+        constexpr size_t kFuzzCalls = 100'000;
+        size_t bad = 0;
+        for (long r = 0; r < fuzz_rounds; ++r) bad += fuzz_round(seed + static_cast<uint64_t>(r), kFuzzCalls);
+        std::cout << "Fuzz: " << fuzz_rounds << " rounds x " << kFuzzCalls << " calls from seed " << seed << ", "
+                  << bad << " disagreement(s)" << std::endl;
+        int rc = bad == 0 ? 0 : 1;
+        if (site_profile_path != nullptr) write_site_profile(site_profile_path, rc);
+        return rc;
+    }
+
+    bench::Trace recorded;
+    if (trace_path != nullptr) {
+        std::ifstream in(trace_path);
+        recorded = bench::read_trace(in);
+        if (recorded.empty()) {
+            std::cerr << "cannot read trace " << trace_path << " (expected 0/1 per iteration)" << std::endl;
+            return 1;
+        }
+    }
+
     // Handlers for benchmark run.
     g_recoverable_hits.store(0, std::memory_order_relaxed);
     g_panic_triggered.store(false, std::memory_order_relaxed);
     Dodo::set_fallback_handler(recording_fallback_handler);
     Dodo::set_panic_handler(stress_panic_handler);
 
-    std::vector<BenchResult> results;
+    // Pin before calibrating so the timer overhead is measured on the benchmark core.
+    info.cpu = bench::pin_to_core(cpu) ? cpu : -1;
+    bench::Runner runner(ITERATIONS, WARMUP_ITERATIONS);
+    info.timer_overhead = runner.overhead();
+    info.iterations = runner.iterations();
+
+    std::vector<bench::Report> results;
 
     // EXECUTION
 
     // Scenario 1: HFT Nested Hot Path (Success)
     MockMarketData md_good = {150.25, 1000, "NYSE"};
-    results.push_back(run_bench("HFT Hot Path (Success)", [&]() -> Dodo::Status {
+    results.push_back(runner.run("HFT Hot Path (Success)", [&]() -> Dodo::Status {
         return scenario_nested_logic(md_good);
     }));
 
     // Scenario 2: Embedded DMA Alignment (Success)
     alignas(64) uint64_t align_buffer[64];
     MockDMA dma_good = { (void*)align_buffer, 512, 64 };
-    results.push_back(run_bench("Embedded DMA (Aligned)", [&]() -> Dodo::Status {
+    results.push_back(runner.run("Embedded DMA (Aligned)", [&]() -> Dodo::Status {
         return scenario_dma_check(dma_good);
     }));
 
     // Scenario 3: Safety Range Check (Success)
     int sensor = 500;
-    results.push_back(run_bench("Safety Range (In-Bounds)", [&]() -> Dodo::Status {
+    results.push_back(runner.run("Safety Range (In-Bounds)", [&]() -> Dodo::Status {
         return scenario_safety_limits(&sensor);
     }));
 
     // Scenario 4: Local Fallback (Success path)
-    results.push_back(run_bench("Local Fallback (No-op)", [&]() -> Dodo::Status {
+    results.push_back(runner.run("Local Fallback (No-op)", [&]() -> Dodo::Status {
         return scenario_local_fallback(false);
     }));
 
-    // Scenario 5: The "Cost of Failure" (Cold Path)
-    results.push_back(run_bench("COLD PATH (Failure)", [&]() -> Dodo::Status {
+    // Scenario 5/6: Value chain, Status + out-param vs Result<uint32_t>
+    results.push_back(runner.run("Value Chain (Status+out)", [&]() -> Dodo::Status {
+        uint32_t out = 0;
+        const Dodo::Status s = scenario_status_chain(md_good, &out);
+        g_value_sink = out;
+        return s;
+    }));
+    results.push_back(runner.run("Value Chain (Result<T>)", [&]() -> Dodo::Status {
+        const Dodo::Result<uint32_t> r = scenario_result_chain(md_good);
+        g_value_sink = r.value;
+        return r.status();
+    }));
+
+    // Scenario 7/8: 10-level book validation, scalar check_range loop vs batched SIMD
+    int32_t book[kBookFields];
+    for (size_t i = 0; i < kBookFields; ++i) book[i] = static_cast<int32_t>(1000 + i);
+    results.push_back(runner.run("Book 40x check_range", [&]() -> Dodo::Status {
+        return scenario_book_scalar(book);
+    }));
+    results.push_back(runner.run("Book check_range_all (" DODO_SIMD_ISA ")", [&]() -> Dodo::Status {
+        return scenario_book_batched(book);
+    }));
+
+    // Scenario 8b: as 8 plus an is_sorted audit invariant (stripped unless DODO_CONTRACT_AUDIT)
+    results.push_back(runner.run("Book batched + audit inv", [&]() -> Dodo::Status {
+        return scenario_book_audited(book);
+    }));
+
+    // Scenario 9/10: 12-field message decode, early-exit chain vs Validator
+    const MockOrder order{"ESZ6", 450'025, 10, 1, 0, 2, 77, 5, 0x3u, 9, 1, 5};
+    results.push_back(runner.run("Decode 12x DODO_TRY", [&]() -> Dodo::Status {
+        return scenario_decode_chain(order);
+    }));
+    results.push_back(runner.run("Decode 12x Validator", [&]() -> Dodo::Status {
+        return scenario_decode_validator(order);
+    }));
+
+    // Scenario 11: The "Cost of Failure" (Cold Path)
+    results.push_back(runner.run("COLD PATH (Failure)", [&]() -> Dodo::Status {
         return scenario_safety_limits(nullptr); // Triggers NullPointer
     }));
 
-    // REPORTING
+    // Scenario 12: Cold path through a plain (non-atomic, no override) hook load
+    g_plain_fallback = recording_fallback_handler;
+    results.push_back(runner.run("COLD PATH (plain hook)", [&]() -> Dodo::Status {
+        return scenario_policy_null<PlainHookPolicy>(nullptr);
+    }));
+
+    // Scenario 13/14: Cold path through compile-time policies (direct call)
+    results.push_back(runner.run("COLD PATH (Policy direct)", [&]() -> Dodo::Status {
+        return scenario_policy_null<StaticPolicy>(nullptr);
+    }));
+    results.push_back(runner.run("COLD PATH (Policy trivial)", [&]() -> Dodo::Status {
+        return scenario_policy_null<TrivialPolicy>(nullptr);
+    }));
+
+    // Scenario 15: Cold path with the flight recorder chained in front
+    Dodo::install_flight_recorder();
+    results.push_back(runner.run("COLD PATH + FlightRecorder", [&]() -> Dodo::Status {
+        return scenario_safety_limits(nullptr);
+    }));
+    (void)Dodo::flight_recorder().consume([](const Dodo::FlightRecord&) noexcept {});
+    Dodo::set_fallback_handler(recording_fallback_handler);
+
+    // Scenario 15b: Cold path logging a range failure: binary record vs snprintf text
+    const int out_of_range = 5000;
+    Dodo::set_fallback_handler(encoding_fallback_handler);
+    results.push_back(runner.run("COLD PATH + encode_failure", [&]() -> Dodo::Status {
+        return scenario_safety_limits(&out_of_range);
+    }));
+    Dodo::set_fallback_handler(text_fallback_handler);
+    results.push_back(runner.run("COLD PATH + snprintf text", [&]() -> Dodo::Status {
+        return scenario_safety_limits(&out_of_range);
+    }));
+    Dodo::set_fallback_handler(recording_fallback_handler);
+
+    // Scenario 16: Cold path in a storm, fallback sampled down to 1 in 1024
+    Dodo::install_fallback_sampler();
+    Dodo::set_sample_rule(Dodo::Code::NullPointer, Dodo::SampleRule{0, 1024, 0});
+    results.push_back(runner.run("COLD PATH (sampled 1/1024)", [&]() -> Dodo::Status {
+        return scenario_safety_limits(nullptr);
+    }));
+    Dodo::set_sample_rule(Dodo::Code::NullPointer, Dodo::SampleRule{});
+    Dodo::set_fallback_handler(recording_fallback_handler);
+
+#if DODO_HAS_FORK
+    // Scenario 16b: Cold path queued to the async Reporter (drain thread running, null sink)
+    {
+        static Dodo::BasicReporter<NullSink, 1024, 8> reporter{NullSink{}};
+        (void)reporter.start();
+        Dodo::install_reporter(reporter);
+        results.push_back(runner.run("COLD PATH + Reporter push", [&]() -> Dodo::Status {
+            return scenario_safety_limits(nullptr);
+        }));
+        Dodo::uninstall_reporter();
+        reporter.stop();
+        Dodo::set_fallback_handler(recording_fallback_handler);
+    }
+#endif
+
+    // Scenario 17/18: Safety range guarded by a CircuitBreaker, closed vs tripped
+    Dodo::CircuitBreaker breaker{{.threshold = 1, .window_ticks = 0, .cooldown_ticks = UINT64_MAX}};
+    results.push_back(runner.run("Safety Range + Breaker", [&]() -> Dodo::Status {
+        DODO_TRY(breaker.allow());
+        return breaker.record(scenario_safety_limits(&sensor));
+    }));
+    (void)breaker.record(Dodo::Status::fail(Dodo::Code::ExternalFault));
+    results.push_back(runner.run("Breaker open (short-circuit)", [&]() -> Dodo::Status {
+        return breaker.call([&] { return scenario_safety_limits(&sensor); });
+    }));
+
+    // Scenario 19/20: Deadline check, invariant TSC vs steady_clock (vDSO)
+    Dodo::TscClock::calibrate();
+    const Dodo::Deadline deadline = Dodo::Deadline::after_ms(60'000);
+    results.push_back(runner.run("Deadline check (TSC)", [&]() -> Dodo::Status {
+        return DODO_CHECK_DEADLINE(deadline);
+    }));
+    const auto steady_deadline = Dodo::BasicDeadline<Dodo::SteadyClock>::after_ms(60'000);
+    results.push_back(runner.run("Deadline check (steady_clock)", [&]() -> Dodo::Status {
+        return DODO_CHECK_DEADLINE(steady_deadline);
+    }));
+
+    // Scenario 21/22/23: notional overflow check, division vs __builtin_mul_overflow, batch
+    results.push_back(runner.run("Notional (div check)", [&]() -> Dodo::Status {
+        const Dodo::Result<int64_t> r = scenario_notional_div(450'025, static_cast<int64_t>(md_good.volume));
+        g_value_sink = static_cast<uint32_t>(r.value);
+        return r.status();
+    }));
+    results.push_back(runner.run("Notional (DODO_CHECK_MUL)", [&]() -> Dodo::Status {
+        const Dodo::Result<int64_t> r = scenario_notional_checked(450'025, static_cast<int64_t>(md_good.volume));
+        g_value_sink = static_cast<uint32_t>(r.value);
+        return r.status();
+    }));
+    int32_t level_px[kNotionalLevels];
+    int32_t level_qty[kNotionalLevels];
+    int32_t level_notional[kNotionalLevels];
+    for (size_t i = 0; i < kNotionalLevels; ++i) {
+        level_px[i] = static_cast<int32_t>(10'000 + i);
+        level_qty[i] = static_cast<int32_t>(100 + i);
+    }
+    results.push_back(runner.run("Notional 16x CHECK_MUL_ALL", [&]() -> Dodo::Status {
+        return scenario_notional_all(level_px, level_qty, level_notional);
+    }));
+
+    // Failure replay: scenarios 3/9/10 fed a deterministic pass/fail stream, so the
+    // check branches mispredict and the cold path is refetched at realistic rates.
+    // Bursty: quiet at 0.01%, bursts of ~20 calls failing half the time, ~1% overall.
+    const bench::TraceSpec trace_specs[] = {
+        {"0%"}, {"0.01%", 0.0001}, {"1%", 0.01}, {"10%", 0.10}, {"bursty", 0.0001, 0.001, 0.05, 0.5},
+    };
+    std::vector<std::pair<std::string, bench::Trace>> traces;
+    for (const bench::TraceSpec& spec : trace_specs) {
+        traces.emplace_back(spec.name, bench::make_trace(runner.iterations() + WARMUP_ITERATIONS, spec,
+                                                         seed + traces.size()));
+    }
+    if (!recorded.empty()) traces.emplace_back("recorded", std::move(recorded));
+
+    const int sensor_bad = 2'000;
+    const int* const sensor_in[2] = {&sensor, &sensor_bad};
+    MockOrder order_bad = order;
+    order_bad.venue = 0; // 8th check
+    const MockOrder* const order_in[2] = {&order, &order_bad};
+    std::vector<bench::Report> replays;
+    const auto replay_all = [&](const char* scenario, auto&& fn) {
+        for (const auto& [name, trace] : traces) {
+            replays.push_back(runner.replay((std::string(scenario) + " @ " + name).c_str(), trace, fn));
+        }
+    };
+    replay_all("Safety Range", [&](bool fail) { return scenario_safety_limits(sensor_in[fail]); });
+    replay_all("Decode 12x DODO_TRY", [&](bool fail) { return scenario_decode_chain(*order_in[fail]); });
+    replay_all("Decode 12x Validator", [&](bool fail) { return scenario_decode_validator(*order_in[fail]); });
+
+    // REPORTING (cycles per iteration, timer overhead subtracted)
+    std::cout << "\nBenchmark: " << runner.iterations() << " samples/scenario, timer overhead "
+              << runner.overhead() << " cycles, cpu " << info.cpu << ", isa " << info.isa << std::endl;
     std::cout << std::left
               << std::setw(30) << "Scenario"
-              << std::setw(15) << "Avg Cycles"
-              << std::setw(12) << "OK"
-              << std::setw(12) << "FAIL"
-              << "Sink"
+              << std::setw(9) << "Mean"
+              << std::setw(7) << "p50"
+              << std::setw(7) << "p99"
+              << std::setw(8) << "p99.9"
+              << std::setw(9) << "Max"
+              << std::setw(9) << "OK"
+              << std::setw(9) << "FAIL"
+              << std::setw(9) << "BrMiss"
+              << "L1iMiss"
               << std::endl;
 
-    std::cout << std::string(75, '-') << std::endl;
+    std::cout << std::string(105, '-') << std::endl;
 
+    const auto per_iter = [](const bench::Report& r, size_t k) {
+        std::ostringstream os;
+        if (r.pmu.value[k] < 0) os << "n/a";
+        else os << std::fixed << std::setprecision(3)
+                << static_cast<double>(r.pmu.value[k]) / static_cast<double>(r.cycles.n);
+        return os.str();
+    };
     for (const auto& res : results) {
         std::cout << std::left << std::setw(30) << res.label
-                  << std::setw(15) << std::fixed << std::setprecision(2) << res.avg
-                  << std::setw(12) << res.ok_count
-                  << std::setw(12) << res.fail_count
-                  << res.sink
+                  << std::setw(9) << std::fixed << std::setprecision(2) << res.cycles.mean
+                  << std::setw(7) << res.cycles.p50
+                  << std::setw(7) << res.cycles.p99
+                  << std::setw(8) << res.cycles.p999
+                  << std::setw(9) << res.cycles.max
+                  << std::setw(9) << res.ok_count
+                  << std::setw(9) << res.fail_count
+                  << std::setw(9) << per_iter(res, bench::BranchMisses)
+                  << per_iter(res, bench::L1iMisses)
                   << std::endl;
     }
 
+    // Same columns, plus the mean relative to the scenario's 0% stream.
+    std::cout << "\nFailure replay (seed " << seed << "), cycles per call:" << std::endl;
+    std::cout << std::left
+              << std::setw(38) << "Scenario @ stream"
+              << std::setw(9) << "Mean"
+              << std::setw(7) << "p50"
+              << std::setw(7) << "p99"
+              << std::setw(8) << "p99.9"
+              << std::setw(9) << "FAIL"
+              << std::setw(8) << "x 0%"
+              << std::setw(9) << "BrMiss"
+              << "L1iMiss"
+              << std::endl;
+    std::cout << std::string(105, '-') << std::endl;
+    uint64_t replay_mismatches = 0;
+    for (size_t i = 0; i < replays.size(); ++i) {
+        const bench::Report& res = replays[i];
+        const double base = replays[i - i % traces.size()].cycles.mean;
+        std::cout << std::left << std::setw(38) << res.label
+                  << std::setw(9) << std::fixed << std::setprecision(2) << res.cycles.mean
+                  << std::setw(7) << res.cycles.p50
+                  << std::setw(7) << res.cycles.p99
+                  << std::setw(8) << res.cycles.p999
+                  << std::setw(9) << res.fail_count
+                  << std::setw(8) << std::setprecision(2) << (base > 0.0 ? res.cycles.mean / base : 0.0)
+                  << std::setw(9) << per_iter(res, bench::BranchMisses)
+                  << per_iter(res, bench::L1iMisses)
+                  << std::endl;
+        replay_mismatches += res.mismatches;
+    }
+    if (replay_mismatches != 0) {
+        std::cerr << "failure replay: " << replay_mismatches << " call(s) disagreed with their stream" << std::endl;
+    }
+
+    if (show_hist) {
+        std::cout << std::endl;
+        for (const auto& res : results) bench::print_histogram(std::cout, res);
+        for (const auto& res : replays) bench::print_histogram(std::cout, res);
+    }
+    results.insert(results.end(), replays.begin(), replays.end()); // JSON / CSV / baseline
+
+    // Threaded failure counting: one shared atomic vs Dodo::Stats rows (wall clock, all cores)
+    std::cout << "\nThreaded failures (" << kThreadedFailures << " per run, " << std::thread::hardware_concurrency()
+              << " hw threads), Mfail/s:" << std::endl;
+    std::cout << std::left << std::setw(10) << "Threads" << std::setw(16) << "shared atomic" << "Dodo::Stats" << std::endl;
+    for (const int threads : {1, 4, 16, 32, 64}) {
+        const int iters = kThreadedFailures / threads;
+        const double n = double(threads) * double(iters) * 1e-6;
+        Dodo::set_fallback_handler(counting_fallback_handler);
+        const double shared_s = run_failing_threads(threads, iters);
+        Dodo::set_fallback_handler(Dodo::stats_fallback);
+        const double stats_s = run_failing_threads(threads, iters);
+        std::cout << std::left << std::setw(10) << threads << std::setw(16) << std::fixed << std::setprecision(1)
+                  << n / shared_s << n / stats_s << std::endl;
+    }
+    Dodo::set_fallback_handler(recording_fallback_handler);
+
+    // Startup-style batch validation: serial loop vs parallel_validate (wall clock)
+    {
+        const std::vector<MockOrder> orders(kParallelOrders, order);
+        const auto wall = [](auto&& body) {
+            const auto t0 = std::chrono::steady_clock::now();
+            body();
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        };
+        size_t serial_bad = 0;
+        const double serial_s = wall([&] {
+            for (const MockOrder& o : orders) serial_bad += !scenario_decode_validator(o).ok();
+        });
+        std::cout << "\nParallel validate (" << kParallelOrders << " orders, " << std::thread::hardware_concurrency()
+                  << " hw threads), Morders/s: serial " << std::fixed << std::setprecision(1)
+                  << double(kParallelOrders) * 1e-6 / serial_s << std::endl;
+        std::cout << std::left << std::setw(10) << "Workers" << "parallel_validate" << std::endl;
+        for (const size_t workers : {0u, 1u, 3u, 7u}) {
+            Dodo::ThreadPool pool{workers};
+            Dodo::ParallelResult r{};
+            const double s = wall([&] { r = Dodo::parallel_validate(orders, scenario_decode_validator, pool); });
+            if (r.failed != serial_bad) std::cerr << "parallel_validate disagrees with the serial loop" << std::endl;
+            std::cout << std::left << std::setw(10) << workers << std::fixed << std::setprecision(1)
+                      << double(kParallelOrders) * 1e-6 / s << std::endl;
+        }
+    }
+
+    int rc = replay_mismatches == 0 ? 0 : 1;
+    if (json_path != nullptr) write_report(json_path, bench::write_json, info, results, rc);
+    if (csv_path != nullptr) write_report(csv_path, bench::write_csv, info, results, rc);
+    if (site_profile_path != nullptr) write_site_profile(site_profile_path, rc);
+
+    if (baseline_path != nullptr) {
+        std::ifstream in(baseline_path);
+        if (!in) {
+            std::cerr << "cannot read baseline " << baseline_path << std::endl;
+            return 1;
+        }
+        std::cout << "\nBaseline " << baseline_path << " (threshold " << threshold_pct << "%, slack "
+                  << slack_cycles << " cycles):" << std::endl;
+        const size_t regressions = bench::compare_to_baseline(std::cout, results, bench::read_baseline_csv(in),
+                                                              threshold_pct, slack_cycles);
+        std::cout << "  " << regressions << " regression(s)" << std::endl;
+        if (regressions != 0) rc = 3;
+    }
+
     std::cout << "\nTotal Recoverable Errors Handled: "
               << g_recoverable_hits.load(std::memory_order_relaxed) << std::endl;
 
@@ -411,5 +2624,5 @@ int main() {
     std::cout << "\nSkipping fatal invariant demo (no fork support)." << std::endl;
 #endif
 
-    return 0;
+    return rc;
 }
@@ -0,0 +1,18 @@
+// Second translation unit linked into stresstest.cpp.
+// Checks compiled here must observe handlers installed from the other TU
+// (one hook table per process), and this TU owns the table storage in
+// DODO_EXTERN_HANDLER_TABLE builds.
+
+#include "Dodo.hpp"
+
+#ifdef DODO_EXTERN_HANDLER_TABLE
+DODO_DEFINE_HANDLER_TABLE(Dodo::default_panic, Dodo::default_fallback);
+#endif
+
+Dodo::Status other_tu_require(bool cond) noexcept {
+    return DODO_REQUIRE(cond, Dodo::Code::ExternalFault);
+}
+
+Dodo::FallbackFn other_tu_fallback_handler() noexcept {
+    return Dodo::get_fallback_handler();
+}
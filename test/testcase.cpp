@@ -3,6 +3,7 @@
 #include <iostream>
 #include <vector>
 #include "Dodo.hpp"
+#include "DodoFormat.hpp"
 
 struct DriverModule {
     const char* name;
@@ -41,16 +42,31 @@ Dodo::Status validate_and_load_driver(const DriverModule* driver) noexcept {
 }
 
 void my_panic_handler(const Dodo::Failure& f) noexcept {
-    std::printf("\n[FATAL] System Halted at %s:%u\n", f.file, f.line);
-    std::printf("Failed Condition: %s\n", f.expr);
+    const Dodo::Site* s = f.site;
+    std::printf("\n[FATAL] System Halted at %s:%u\n", s ? s->file : "?", s ? s->line : 0u);
+    std::printf("Failed Condition: %s\n", s ? s->expr : "?");
     std::abort();
 }
 
+// Rejections are logged as binary records (no formatting on the failure path)
+// and turned into text later, off the load path.
+static unsigned char g_reject_log[1024];
+static size_t g_reject_used = 0;
+
 Dodo::Status my_fallback_handler(const Dodo::Failure& f) noexcept {
-    std::printf("[LOG] Load Rejected: %s (Code: %u)\n", f.expr, (uint32_t)f.code);
+    g_reject_used += Dodo::encode_failure(f, g_reject_log + g_reject_used, sizeof(g_reject_log) - g_reject_used);
     return Dodo::Status::fail(f.code);
 }
 
+void print_reject_log() {
+    Dodo::DecodedFailure d;
+    char line[256];
+    for (size_t at = 0, n; at < g_reject_used && (n = Dodo::decode_failure(g_reject_log + at, g_reject_used - at, d)) != 0; at += n) {
+        Dodo::format_failure(d, line, sizeof(line), Dodo::kSameProcess); // this process wrote the log
+        std::printf("[LOG] Load Rejected: %s\n", line);
+    }
+}
+
 int main() {
     Dodo::set_panic_handler(my_panic_handler); // set panic button (dodo) with panic button of user
     Dodo::set_fallback_handler(my_fallback_handler);
@@ -63,6 +79,7 @@ int main() {
     if (!s.ok()) {
         std::cout << "Outcome: Driver rejected. Kernel remains stable." << std::endl;
     }
+    print_reject_log();
 
     return 0;
 }
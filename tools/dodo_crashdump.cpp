@@ -0,0 +1,181 @@
+// dodo_crashdump: prints the crash record a process left in its shared region.
+//
+// The application maps a file (typically under /dev/shm) and passes the mapping
+// to Dodo::install_crash_record(); when a fatal check fires, crash_record_panic
+// stores the failure and the thread's recent flight-recorder history there
+// before the trap. A watchdog runs this tool (or reads the same layout itself)
+// after the process dies. No core dump needed.
+//
+// Build:  g++ -std=c++20 -O2 -I.. dodo_crashdump.cpp -o dodo_crashdump
+// Create: ./dodo_crashdump --create /dev/shm/app.crash 16   (region for 16 entries)
+// Read:   ./dodo_crashdump /dev/shm/app.crash
+//
+// Exit status: 0 complete record, 1 empty (no crash), 3 partial (the process
+// died while writing; the entries shown are intact), 2 bad file or layout.
+// Site addresses are only meaningful in the crashed binary; compact builds
+// store the site ID, which tools/dodo_sitemap resolves.
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+#include "DodoFormat.hpp"
+
+namespace {
+    const char *severity_name(uint8_t sev) {
+        switch (static_cast<Dodo::Severity>(sev)) {
+            case Dodo::Severity::Recoverable: return "recoverable";
+            case Dodo::Severity::Fatal: return "fatal";
+        }
+        return "?";
+    }
+
+    // Copy of a fixed-size text field that is NUL-terminated even if the
+    // writer died mid-copy.
+    template<size_t N>
+    void text_of(const char (&field)[N], char (&out)[N]) {
+        std::memcpy(out, field, N);
+        out[N - 1] = '\0';
+    }
+
+    void print_entry(size_t i, const Dodo::CrashEntry &e, const Dodo::CrashHeader &h) {
+        char expr[sizeof(e.expr)];
+        char file[sizeof(e.file)];
+        char func[sizeof(e.func)];
+        text_of(e.expr, expr);
+        text_of(e.file, file);
+        text_of(e.func, func);
+
+        // Relative to the panic, in microseconds (history entries are negative).
+        const int64_t dt = static_cast<int64_t>(e.tsc - h.crash_tsc);
+        const double us = static_cast<double>(dt) * 4294967296.0 / static_cast<double>(h.tsc_per_ns_q32) / 1000.0;
+
+        const Dodo::Code code = static_cast<Dodo::Code>(e.code);
+        std::printf("#%-3zu %+14.3f us  %-11s %s (0x%04x)  thread %" PRIu32 "\n", i, us, severity_name(e.sev),
+                    Dodo::code_name(code), e.code, e.thread);
+        if (file[0] != '\0') {
+            std::printf("      %s:%" PRIu32 " %s: %s\n", file, e.line, func, expr);
+        } else {
+            std::printf("      site 0x%" PRIx64 "\n", e.site);
+        }
+
+        Dodo::FailurePayload p{};
+        p.kind = static_cast<Dodo::PayloadKind>(e.kind);
+        p.count = e.count;
+        for (size_t k = 0; k < Dodo::kMaxOperands; ++k) {
+            p.types[k] = static_cast<Dodo::OperandType>(e.types[k] & 0x3u);
+            p.operands[k] = e.operands[k];
+        }
+        if (p.kind == Dodo::PayloadKind::None || e.kind > static_cast<uint8_t>(Dodo::PayloadKind::Values)) {
+            return;
+        }
+        char text[256];
+#ifdef DODO_COMPACT_MODE
+        const Dodo::Failure f{code, static_cast<Dodo::Severity>(e.sev), 0};
+#else
+        const Dodo::Site site{expr[0] != '\0' ? expr : nullptr, file, e.line, func};
+        const Dodo::Failure f{code, static_cast<Dodo::Severity>(e.sev), &site};
+#endif
+        Dodo::describe_failure(f, p, text, sizeof(text));
+        std::printf("      %s", text);
+        if (e.context != 0) {
+            std::printf("  (context 0x%" PRIx64 ")", e.context);
+        }
+        std::printf("\n");
+    }
+
+    int create(const char *path, const char *entries) {
+        const long n = entries != nullptr ? std::strtol(entries, nullptr, 10) : 16;
+        if (n < 1 || n > UINT16_MAX) {
+            std::fprintf(stderr, "dodo_crashdump: entry count must be 1..65535\n");
+            return 2;
+        }
+        std::FILE *f = std::fopen(path, "wb");
+        if (f == nullptr) {
+            std::fprintf(stderr, "dodo_crashdump: cannot create %s\n", path);
+            return 2;
+        }
+        const std::vector<unsigned char> zeros(Dodo::crash_record_bytes(static_cast<size_t>(n)));
+        const bool ok = std::fwrite(zeros.data(), 1, zeros.size(), f) == zeros.size();
+        return std::fclose(f) == 0 && ok ? 0 : 2;
+    }
+
+    int dump(const char *path) {
+        std::FILE *f = std::fopen(path, "rb");
+        if (f == nullptr) {
+            std::fprintf(stderr, "dodo_crashdump: cannot open %s\n", path);
+            return 2;
+        }
+        std::vector<unsigned char> raw;
+        unsigned char buf[1 << 16];
+        size_t got;
+        while ((got = std::fread(buf, 1, sizeof(buf), f)) != 0) {
+            raw.insert(raw.end(), buf, buf + got);
+        }
+        const bool read_ok = std::ferror(f) == 0;
+        std::fclose(f);
+        if (!read_ok || raw.size() < sizeof(Dodo::CrashHeader)) {
+            std::fprintf(stderr, "dodo_crashdump: %s is too short for a crash record\n", path);
+            return 2;
+        }
+
+        // The vector's storage is suitably aligned for the header.
+        Dodo::CrashHeader &h = *reinterpret_cast<Dodo::CrashHeader *>(raw.data());
+        if (h.magic == 0 && h.state.load(std::memory_order_relaxed) == 0) {
+            std::printf("%s: no crash record (region never armed)\n", path);
+            return 1;
+        }
+        if (h.magic != Dodo::kCrashMagic || h.version != Dodo::kCrashVersion ||
+            h.header_bytes != sizeof(Dodo::CrashHeader) || h.entry_bytes != sizeof(Dodo::CrashEntry) ||
+            raw.size() < Dodo::crash_record_bytes(h.capacity)) {
+            std::fprintf(stderr, "dodo_crashdump: %s: unknown layout (magic %08" PRIx32 ", version %u)\n", path, h.magic,
+                         static_cast<unsigned>(h.version));
+            return 2;
+        }
+
+        const uint32_t state = h.state.load(std::memory_order_acquire);
+        if (state == static_cast<uint32_t>(Dodo::CrashState::Empty)) {
+            std::printf("%s: armed, no crash (tag %" PRIu64 ")\n", path, h.tag);
+            return 1;
+        }
+        const uint32_t count = h.count.load(std::memory_order_acquire);
+        const size_t shown = count < h.capacity ? count : h.capacity;
+        const bool complete = state == static_cast<uint32_t>(Dodo::CrashState::Complete);
+
+        // Wall time of the panic from the (tsc, wall) pair sampled at install.
+        const double since_install_ns = static_cast<double>(h.crash_tsc - h.install_tsc) * 4294967296.0 /
+                                        static_cast<double>(h.tsc_per_ns_q32 != 0 ? h.tsc_per_ns_q32 : 1);
+        const uint64_t wall_ns = h.install_wall_ns + static_cast<uint64_t>(since_install_ns);
+        const std::time_t secs = static_cast<std::time_t>(wall_ns / 1'000'000'000u);
+        char when[32] = "?";
+        if (const std::tm *tm = std::gmtime(&secs)) {
+            std::strftime(when, sizeof(when), "%Y-%m-%d %H:%M:%S", tm);
+        }
+        std::printf("%s: %s crash record, tag %" PRIu64 ", thread %" PRIu32 ", %zu entr%s, %" PRIu32
+                    " later fatal\n", path, complete ? "complete" : "PARTIAL", h.tag, h.thread, shown,
+                    shown == 1 ? "y" : "ies", h.later.load(std::memory_order_relaxed));
+        std::printf("crashed at %s.%09" PRIu64 " UTC (%.3f s after install)\n", when, wall_ns % 1'000'000'000u,
+                    since_install_ns / 1e9);
+
+        const Dodo::CrashEntry *e = Dodo::crash_entries(h);
+        for (size_t i = 0; i < shown; ++i) {
+            print_entry(i, e[i], h);
+        }
+        return complete ? 0 : 3;
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc >= 3 && std::strcmp(argv[1], "--create") == 0) {
+        return create(argv[2], argc >= 4 ? argv[3] : nullptr);
+    }
+    if (argc != 2 || argv[1][0] == '-') {
+        std::fprintf(stderr, "usage: %s FILE\n       %s --create FILE [ENTRIES]\n", argv[0], argv[0]);
+        return 2;
+    }
+    return dump(argv[1]);
+}
@@ -0,0 +1,151 @@
+// dodo_profgen: turns exported per-site counters into a DODO_SITE_PROFILE_HEADER.
+//
+// A build with -DDODO_SITE_PROFILE counts evaluations as well as failures per
+// check site; Dodo::format_site_profile() (DodoFormat.hpp) writes them out as
+// text. This tool sums one or more such dumps (several processes, hosts or runs)
+// and emits a DODO_SITE_EXPECT list for the sites whose measured pass rate is
+// low enough that the default "always passes" hint and the cold endpoint
+// misplace them.
+//
+// Build:   g++ -std=c++20 -O2 -I.. dodo_profgen.cpp -o dodo_profgen
+// Collect: app built with -DDODO_SITE_PROFILE writes format_site_profile() to a file
+// Header:  ./dodo_profgen [--max-pass 0.99] [--min-evals 1000] run1.prof run2.prof > app_profile.h
+// Use:     g++ -DDODO_SITE_PROFILE_HEADER='"app_profile.h"' ...   (same directory as the profiled build)
+//
+// Input format: one site per line, "<file>\t<line>\t<evals>\t<fails>".
+// Sites with fewer than --min-evals evaluations (including every site of a
+// build without DODO_SITE_PROFILE, where evals is 0) or a pass rate at or above
+// --max-pass are left out. Exit status 2 on unreadable input or bad options.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace {
+    struct Counts {
+        uint64_t evals = 0;
+        uint64_t fails = 0;
+    };
+
+    using Profile = std::map<std::pair<std::string, uint32_t>, Counts>;
+
+    // Parses "<file>\t<line>\t<evals>\t<fails>"; false on a malformed line.
+    bool parse_line(const char *s, Profile &out) {
+        const char *tab = std::strchr(s, '\t');
+        if (tab == nullptr || tab == s) {
+            return false;
+        }
+        const std::string file(s, static_cast<size_t>(tab - s));
+        char *end = nullptr;
+        const unsigned long line = std::strtoul(tab + 1, &end, 10);
+        if (*end != '\t') {
+            return false;
+        }
+        const unsigned long long evals = std::strtoull(end + 1, &end, 10);
+        if (*end != '\t') {
+            return false;
+        }
+        const unsigned long long fails = std::strtoull(end + 1, &end, 10);
+        if (*end != '\0' && *end != '\n' && *end != '\r') {
+            return false;
+        }
+        Counts &c = out[{file, static_cast<uint32_t>(line)}];
+        c.evals += evals;
+        c.fails += fails;
+        return true;
+    }
+
+    bool read_profile(std::FILE *f, const char *name, Profile &out) {
+        char buf[4096];
+        unsigned lineno = 0;
+        while (std::fgets(buf, sizeof(buf), f) != nullptr) {
+            ++lineno;
+            if (buf[0] == '\n' || buf[0] == '#') {
+                continue;
+            }
+            if (!parse_line(buf, out)) {
+                std::fprintf(stderr, "dodo_profgen: %s:%u: expected file<TAB>line<TAB>evals<TAB>fails\n", name,
+                             lineno);
+                return false;
+            }
+        }
+        return std::ferror(f) == 0;
+    }
+
+    // The file as a C string literal, matching __FILE__ after escaping.
+    std::string literal(const std::string &s) {
+        std::string out = "\"";
+        for (const char c : s) {
+            if (c == '"' || c == '\\') {
+                out += '\\';
+            }
+            out += c;
+        }
+        return out + '"';
+    }
+}
+
+int main(int argc, char **argv) {
+    double max_pass = 0.99;
+    uint64_t min_evals = 1000;
+    Profile profile;
+    bool any_file = false;
+
+    for (int a = 1; a < argc; ++a) {
+        if (std::strcmp(argv[a], "--max-pass") == 0 && a + 1 < argc) {
+            max_pass = std::strtod(argv[++a], nullptr);
+            if (!(max_pass > 0.0 && max_pass <= 1.0)) {
+                std::fprintf(stderr, "dodo_profgen: --max-pass must be in (0, 1]\n");
+                return 2;
+            }
+        } else if (std::strcmp(argv[a], "--min-evals") == 0 && a + 1 < argc) {
+            min_evals = std::strtoull(argv[++a], nullptr, 10);
+        } else if (argv[a][0] == '-' && argv[a][1] != '\0') {
+            std::fprintf(stderr, "usage: %s [--max-pass P] [--min-evals N] [PROFILE...]\n", argv[0]);
+            return 2;
+        } else {
+            any_file = true;
+            std::FILE *f = std::strcmp(argv[a], "-") == 0 ? stdin : std::fopen(argv[a], "r");
+            if (f == nullptr) {
+                std::fprintf(stderr, "dodo_profgen: cannot open %s\n", argv[a]);
+                return 2;
+            }
+            const bool ok = read_profile(f, argv[a], profile);
+            if (f != stdin) {
+                std::fclose(f);
+            }
+            if (!ok) {
+                return 2;
+            }
+        }
+    }
+    if (!any_file && !read_profile(stdin, "<stdin>", profile)) {
+        return 2;
+    }
+
+    std::printf("// Generated by dodo_profgen (max-pass %.4f, min-evals %llu). Do not edit.\n", max_pass,
+                static_cast<unsigned long long>(min_evals));
+    std::printf("// DODO_SITE_EXPECT(file, line, pass rate): include via -DDODO_SITE_PROFILE_HEADER.\n");
+    unsigned kept = 0, skipped = 0;
+    for (const auto &[key, c] : profile) {
+        if (c.evals < min_evals) {
+            ++skipped;
+            continue;
+        }
+        // Relaxed counters may drop increments, so fails can exceed evals by a few.
+        const uint64_t fails = c.fails < c.evals ? c.fails : c.evals;
+        const double pass = 1.0 - static_cast<double>(fails) / static_cast<double>(c.evals);
+        if (pass >= max_pass) {
+            continue;
+        }
+        std::printf("DODO_SITE_EXPECT(%s, %u, %.4f) // %llu / %llu failed\n", literal(key.first).c_str(), key.second,
+                    pass, static_cast<unsigned long long>(fails), static_cast<unsigned long long>(c.evals));
+        ++kept;
+    }
+    std::fprintf(stderr, "dodo_profgen: %u site(s) profiled, %u below --min-evals\n", kept, skipped);
+    return 0;
+}
@@ -0,0 +1,224 @@
+// dodo_sitemap: offline symbolization for DODO_COMPACT_MODE site IDs.
+//
+// A compact build carries only a 32-bit hash of "file:line:expr" per check.
+// This tool rebuilds the ID -> site table from preprocessed sources (the
+// preprocessor expands every check macro into a Dodo::internal::site_key(...)
+// call with the literal key), and looks IDs up in a stored map.
+//
+// Build:  g++ -std=c++20 -O2 -I.. dodo_sitemap.cpp -o dodo_sitemap
+// Map:    g++ -E -DDODO_COMPACT_MODE <same flags as the build> app.cpp | ./dodo_sitemap > app.dodomap
+//         ./dodo_sitemap a.ii b.ii > app.dodomap      (several TUs at once)
+// Lookup: ./dodo_sitemap --lookup app.dodomap 0x1c3a9f02 ...
+//
+// Map format: one site per line, "<id hex8>\t<file>:<line>\t<expr>", sorted by ID.
+// Exit status 1 on an ID collision (two different keys with the same hash).
+
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+
+#include "Dodo.hpp"
+
+namespace {
+    // Decodes one C string literal starting at s[i] == '"'; advances i past it.
+    bool read_literal(const std::string &s, size_t &i, std::string &out) {
+        ++i;
+        while (i < s.size() && s[i] != '"') {
+            char c = s[i++];
+            if (c == '\\' && i < s.size()) {
+                c = s[i++];
+                switch (c) {
+                    case 'n': c = '\n'; break;
+                    case 't': c = '\t'; break;
+                    case 'r': c = '\r'; break;
+                    case 'a': c = '\a'; break;
+                    case 'b': c = '\b'; break;
+                    case 'f': c = '\f'; break;
+                    case 'v': c = '\v'; break;
+                    case 'x': {
+                        unsigned v = 0;
+                        while (i < s.size() && std::isxdigit(static_cast<unsigned char>(s[i]))) {
+                            const char h = s[i++];
+                            v = v * 16u + static_cast<unsigned>(h <= '9' ? h - '0' : (h | 0x20) - 'a' + 10);
+                        }
+                        c = static_cast<char>(v);
+                        break;
+                    }
+                    default:
+                        if (c >= '0' && c <= '7') {
+                            unsigned v = static_cast<unsigned>(c - '0');
+                            for (int k = 0; k < 2 && i < s.size() && s[i] >= '0' && s[i] <= '7'; ++k) {
+                                v = v * 8u + static_cast<unsigned>(s[i++] - '0');
+                            }
+                            c = static_cast<char>(v);
+                        }
+                        break; // \" \\ \' \? map to themselves
+                }
+            }
+            out += c;
+        }
+        if (i >= s.size()) {
+            return false;
+        }
+        ++i;
+        return true;
+    }
+
+    // Parses `site_key ( "lit" "lit" ... )` at the position just past "site_key".
+    bool read_key(const std::string &s, size_t i, std::string &key) {
+        const auto skip_ws = [&] {
+            while (i < s.size() && std::isspace(static_cast<unsigned char>(s[i]))) {
+                ++i;
+            }
+        };
+        skip_ws();
+        if (i >= s.size() || s[i] != '(') {
+            return false;
+        }
+        ++i;
+        bool any = false;
+        for (;;) {
+            skip_ws();
+            if (i >= s.size()) {
+                return false;
+            }
+            if (s[i] == ')') {
+                return any;
+            }
+            if (s[i] != '"' || !read_literal(s, i, key)) {
+                return false; // not a literal key (e.g. the declaration in Dodo.hpp)
+            }
+            any = true;
+        }
+    }
+
+    // Keeps a map line on one line; backslashes stay as written in the source.
+    std::string escape(const std::string &s) {
+        std::string out;
+        for (const char c : s) {
+            if (c == '\n') out += "\\n";
+            else if (c == '\t') out += "\\t";
+            else out += c;
+        }
+        return out;
+    }
+
+    // "file:line:expr" -> "file:line\texpr". The file part ends at the first ":<digits>:".
+    std::string format_key(const std::string &key) {
+        for (size_t p = key.find(':'); p != std::string::npos; p = key.find(':', p + 1)) {
+            size_t q = p + 1;
+            while (q < key.size() && key[q] >= '0' && key[q] <= '9') {
+                ++q;
+            }
+            if (q > p + 1 && q < key.size() && key[q] == ':') {
+                return escape(key.substr(0, q)) + '\t' + escape(key.substr(q + 1));
+            }
+        }
+        return escape(key) + "\t?";
+    }
+
+    bool slurp(std::FILE *f, std::string &out) {
+        char buf[1 << 16];
+        size_t n;
+        while ((n = std::fread(buf, 1, sizeof(buf), f)) != 0) {
+            out.append(buf, n);
+        }
+        return std::ferror(f) == 0;
+    }
+
+    int lookup(const char *map_path, int argc, char **argv, int first) {
+        std::FILE *f = std::fopen(map_path, "r");
+        if (f == nullptr) {
+            std::fprintf(stderr, "dodo_sitemap: cannot open %s\n", map_path);
+            return 2;
+        }
+        std::string text;
+        const bool ok = slurp(f, text);
+        std::fclose(f);
+        if (!ok) {
+            return 2;
+        }
+        int missing = 0;
+        for (int a = first; a < argc; ++a) {
+            const uint32_t id = static_cast<uint32_t>(std::strtoul(argv[a], nullptr, 16));
+            char prefix[10];
+            std::snprintf(prefix, sizeof(prefix), "%08x\t", id);
+            size_t pos = 0;
+            bool found = false;
+            while ((pos = text.find(prefix, pos)) != std::string::npos) {
+                if (pos == 0 || text[pos - 1] == '\n') {
+                    const size_t end = text.find('\n', pos);
+                    std::printf("%s\n", text.substr(pos, end - pos).c_str());
+                    found = true;
+                }
+                pos += 9;
+            }
+            if (!found) {
+                std::printf("%08x\t<unknown>\n", id);
+                ++missing;
+            }
+        }
+        return missing != 0 ? 1 : 0;
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc >= 2 && std::strcmp(argv[1], "--lookup") == 0) {
+        if (argc < 4) {
+            std::fprintf(stderr, "usage: %s --lookup MAP ID...\n", argv[0]);
+            return 2;
+        }
+        return lookup(argv[2], argc, argv, 3);
+    }
+
+    std::map<uint32_t, std::string> sites;
+    int collisions = 0;
+    const auto scan = [&](const std::string &src) {
+        static constexpr char kToken[] = "site_key";
+        for (size_t p = src.find(kToken); p != std::string::npos; p = src.find(kToken, p + 1)) {
+            std::string key;
+            if (!read_key(src, p + sizeof(kToken) - 1, key)) {
+                continue;
+            }
+            const uint32_t id = Dodo::internal::site_id_of(key.data(), key.size());
+            const std::string line = format_key(key);
+            const auto [it, inserted] = sites.emplace(id, line);
+            if (!inserted && it->second != line) {
+                std::fprintf(stderr, "dodo_sitemap: ID collision %08x: '%s' vs '%s'\n", id, it->second.c_str(),
+                             line.c_str());
+                ++collisions;
+            }
+        }
+    };
+
+    if (argc == 1) {
+        std::string src;
+        if (!slurp(stdin, src)) {
+            return 2;
+        }
+        scan(src);
+    }
+    for (int a = 1; a < argc; ++a) {
+        std::FILE *f = std::fopen(argv[a], "r");
+        if (f == nullptr) {
+            std::fprintf(stderr, "dodo_sitemap: cannot open %s\n", argv[a]);
+            return 2;
+        }
+        std::string src;
+        const bool ok = slurp(f, src);
+        std::fclose(f);
+        if (!ok) {
+            return 2;
+        }
+        scan(src);
+    }
+
+    for (const auto &[id, line] : sites) {
+        std::printf("%08x\t%s\n", id, line.c_str());
+    }
+    return collisions != 0 ? 1 : 0;
+}